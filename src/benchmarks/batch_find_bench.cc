@@ -0,0 +1,83 @@
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../s21_map.h"
+#include "../s21_set.h"
+#include "bench.h"
+
+// Compares lookups of batches of random keys one find at a time with
+// find_batch and contains_batch, which interleave the searches of a batch.
+// The default tree of 16M elements is much bigger than the last level cache,
+// so nearly every level below the top of the tree is a cache miss.
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 1 << 24);
+  std::size_t lookups = 1 << 21;
+  std::vector<long long> items(n);
+  std::iota(items.begin(), items.end(), 0);
+  s21::set<long long> set(s21::sorted_unique, items.begin(), items.end());
+  items.clear();
+  items.shrink_to_fit();
+  // every other key is missing
+  std::mt19937_64 gen(42);
+  std::vector<long long> keys(lookups);
+  for (auto& key : keys) key = static_cast<long long>(gen() % (2 * n));
+  std::size_t total = 0;
+
+  s21_bench::report("set find", s21_bench::measure([&] {
+                      for (long long key : keys)
+                        total += set.find(key) != set.end();
+                    }),
+                    lookups);
+  for (std::size_t batch : {16, 64, 256}) {
+    std::vector<s21::set<long long>::iterator> found(batch);
+    std::vector<char> contained(batch);
+    std::string suffix = " of " + std::to_string(batch);
+    s21_bench::report("set find_batch" + suffix, s21_bench::measure([&] {
+                        for (std::size_t i = 0; i < lookups; i += batch) {
+                          set.find_batch(keys.begin() + i,
+                                         keys.begin() + i + batch,
+                                         found.begin());
+                          for (auto it : found) total += it != set.end();
+                        }
+                      }),
+                      lookups);
+    s21_bench::report("set contains_batch" + suffix, s21_bench::measure([&] {
+                        for (std::size_t i = 0; i < lookups; i += batch) {
+                          set.contains_batch(keys.begin() + i,
+                                             keys.begin() + i + batch,
+                                             contained.begin());
+                          for (char hit : contained) total += hit;
+                        }
+                      }),
+                      lookups);
+  }
+  set.clear();
+
+  // a smaller map of long values, built by random inserts so that its
+  // nodes are scattered
+  s21::map<long long, long long> map;
+  for (std::size_t i = 0; i < n / 4; i++) {
+    long long key = static_cast<long long>(gen() % n);
+    map.insert(key, key);
+  }
+  s21_bench::report("map find", s21_bench::measure([&] {
+                      for (long long key : keys)
+                        total += map.find(key) != map.end();
+                    }),
+                    lookups);
+  std::vector<s21::map<long long, long long>::iterator> found(64);
+  s21_bench::report("map find_batch of 64", s21_bench::measure([&] {
+                      for (std::size_t i = 0; i < lookups; i += 64) {
+                        map.find_batch(keys.begin() + i, keys.begin() + i + 64,
+                                       found.begin());
+                        for (auto it : found) total += it != map.end();
+                      }
+                    }),
+                    lookups);
+  s21_bench::do_not_optimize(total);
+  return 0;
+}
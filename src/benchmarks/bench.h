@@ -0,0 +1,55 @@
+#ifndef SRC_BENCHMARKS_BENCH_H_
+#define SRC_BENCHMARKS_BENCH_H_
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/*
+    Helpers shared by the benchmarks
+    Every benchmark is a standalone program: it takes the number of elements
+   as an optional first argument and prints one line per measurement.
+*/
+
+namespace s21_bench {
+// keeps the optimizer from throwing away results of measured code
+template <typename T>
+inline void do_not_optimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// returns number of elements passed in argv or the default one
+inline std::size_t elements(int argc, char** argv, std::size_t def) {
+  return argc > 1 ? std::strtoull(argv[1], nullptr, 10) : def;
+}
+
+// runs func once and returns elapsed time in milliseconds
+template <typename Func>
+double measure(Func&& func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+// returns resident set size of the process in kilobytes (0 if unknown)
+inline std::size_t rss_kb() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line))
+    if (line.compare(0, 6, "VmRSS:") == 0)
+      return std::strtoull(line.c_str() + 6, nullptr, 10);
+  return 0;
+}
+
+// prints one measurement: total time and time per operation
+inline void report(const std::string& name, double ms, std::size_t ops) {
+  std::cout << name << ": " << ms << " ms";
+  if (ops) std::cout << ", " << ms * 1e6 / ops << " ns/op";
+  std::cout << std::endl;
+}
+}  // namespace s21_bench
+
+#endif  // SRC_BENCHMARKS_BENCH_H_
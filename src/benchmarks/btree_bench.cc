@@ -0,0 +1,69 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "bench.h"
+
+// Runs the same random inserts, lookups, in-order walk and erases on the
+// red-black tree containers and on their B-tree counterparts, for 1K keys
+// up to the given number (1M by default, pass 100000000 for the full run).
+
+namespace {
+// returns the key of a set element or of a map pair
+long long key_of(long long key) { return key; }
+long long key_of(const std::pair<const long long, long long>& item) {
+  return item.first;
+}
+
+// inserts keys into an empty container with insert_one, then measures
+// lookups, a walk over all the elements and erasing the first half
+template <typename Container, typename Insert>
+void run(const std::string& name, const std::vector<long long>& keys,
+         Insert insert_one) {
+  std::string size = " (n = " + std::to_string(keys.size()) + ")";
+  std::size_t n = keys.size(), total = 0;
+  Container container;
+  std::size_t rss = s21_bench::rss_kb();
+  s21_bench::report(name + " insert" + size, s21_bench::measure([&] {
+                      for (long long key : keys) insert_one(container, key);
+                    }),
+                    n);
+  std::size_t grown = s21_bench::rss_kb() - rss;
+  s21_bench::report(name + " find" + size, s21_bench::measure([&] {
+                      for (long long key : keys)
+                        total += container.find(key) != container.end();
+                    }),
+                    n);
+  s21_bench::report(name + " iterate" + size, s21_bench::measure([&] {
+                      for (const auto& item : container) total += key_of(item);
+                    }),
+                    n);
+  s21_bench::report(name + " erase" + size, s21_bench::measure([&] {
+                      for (std::size_t i = 0; i < n / 2; i++)
+                        container.erase(container.find(keys[i]));
+                    }),
+                    n / 2);
+  if (n >= 1000000)
+    std::cout << name << " memory" << size << ": " << grown * 1024.0 / n
+              << " bytes/element" << std::endl;
+  s21_bench::do_not_optimize(total);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 1000000);
+  std::mt19937_64 gen(42);
+  auto insert_key = [](auto& set, long long key) { set.insert(key); };
+  auto insert_pair = [](auto& map, long long key) { map.insert(key, key); };
+  for (std::size_t size = 1000; size <= n; size *= 10) {
+    std::vector<long long> keys(size);
+    for (auto& key : keys) key = static_cast<long long>(gen());
+    run<s21::set<long long>>("set", keys, insert_key);
+    run<s21::btree_set<long long>>("btree_set", keys, insert_key);
+    run<s21::map<long long, long long>>("map", keys, insert_pair);
+    run<s21::btree_map<long long, long long>>("btree_map", keys, insert_pair);
+  }
+  return 0;
+}
@@ -0,0 +1,51 @@
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../s21_set.h"
+#include "bench.h"
+
+// Builds a set from sorted keys by inserting them one by one, by bulk
+// loading, and from shuffled keys through the sorting range constructor.
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 5000000);
+  std::vector<long long> keys(n);
+  for (std::size_t i = 0; i < n; i++) keys[i] = static_cast<long long>(i) * 3;
+  std::vector<long long> shuffled = keys;
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937_64(42));
+
+  std::size_t total = 0;
+  s21_bench::report("s21::set insert (sorted)", s21_bench::measure([&] {
+                      s21::set<long long> set;
+                      for (long long key : keys) set.insert(key);
+                      total += set.size();
+                    }),
+                    n);
+  s21_bench::report("s21::set sorted_unique", s21_bench::measure([&] {
+                      s21::set<long long> set(s21::sorted_unique, keys.begin(),
+                                              keys.end());
+                      total += set.size();
+                    }),
+                    n);
+  s21_bench::report("s21::set range (shuffled)", s21_bench::measure([&] {
+                      s21::set<long long> set(shuffled.begin(),
+                                              shuffled.end());
+                      total += set.size();
+                    }),
+                    n);
+  s21_bench::report("std::set range (sorted)", s21_bench::measure([&] {
+                      std::set<long long> set(keys.begin(), keys.end());
+                      total += set.size();
+                    }),
+                    n);
+  s21_bench::report("std::set range (shuffled)", s21_bench::measure([&] {
+                      std::set<long long> set(shuffled.begin(),
+                                              shuffled.end());
+                      total += set.size();
+                    }),
+                    n);
+  s21_bench::do_not_optimize(total);
+  return 0;
+}
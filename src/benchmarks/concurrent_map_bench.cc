@@ -0,0 +1,103 @@
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_concurrent_map.h"
+#include "../s21_map.h"
+#include "bench.h"
+
+// Compares an s21::map behind one global mutex with s21::concurrent_map
+// under a mix of lookups and updates, sweeping the share of reads and the
+// number of threads. The total number of operations is split between the
+// threads, so on enough cores the time should fall as threads are added.
+// Then lookups one by one are compared with find_batch.
+
+namespace {
+const std::size_t kThreadCounts[] = {1, 2, 4, 8, 16, 32};
+const unsigned kReadPercents[] = {50, 90, 99};
+
+// the baseline: every operation takes the same lock
+class locked_map {
+ public:
+  bool contains(long long key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return map_.contains(key);
+  }
+  void insert_or_assign(long long key, long long value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    map_.insert_or_assign(key, value);
+  }
+
+ private:
+  std::mutex mutex_;
+  s21::map<long long, long long> map_;
+};
+
+// runs ops operations split between threads, read_percent of them lookups
+template <typename Map>
+double run(Map& map, std::size_t ops, std::size_t threads,
+           unsigned read_percent, long long range) {
+  return s21_bench::measure([&] {
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; t++) {
+      workers.emplace_back([&map, ops, threads, read_percent, range, t] {
+        std::mt19937_64 gen(t);
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < ops / threads; i++) {
+          long long key = static_cast<long long>(gen() % range);
+          if (gen() % 100 < read_percent)
+            found += map.contains(key);
+          else
+            map.insert_or_assign(key, key);
+        }
+        s21_bench::do_not_optimize(found);
+      });
+    }
+    for (auto& worker : workers) worker.join();
+  });
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 400000);
+  long long range = static_cast<long long>(n);
+  locked_map locked;
+  s21::concurrent_map<long long, long long> concurrent;
+  for (long long key = 0; key < range; key += 2) {
+    locked.insert_or_assign(key, key);
+    concurrent.insert_or_assign(key, key);
+  }
+
+  for (unsigned read_percent : kReadPercents) {
+    for (std::size_t threads : kThreadCounts) {
+      std::string config = std::to_string(read_percent) + "% reads, " +
+                           std::to_string(threads) + " threads";
+      s21_bench::report("global mutex map, " + config,
+                        run(locked, n, threads, read_percent, range), n);
+      s21_bench::report("concurrent_map, " + config,
+                        run(concurrent, n, threads, read_percent, range), n);
+    }
+  }
+
+  std::mt19937_64 gen(42);
+  std::vector<long long> keys(n);
+  for (auto& key : keys) key = static_cast<long long>(gen() % range);
+  std::size_t total = 0;
+  s21_bench::report("concurrent_map get", s21_bench::measure([&] {
+                      for (long long key : keys)
+                        total += concurrent.get(key).has_value();
+                    }),
+                    n);
+  std::vector<std::optional<long long>> values(n);
+  s21_bench::report("concurrent_map find_batch", s21_bench::measure([&] {
+                      concurrent.find_batch(keys.begin(), keys.end(),
+                                            values.begin());
+                    }),
+                    n);
+  for (const auto& value : values) total += value.has_value();
+  s21_bench::do_not_optimize(total);
+  return 0;
+}
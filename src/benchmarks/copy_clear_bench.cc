@@ -0,0 +1,53 @@
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../s21_set.h"
+#include "bench.h"
+
+// Copy and clear throughput of big trees: s21::set copies without
+// recursion into one pool block and clears chunk by chunk, std::set copies
+// recursively and frees every node.
+
+namespace {
+template <typename Set>
+void run(const char* name, const std::vector<long long>& keys) {
+  std::size_t n = keys.size();
+  Set set;
+  for (long long key : keys) set.insert(key);
+  std::size_t total = 0;
+  std::string prefix = name;
+  Set copy;
+  s21_bench::report(prefix + " copy", s21_bench::measure([&] {
+                      Set tmp(set);
+                      copy.swap(tmp);
+                    }),
+                    n);
+  total += copy.size();
+  s21_bench::report(prefix + " clear", s21_bench::measure([&] {
+                      copy.clear();
+                    }),
+                    n);
+  s21_bench::report(prefix + " copy assignment", s21_bench::measure([&] {
+                      copy = set;
+                    }),
+                    n);
+  total += copy.size();
+  s21_bench::report(prefix + " destructor", s21_bench::measure([&] {
+                      Set tmp;
+                      tmp.swap(copy);
+                    }),
+                    n);
+  s21_bench::do_not_optimize(total);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 10000000);
+  std::mt19937_64 gen(42);
+  std::vector<long long> keys(n);
+  for (auto& key : keys) key = static_cast<long long>(gen());
+  run<s21::set<long long>>("s21::set", keys);
+  run<std::set<long long>>("std::set", keys);
+  return 0;
+}
@@ -0,0 +1,66 @@
+#include <initializer_list>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../s21_map.h"
+#include "../s21_set.h"
+#include "bench.h"
+
+// Compares the old emplace of s21::set, which copied its arguments into an
+// initializer_list and then into a node and returned a vector, with the
+// in-place emplace, and try_emplace of s21::map with emplace for keys which
+// are mostly there already. The keys are strings too long for SSO.
+
+namespace {
+// the old emplace: one copy into the list, one into the node
+template <typename Set, typename... Args>
+std::vector<std::pair<typename Set::iterator, bool>> old_emplace(
+    Set& set, Args&&... args) {
+  std::vector<std::pair<typename Set::iterator, bool>> results;
+  results.reserve(sizeof...(args));
+  for (auto element : {std::forward<Args>(args)...})
+    results.push_back(set.insert(element));
+  return results;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 1000000);
+  std::mt19937_64 gen(42);
+  std::vector<std::string> keys(n);
+  for (auto& key : keys)
+    key = "a fairly long key for no SSO " + std::to_string(gen());
+  std::size_t total = 0;
+
+  s21::set<std::string> old_set, new_set;
+  s21_bench::report("set old emplace", s21_bench::measure([&] {
+                      for (const auto& key : keys)
+                        total += old_emplace(old_set, key).size();
+                    }),
+                    n);
+  s21_bench::report("set emplace", s21_bench::measure([&] {
+                      for (const auto& key : keys)
+                        total += new_set.emplace(key).second;
+                    }),
+                    n);
+
+  // every key is looked up four times, three of them find it
+  s21::map<std::string, std::string> emplaced, tried;
+  std::string value(64, 'v');
+  s21_bench::report("map emplace", s21_bench::measure([&] {
+                      for (int pass = 0; pass < 4; pass++)
+                        for (const auto& key : keys)
+                          total += emplaced.emplace(key, value).second;
+                    }),
+                    4 * n);
+  s21_bench::report("map try_emplace", s21_bench::measure([&] {
+                      for (int pass = 0; pass < 4; pass++)
+                        for (const auto& key : keys)
+                          total += tried.try_emplace(key, value).second;
+                    }),
+                    4 * n);
+  s21_bench::do_not_optimize(total);
+  return 0;
+}
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "bench.h"
+
+// Runs the same random lookups and in-order walk on s21::set, btree_set and
+// frozen_set of the same int keys, for 1K keys up to the given number (4M by
+// default). A sorted vector searched by std::lower_bound is the baseline.
+
+namespace {
+// measures random lookups of keys, half of them missing, and a full walk
+template <typename Set>
+void run(const std::string& name, const Set& set,
+         const std::vector<int>& lookups) {
+  std::string size = " (n = " + std::to_string(set.size()) + ")";
+  std::size_t total = 0;
+  s21_bench::report(name + " contains" + size, s21_bench::measure([&] {
+                      for (int key : lookups) total += set.contains(key);
+                    }),
+                    lookups.size());
+  s21_bench::report(name + " lower_bound" + size, s21_bench::measure([&] {
+                      for (int key : lookups)
+                        total += set.lower_bound(key) != set.end();
+                    }),
+                    lookups.size());
+  s21_bench::report(name + " walk" + size, s21_bench::measure([&] {
+                      for (int key : set) total += key;
+                    }),
+                    set.size());
+  s21_bench::do_not_optimize(total);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t max = s21_bench::elements(argc, argv, 4096000);
+  std::mt19937 gen(42);
+  for (std::size_t n = 1000; n <= max; n *= 16) {
+    std::vector<int> items(n);
+    for (std::size_t i = 0; i < n; i++) items[i] = static_cast<int>(2 * i);
+    std::vector<int> lookups(std::max<std::size_t>(n, 1 << 20));
+    for (int& key : lookups) key = static_cast<int>(gen() % (2 * n));
+    {
+      // built by random inserts, as sets filled at startup usually are
+      std::vector<int> shuffled = items;
+      std::shuffle(shuffled.begin(), shuffled.end(), gen);
+      s21::set<int> set(shuffled.begin(), shuffled.end());
+      run("set", set, lookups);
+      s21::frozen_set<int> frozen(set);
+      run("frozen_set", frozen, lookups);
+    }
+    {
+      s21::btree_set<int> btree(items.begin(), items.end());
+      run("btree_set", btree, lookups);
+    }
+    std::size_t total = 0;
+    s21_bench::report("sorted vector lower_bound (n = " + std::to_string(n) +
+                          ")",
+                      s21_bench::measure([&] {
+                        for (int key : lookups)
+                          total += std::lower_bound(items.begin(),
+                                                    items.end(),
+                                                    key) != items.end();
+                      }),
+                      lookups.size());
+    s21_bench::do_not_optimize(total);
+  }
+  return 0;
+}
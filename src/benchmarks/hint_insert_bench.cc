@@ -0,0 +1,69 @@
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../s21_set.h"
+#include "bench.h"
+
+// Inserts ascending timestamps with and without a hint, and nearly sorted
+// ones (small random jitter) with the hint of the previous insertion.
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 2000000);
+  std::vector<long long> ascending(n), jittered(n);
+  std::mt19937_64 gen(42);
+  for (std::size_t i = 0; i < n; i++) {
+    ascending[i] = static_cast<long long>(i) * 10;
+    jittered[i] = ascending[i] + static_cast<long long>(gen() % 25);
+  }
+
+  std::size_t total = 0;
+  s21_bench::report("s21::set insert (ascending)", s21_bench::measure([&] {
+                      s21::set<long long> set;
+                      for (long long key : ascending) set.insert(key);
+                      total += set.size();
+                    }),
+                    n);
+  s21_bench::report("s21::set insert end() (ascending)",
+                    s21_bench::measure([&] {
+                      s21::set<long long> set;
+                      for (long long key : ascending)
+                        set.insert(set.end(), key);
+                      total += set.size();
+                    }),
+                    n);
+  s21_bench::report("std::set insert end() (ascending)",
+                    s21_bench::measure([&] {
+                      std::set<long long> set;
+                      for (long long key : ascending)
+                        set.insert(set.end(), key);
+                      total += set.size();
+                    }),
+                    n);
+  s21_bench::report("s21::set insert (jittered)", s21_bench::measure([&] {
+                      s21::set<long long> set;
+                      for (long long key : jittered) set.insert(key);
+                      total += set.size();
+                    }),
+                    n);
+  s21_bench::report("s21::set insert last hint (jittered)",
+                    s21_bench::measure([&] {
+                      s21::set<long long> set;
+                      auto hint = set.end();
+                      for (long long key : jittered)
+                        hint = set.insert(hint, key);
+                      total += set.size();
+                    }),
+                    n);
+  s21_bench::report("std::set insert last hint (jittered)",
+                    s21_bench::measure([&] {
+                      std::set<long long> set;
+                      auto hint = set.end();
+                      for (long long key : jittered)
+                        hint = set.insert(hint, key);
+                      total += set.size();
+                    }),
+                    n);
+  s21_bench::do_not_optimize(total);
+  return 0;
+}
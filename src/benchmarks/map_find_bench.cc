@@ -0,0 +1,59 @@
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../s21_map.h"
+#include "bench.h"
+
+// Compares key lookups in s21::map (tree descent) with the linear in-order
+// scan map used before RBTree could search by key.
+
+namespace {
+// the old map_find: walks the tree from begin() comparing keys
+template <typename Map, typename Key>
+typename Map::iterator scan_find(Map& map, const Key& key) {
+  for (auto it = map.begin(); it != map.end(); ++it)
+    if ((*it).first == key) return it;
+  return map.end();
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 1000000);
+  std::mt19937_64 gen(42);
+  // keys stay below INT_MAX, so key + 1 in the contains loop cannot overflow
+  std::uniform_int_distribution<int> dist(std::numeric_limits<int>::min(),
+                                          std::numeric_limits<int>::max() - 1);
+  std::vector<int> keys(n);
+  for (auto& key : keys) key = dist(gen);
+
+  s21::map<int, int> map;
+  s21_bench::report("insert", s21_bench::measure([&] {
+                      for (std::size_t i = 0; i < n; i++)
+                        map.insert(keys[i], static_cast<int>(i));
+                    }),
+                    n);
+
+  std::size_t hits = 0;
+  s21_bench::report("at (tree descent)", s21_bench::measure([&] {
+                      for (std::size_t i = 0; i < n; i++)
+                        hits += map.at(keys[i]) >= 0;
+                    }),
+                    n);
+  s21_bench::report("contains (tree descent)", s21_bench::measure([&] {
+                      for (std::size_t i = 0; i < n; i++)
+                        hits += map.contains(keys[i] + 1);
+                    }),
+                    n);
+
+  // the scan is O(n) per lookup, so only a handful of keys is measured
+  std::size_t scans = 20;
+  s21_bench::report("find (linear scan)", s21_bench::measure([&] {
+                      for (std::size_t i = 0; i < scans; i++)
+                        hits += scan_find(map, keys[i * (n / scans)]) !=
+                                map.end();
+                    }),
+                    scans);
+  s21_bench::do_not_optimize(hits);
+  return 0;
+}
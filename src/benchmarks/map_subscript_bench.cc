@@ -0,0 +1,73 @@
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../s21_map.h"
+#include "bench.h"
+
+// Compares the old operator[] and insert_or_assign of s21::map, which
+// searched twice on a miss and went through a temporary value_type, with
+// the ones built on try_emplace. The mapped values are vectors of samples.
+
+namespace {
+using samples = std::vector<double>;
+using sample_map = s21::map<long long, samples>;
+
+// the old operator[]: find, then insert a pair with a default value
+samples& old_subscript(sample_map& map, long long key) {
+  auto it = map.find(key);
+  if (it == map.end())
+    return (*map.insert(std::pair<const long long, samples>{key, samples{}})
+                 .first)
+        .second;
+  return (*it).second;
+}
+
+// the old insert_or_assign: the value is copied in both cases
+void old_insert_or_assign(sample_map& map, long long key, const samples& obj) {
+  auto it = map.find(key);
+  if (it == map.end())
+    map.insert(std::pair<const long long, samples>{key, obj});
+  else
+    (*it).second = obj;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 1000000);
+  std::mt19937_64 gen(42);
+  std::vector<long long> keys(n);
+  for (auto& key : keys) key = static_cast<long long>(gen() % (n / 2 + 1));
+  std::size_t total = 0;
+
+  sample_map old_map, new_map;
+  s21_bench::report("old operator[]", s21_bench::measure([&] {
+                      for (long long key : keys)
+                        total += old_subscript(old_map, key).size();
+                    }),
+                    n);
+  s21_bench::report("operator[]", s21_bench::measure([&] {
+                      for (long long key : keys) total += new_map[key].size();
+                    }),
+                    n);
+
+  // a fresh batch of samples is handed over for every key
+  sample_map old_assigned, new_assigned;
+  s21_bench::report("old insert_or_assign", s21_bench::measure([&] {
+                      for (long long key : keys) {
+                        samples batch(16, 1.0);
+                        old_insert_or_assign(old_assigned, key, batch);
+                      }
+                    }),
+                    n);
+  s21_bench::report("insert_or_assign", s21_bench::measure([&] {
+                      for (long long key : keys) {
+                        samples batch(16, 1.0);
+                        new_assigned.insert_or_assign(key, std::move(batch));
+                      }
+                    }),
+                    n);
+  total += old_assigned.size() + new_assigned.size();
+  s21_bench::do_not_optimize(total);
+  return 0;
+}
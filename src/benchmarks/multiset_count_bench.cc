@@ -0,0 +1,55 @@
+#include <random>
+#include <vector>
+
+#include "../s21_multiset.h"
+#include "bench.h"
+
+// Compares multiset::count (equal range walk) with the linear scan over the
+// whole tree count used before, on a multiset with many duplicate keys.
+
+namespace {
+// the old RBTree::count: compares every element with the key
+template <typename Set, typename Key>
+std::size_t scan_count(const Set& set, const Key& key) {
+  std::size_t c = 0;
+  for (auto it = set.begin(); it != set.end(); ++it)
+    if (*it == key) c++;
+  return c;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 1000000);
+  std::size_t distinct = 1000;
+  std::mt19937_64 gen(42);
+  std::vector<int> keys(n);
+  for (auto& key : keys) key = static_cast<int>(gen() % distinct);
+
+  s21::multiset<int> set;
+  s21_bench::report("insert", s21_bench::measure([&] {
+                      for (std::size_t i = 0; i < n; i++) set.insert(keys[i]);
+                    }),
+                    n);
+
+  std::size_t total = 0;
+  s21_bench::report("count (equal range)", s21_bench::measure([&] {
+                      for (std::size_t k = 0; k < distinct; k++)
+                        total += set.count(static_cast<int>(k));
+                    }),
+                    distinct);
+  s21_bench::report("count of absent keys", s21_bench::measure([&] {
+                      for (std::size_t i = 0; i < n; i++)
+                        total += set.count(-static_cast<int>(i) - 1);
+                    }),
+                    n);
+
+  // the scan is O(n) per query, so only a handful of keys is measured
+  std::size_t scans = 20;
+  s21_bench::report("count (linear scan)", s21_bench::measure([&] {
+                      for (std::size_t k = 0; k < scans; k++)
+                        total += scan_count(set, static_cast<int>(k));
+                    }),
+                    scans);
+  s21_bench::do_not_optimize(total);
+  return 0;
+}
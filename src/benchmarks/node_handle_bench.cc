@@ -0,0 +1,59 @@
+#include <string>
+#include <vector>
+
+#include "../s21_map.h"
+#include "bench.h"
+
+// Moves every entry of one map to another: by copying and erasing, through
+// node handles, and through node handles between maps sharing a pool.
+
+namespace {
+using window = s21::map<long long, std::string>;
+
+// fills a map with n entries carrying heap allocated strings
+void fill(window& map, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++)
+    map.insert(static_cast<long long>(i), std::string(40, 'x'));
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 1000000);
+  std::size_t total = 0;
+  {
+    window from, to;
+    fill(from, n);
+    s21_bench::report("copy + erase", s21_bench::measure([&] {
+                        while (!from.empty()) {
+                          to.insert(*from.begin());
+                          from.erase(from.begin());
+                        }
+                      }),
+                      n);
+    total += to.size();
+  }
+  {
+    window from, to;
+    fill(from, n);
+    s21_bench::report("extract + insert", s21_bench::measure([&] {
+                        while (!from.empty())
+                          to.insert(from.extract(from.begin()));
+                      }),
+                      n);
+    total += to.size();
+  }
+  {
+    window from, to;
+    to.share_pool(from);
+    fill(from, n);
+    s21_bench::report("extract + insert (shared pool)",
+                      s21_bench::measure([&] {
+                        while (!from.empty())
+                          to.insert(from.extract(from.begin()));
+                      }),
+                      n);
+    total += to.size();
+  }
+  s21_bench::do_not_optimize(total);
+  return 0;
+}
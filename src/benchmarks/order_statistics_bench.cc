@@ -0,0 +1,54 @@
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../s21_multiset.h"
+#include "bench.h"
+
+// Extracts p50 and p99 from a multiset of latencies: s21::multiset::nth
+// descends by subtree sizes, std::multiset has to walk iterators linearly.
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 10000000);
+  std::mt19937_64 gen(42);
+  std::vector<int> latencies(n);
+  for (auto& latency : latencies) latency = static_cast<int>(gen() % 100000);
+
+  s21::multiset<int> s21_set;
+  std::multiset<int> std_set;
+  s21_bench::report("s21::multiset insert", s21_bench::measure([&] {
+                      for (int latency : latencies) s21_set.insert(latency);
+                    }),
+                    n);
+  s21_bench::report("std::multiset insert", s21_bench::measure([&] {
+                      for (int latency : latencies) std_set.insert(latency);
+                    }),
+                    n);
+
+  long long sum = 0;
+  std::size_t queries = 1000;
+  s21_bench::report("s21::multiset nth (p50 + p99)", s21_bench::measure([&] {
+                      for (std::size_t i = 0; i < queries; i++) {
+                        sum += *s21_set.nth(n / 2);
+                        sum += *s21_set.nth(n / 100 * 99);
+                      }
+                    }),
+                    2 * queries);
+  s21_bench::report("s21::multiset rank", s21_bench::measure([&] {
+                      for (std::size_t i = 0; i < queries; i++)
+                        sum += static_cast<long long>(
+                            s21_set.rank(latencies[i]));
+                    }),
+                    queries);
+
+  // walking is O(n) per query, so it is measured once
+  s21_bench::report("std::multiset advance (p50 + p99)",
+                    s21_bench::measure([&] {
+                      sum += *std::next(std_set.begin(), n / 2);
+                      sum += *std::next(std_set.begin(), n / 100 * 99);
+                    }),
+                    2);
+  s21_bench::do_not_optimize(sum);
+  return 0;
+}
@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_map.h"
+#include "../s21_set.h"
+#include "bench.h"
+
+// Bulk builds a set from unsorted keys, unions two sets of the same size and
+// sums the values of a map with for_each on 1, 2, 4, ... threads up to the
+// number of hardware threads, and prints the speedup over one thread.
+// Pass 100000000 as the number of elements for the full size run.
+
+namespace {
+// prints one measurement together with the speedup over one thread
+void report(const std::string& name, std::size_t threads, double ms,
+            double single_ms, std::size_t ops) {
+  char speedup[32];
+  std::snprintf(speedup, sizeof(speedup), "x%.2f", single_ms / ms);
+  s21_bench::report(
+      name + " (" + std::to_string(threads) + " threads, " + speedup + ")",
+      ms, ops);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 10000000);
+  std::size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::mt19937_64 gen(42);
+  std::vector<long long> first(n), second(n);
+  for (long long& key : first) key = gen() % (4 * n);
+  for (long long& key : second) key = gen() % (4 * n);
+  std::vector<std::pair<long long, long long>> items(n);
+  for (std::size_t i = 0; i < n; i++) items[i] = {first[i], 1};
+  double build_single = 0, union_single = 0, for_each_single = 0;
+  std::size_t total = 0;
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    s21::parallel_policy policy = s21::parallel(threads);
+    s21::set<long long> a, b;
+    double ms = s21_bench::measure([&] {
+      a.assign(policy, first.begin(), first.end());
+      b.assign(policy, second.begin(), second.end());
+    });
+    if (threads == 1) build_single = ms;
+    report("bulk build", threads, ms, build_single, 2 * n);
+    ms = s21_bench::measure([&] { a.set_union(policy, std::move(b)); });
+    if (threads == 1) union_single = ms;
+    report("set_union", threads, ms, union_single, 2 * n);
+    total += a.size();
+    a.clear();
+    s21::map<long long, long long> map(policy, items.begin(), items.end());
+    std::atomic<long long> sum(0);
+    ms = s21_bench::measure([&] {
+      map.for_each(policy, [&sum](const std::pair<const long long,
+                                                  long long>& item) {
+        sum.fetch_add(item.second, std::memory_order_relaxed);
+      });
+    });
+    if (threads == 1) for_each_single = ms;
+    report("for_each", threads, ms, for_each_single, map.size());
+    total += sum;
+  }
+  s21_bench::do_not_optimize(total);
+  return 0;
+}
@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../s21_map.h"
+#include "../s21_persistent_map.h"
+#include "bench.h"
+
+// Compares taking a snapshot of s21::map, which is a deep copy, with a
+// snapshot of s21::persistent_map, and the cost of updates and lookups in
+// both. The persistent updates are measured with a snapshot held, so every
+// one of them copies its path.
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 1000000);
+  std::mt19937_64 gen(42);
+  std::vector<long long> keys(n);
+  for (auto& key : keys) key = static_cast<long long>(gen() % (n * 2));
+  const std::size_t kSnapshots = 10;
+  std::size_t total = 0;
+
+  s21::map<long long, long long> map;
+  s21::persistent_map<long long, long long> persistent;
+  s21_bench::report("map insert_or_assign", s21_bench::measure([&] {
+                      for (long long key : keys) map.insert_or_assign(key, 1);
+                    }),
+                    n);
+  s21_bench::report("persistent insert_or_assign", s21_bench::measure([&] {
+                      for (long long key : keys)
+                        persistent.insert_or_assign(key, 1);
+                    }),
+                    n);
+
+  s21_bench::report("map copy", s21_bench::measure([&] {
+                      for (std::size_t i = 0; i < kSnapshots; i++) {
+                        s21::map<long long, long long> copy(map);
+                        total += copy.size();
+                      }
+                    }),
+                    kSnapshots);
+  s21_bench::report("persistent snapshot", s21_bench::measure([&] {
+                      for (std::size_t i = 0; i < kSnapshots; i++) {
+                        auto snapshot = persistent.snapshot();
+                        total += snapshot.size();
+                      }
+                    }),
+                    kSnapshots);
+
+  s21::persistent_map<long long, long long> held = persistent.snapshot();
+  s21_bench::report("persistent update, snapshot held",
+                    s21_bench::measure([&] {
+                      for (long long key : keys)
+                        persistent.insert_or_assign(key, 2);
+                    }),
+                    n);
+  std::shuffle(keys.begin(), keys.end(), gen);
+  s21_bench::report("map contains", s21_bench::measure([&] {
+                      for (long long key : keys) total += map.contains(key);
+                    }),
+                    n);
+  s21_bench::report("persistent contains", s21_bench::measure([&] {
+                      for (long long key : keys)
+                        total += persistent.contains(key);
+                    }),
+                    n);
+  total += held.size();
+  s21_bench::do_not_optimize(total);
+  return 0;
+}
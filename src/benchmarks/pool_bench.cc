@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../s21_set.h"
+#include "bench.h"
+
+// Insert/erase throughput and memory of s21::set, whose nodes come from the
+// tree's NodePool, against std::set, which allocates every node on the heap
+// (the way RBTree did before the pool).
+
+namespace {
+template <typename Set>
+void run(const std::string& name, const std::vector<int>& keys) {
+  std::size_t n = keys.size();
+  std::size_t rss_before = s21_bench::rss_kb();
+  {
+    Set set;
+    s21_bench::report(name + " insert", s21_bench::measure([&] {
+                        for (int key : keys) set.insert(key);
+                      }),
+                      n);
+    std::cout << name << " rss: " << s21_bench::rss_kb() - rss_before
+              << " kB for " << set.size() << " elements" << std::endl;
+    s21_bench::report(name + " erase half", s21_bench::measure([&] {
+                        for (std::size_t i = 0; i < n; i += 2)
+                          set.erase(set.find(keys[i]));
+                      }),
+                      n / 2);
+    s21_bench::report(name + " reinsert", s21_bench::measure([&] {
+                        for (std::size_t i = 0; i < n; i += 2)
+                          set.insert(keys[i]);
+                      }),
+                      n / 2);
+    s21_bench::report(name + " clear", s21_bench::measure([&] {
+                        set.clear();
+                      }),
+                      n);
+  }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 1000000);
+  std::vector<int> keys(n);
+  for (std::size_t i = 0; i < n; i++) keys[i] = static_cast<int>(i);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  run<s21::set<int>>("s21::set (pool)", keys);
+  run<std::set<int>>("std::set (heap)", keys);
+  return 0;
+}
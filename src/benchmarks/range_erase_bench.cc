@@ -0,0 +1,72 @@
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "../s21_map.h"
+#include "bench.h"
+
+// TTL sweeps: keys are timestamps and every sweep drops the expired ones,
+// a contiguous range at the front, from s21::map. Erasing the range node by
+// node is compared with range erase, which splits it out of the tree, and
+// with erase_if over the whole map.
+
+namespace {
+using ttl_map = s21::map<long long, long long>;
+
+ttl_map make_map(const std::vector<long long>& keys) {
+  std::vector<std::pair<long long, long long>> items;
+  items.reserve(keys.size());
+  for (long long key : keys) items.push_back({key, key});
+  return ttl_map(s21::sorted_unique, items.begin(), items.end());
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 1000000);
+  std::vector<long long> keys(n);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::size_t total = 0;
+
+  // sweeps of several lengths, each starting from a fresh map
+  for (std::size_t expired : {std::size_t(8), std::size_t(32),
+                              std::size_t(1000), n / 10, n / 2}) {
+    std::string suffix = " " + std::to_string(expired) + " of " +
+                         std::to_string(n);
+    std::size_t sweeps = expired < 1000 ? 1000 : 1;
+    ttl_map by_node = make_map(keys), by_range = make_map(keys);
+    s21_bench::report("node by node" + suffix, s21_bench::measure([&] {
+                        for (std::size_t i = 0; i < sweeps; i++) {
+                          auto last = by_node.upper_bound(
+                              static_cast<long long>((i + 1) * expired));
+                          for (auto it = by_node.begin(); it != last;) {
+                            auto next = it;
+                            ++next;
+                            by_node.erase(it);
+                            it = next;
+                          }
+                        }
+                      }),
+                      sweeps);
+    s21_bench::report("erase range" + suffix, s21_bench::measure([&] {
+                        for (std::size_t i = 0; i < sweeps; i++)
+                          by_range.erase(by_range.begin(),
+                                         by_range.upper_bound(
+                                             static_cast<long long>(
+                                                 (i + 1) * expired)));
+                      }),
+                      sweeps);
+    total += by_node.size() + by_range.size();
+  }
+
+  ttl_map pruned = make_map(keys);
+  s21_bench::report("erase_if every other", s21_bench::measure([&] {
+                      total += s21::erase_if(
+                          pruned, [](const std::pair<const long long,
+                                                     long long>& item) {
+                            return item.first % 2 == 0;
+                          });
+                    }),
+                    n);
+  s21_bench::do_not_optimize(total);
+  return 0;
+}
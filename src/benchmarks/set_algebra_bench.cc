@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <string>
+
+#include "../s21_set.h"
+#include "bench.h"
+
+// Unions a big set with a small, a medium and an equally big one: with
+// std::set_union into a std::set, with merge() and with set_union(). Then
+// intersects the smaller set with the big one, which is kept intact.
+
+namespace {
+// fills both kinds of set with size keys step apart, starting at first
+void fill(s21::set<long long>& ours, std::set<long long>& theirs,
+          std::size_t size, long long first, long long step) {
+  for (std::size_t i = 0; i < size; i++) {
+    ours.insert(first + static_cast<long long>(i) * step);
+    theirs.insert(first + static_cast<long long>(i) * step);
+  }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 1000000);
+  std::size_t total = 0;
+  for (std::size_t m : {n / 1000, n / 10, n}) {
+    s21::set<long long> big, small, big_copy, small_copy, small_kept;
+    std::set<long long> std_big, std_small;
+    fill(big, std_big, n, 0, 2);
+    fill(small, std_small, m, 1, static_cast<long long>(2 * n / m));
+    big_copy = big;
+    small_copy = small;
+    small_kept = small;
+    std::string size = " (m = " + std::to_string(m) + ")";
+    s21_bench::report("std::set_union" + size, s21_bench::measure([&] {
+                        std::set<long long> result;
+                        std::set_union(std_big.begin(), std_big.end(),
+                                       std_small.begin(), std_small.end(),
+                                       std::inserter(result, result.end()));
+                        total += result.size();
+                      }),
+                      n + m);
+    s21_bench::report("merge" + size, s21_bench::measure([&] {
+                        big_copy.merge(small_copy);
+                        total += big_copy.size();
+                      }),
+                      m);
+    s21_bench::report("set_intersection" + size, s21_bench::measure([&] {
+                        small_kept.set_intersection(big_copy);
+                        total += small_kept.size();
+                      }),
+                      m);
+    s21_bench::report("set_union" + size, s21_bench::measure([&] {
+                        big.set_union(std::move(small));
+                        total += big.size();
+                      }),
+                      m);
+  }
+  s21_bench::do_not_optimize(total);
+  return 0;
+}
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../s21_set.h"
+#include "bench.h"
+
+// Compares full scans, range scans (lower_bound and a walk over the next
+// elements), inserts and erases of s21::set, whose iterators climb the
+// tree, and s21::threaded_set, whose iterators follow successor links, for
+// keys inserted in random and in ascending order.
+
+namespace {
+template <typename Set>
+void run(const std::string& name, const std::vector<long long>& keys) {
+  std::size_t n = keys.size(), total = 0;
+  Set set;
+  s21_bench::report(name + " insert", s21_bench::measure([&] {
+                      for (long long key : keys) set.insert(key);
+                    }),
+                    n);
+  s21_bench::report(name + " full scan", s21_bench::measure([&] {
+                      for (int pass = 0; pass < 10; pass++)
+                        for (long long key : set) total += key;
+                    }),
+                    10 * n);
+  s21_bench::report(name + " reverse scan", s21_bench::measure([&] {
+                      for (auto it = set.end(); it != set.begin();)
+                        total += *--it;
+                    }),
+                    n);
+  // ranges of 100 elements starting at random keys
+  std::size_t ranges = n / 100, length = 100;
+  s21_bench::report(name + " range scan", s21_bench::measure([&] {
+                      for (std::size_t i = 0; i < ranges; i++) {
+                        auto it = set.lower_bound(keys[i]);
+                        for (std::size_t j = 0; j < length && it != set.end();
+                             j++, ++it)
+                          total += *it;
+                      }
+                    }),
+                    ranges * length);
+  s21_bench::report(name + " erase", s21_bench::measure([&] {
+                      for (long long key : keys) set.erase(set.find(key));
+                    }),
+                    n);
+  s21_bench::do_not_optimize(total);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 1000000);
+  std::mt19937_64 gen(42);
+  std::vector<long long> keys(n);
+  for (auto& key : keys) key = static_cast<long long>(gen() >> 1);
+  run<s21::set<long long>>("set", keys);
+  run<s21::threaded_set<long long>>("threaded_set", keys);
+  // inserted in order the nodes lie in the pool in order as well, so the
+  // walks are not dominated by cache misses
+  std::sort(keys.begin(), keys.end());
+  run<s21::set<long long>>("set (sorted input)", keys);
+  run<s21::threaded_set<long long>>("threaded_set (sorted input)", keys);
+  return 0;
+}
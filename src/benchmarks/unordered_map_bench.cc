@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../s21_map.h"
+#include "../s21_unordered_map.h"
+#include "bench.h"
+
+// Compares s21::unordered_map with s21::map and std::unordered_map on
+// inserts, lookups of present keys (hits), of absent keys (misses) and
+// erases of random 64-bit keys.
+
+namespace {
+template <typename Map>
+void run(const std::string& name, const std::vector<long long>& keys,
+         const std::vector<long long>& hits,
+         const std::vector<long long>& misses) {
+  std::size_t n = keys.size();
+  std::size_t total = 0;
+  Map map;
+  s21_bench::report(name + " insert", s21_bench::measure([&] {
+                      for (long long key : keys) map.insert({key, key});
+                    }),
+                    n);
+  s21_bench::report(name + " hit", s21_bench::measure([&] {
+                      for (long long key : hits) total += map.count(key);
+                    }),
+                    n);
+  s21_bench::report(name + " miss", s21_bench::measure([&] {
+                      for (long long key : misses) total += map.count(key);
+                    }),
+                    n);
+  s21_bench::report(name + " erase", s21_bench::measure([&] {
+                      for (long long key : hits) total += map.erase(key);
+                    }),
+                    n);
+  s21_bench::do_not_optimize(total);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = s21_bench::elements(argc, argv, 1000000);
+  std::mt19937_64 gen(42);
+  // even keys are inserted, odd ones are missing
+  std::vector<long long> keys(n), misses(n);
+  for (std::size_t i = 0; i < n; i++) {
+    keys[i] = static_cast<long long>(gen() & ~1ULL);
+    misses[i] = static_cast<long long>(gen() | 1ULL);
+  }
+  std::vector<long long> hits = keys;
+  std::shuffle(hits.begin(), hits.end(), gen);
+
+  run<s21::map<long long, long long>>("map", keys, hits, misses);
+  run<std::unordered_map<long long, long long>>("std::unordered_map", keys,
+                                                hits, misses);
+  run<s21::unordered_map<long long, long long>>("unordered_map", keys, hits,
+                                                misses);
+  return 0;
+}
@@ -0,0 +1,893 @@
+#ifndef SRC_S21_BTREE_H_
+#define SRC_S21_BTREE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "s21_tree.h"
+
+/*
+    Implementation of the B-tree
+    A red-black tree keeps one value per node, so a lookup visits about
+   log2(n) nodes scattered over memory and pays a cache miss for each. A
+   B-tree keeps many sorted values per node instead:
+
+    1. Every node holds up to kNodeValues values, as many as fit into about
+   kTargetNodeSize bytes (four cache lines), so searching a node touches a
+   few neighbouring cache lines and the tree is only log_B(n) levels high.
+    2. An internal node with k values has k + 1 children. The values of the
+   i-th child lie between the (i - 1)-th and the i-th value of the node.
+    3. All the leaves are on the same level, and every node except the root
+   and the first and the last leaf holds at least kMinValues values.
+
+    A value is inserted into a leaf. A full leaf is split in two and its
+   middle value goes up to the parent, which is split the same way when it
+   is full; a full root gets a new root above it. Splitting the last leaf
+   at its end (or the first one at its start) leaves the old leaf full, so
+   sorted input fills the nodes up. A value of an internal node is erased by
+   replacing it with its predecessor from a leaf. A leaf left with too few
+   values borrows one from a sibling or is merged with it, which may leave
+   the parent short.
+
+    Values live inside the nodes and are moved when a node is changed, so
+   insert and erase invalidate iterators (erase returns a valid iterator to
+   the next element). An iterator is a node and a position in it; end() is
+   the position after the last value of the rightmost leaf.
+*/
+
+namespace s21 {
+// Key is the stored value type, KeyOfValue extracts the part of it the tree
+// is ordered and searched by, Compare orders the keys, Allocator provides
+// memory for the values and the nodes
+template <typename Key, typename KeyOfValue = IdentityKey<Key>,
+          typename Compare = std::less<typename KeyOfValue::key_type>,
+          typename Allocator = std::allocator<Key>>
+class BTree : private CompareHolder<Compare> {
+  using compare_holder = CompareHolder<Compare>;
+  using compare_holder::comp;
+  class BNode;
+  class BInternalNode;
+  class BIterator;
+  class BConstIterator;
+  using value_traits = std::allocator_traits<Allocator>;
+  using leaf_allocator =
+      typename value_traits::template rebind_alloc<BNode>;
+  using internal_allocator =
+      typename value_traits::template rebind_alloc<BInternalNode>;
+  using leaf_traits = std::allocator_traits<leaf_allocator>;
+  using internal_traits = std::allocator_traits<internal_allocator>;
+  using size_type = std::size_t;
+  using count_type = std::uint16_t;
+  using NodePtr = BNode*;
+  using InternalPtr = BInternalNode*;
+
+  // size of a node the number of values is chosen for
+  static constexpr size_type kTargetNodeSize = 256;
+  // maximal number of values of a node. at least 3, so that both halves of
+  // a split node keep a value
+  static constexpr size_type kNodeValues = std::max<size_type>(
+      3, (kTargetNodeSize - 2 * sizeof(void*)) / sizeof(Key));
+  // minimal number of values of a node other than the root: the smaller
+  // half of a split full node
+  static constexpr size_type kMinValues = (kNodeValues - 1) / 2;
+
+  // node and position of a value in it
+  struct Position {
+    NodePtr node;
+    size_type position;
+  };
+
+  //      =============== PUBLIC ===============
+ public:
+  using iterator = BIterator;
+  using const_iterator = BConstIterator;
+  using value_type = Key;
+  using key_type = typename KeyOfValue::key_type;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  // creates empty tree ordered by comp which gets its memory from alloc
+  explicit BTree(const Compare& comp = Compare(),
+                 const Allocator& alloc = Allocator())
+      : compare_holder(comp),
+        root_(nullptr),
+        leftmost_(nullptr),
+        rightmost_(nullptr),
+        size_(0),
+        alloc_(alloc){};
+
+  // copy constructor
+  BTree(const BTree& other)
+      : BTree(other.comp(), value_traits::select_on_container_copy_construction(
+                                other.alloc_)) {
+    copy_from(other);
+  };
+
+  // move constructor
+  BTree(BTree&& other) noexcept : BTree(other.comp(), other.alloc_) {
+    swap_contents(other);
+  };
+
+  // destructor
+  ~BTree() { clear(); };
+
+  // copy assignment. the allocator of other is taken along only if it
+  // propagates on copy assignment
+  BTree& operator=(const BTree& other) {
+    if (this != &other) {
+      // no node is left to be freed by the old allocator
+      clear();
+      if constexpr (value_traits::propagate_on_container_copy_assignment::
+                        value)
+        alloc_ = other.alloc_;
+      static_cast<compare_holder&>(*this) = other;
+      copy_from(other);
+    }
+    return *this;
+  };
+
+  // move assignment. nodes are taken over if the allocator is moved along
+  // or the allocators are equal, otherwise the values are moved one by one
+  BTree& operator=(BTree&& other) {
+    if (this != &other) {
+      clear();
+      static_cast<compare_holder&>(*this) = other;
+      if constexpr (value_traits::propagate_on_container_move_assignment::
+                        value) {
+        std::swap(alloc_, other.alloc_);
+        swap_contents(other);
+      } else if (alloc_ == other.alloc_) {
+        swap_contents(other);
+      } else {
+        for (iterator it = other.begin(); it != other.end(); ++it)
+          insert(std::move(*it), false);
+        other.clear();
+      }
+    }
+    return *this;
+  };
+
+  // returns iterator to the first element
+  iterator begin() noexcept { return iterator(leftmost_, 0); };
+  const_iterator begin() const noexcept {
+    return const_iterator(leftmost_, 0);
+  };
+
+  // returns iterator after the last element
+  iterator end() noexcept {
+    return iterator(rightmost_, rightmost_ ? rightmost_->count_ : 0);
+  };
+  const_iterator end() const noexcept {
+    return const_iterator(rightmost_, rightmost_ ? rightmost_->count_ : 0);
+  };
+
+  // checks if tree is empty
+  bool empty() const noexcept { return size_ == 0; };
+
+  // returns number of elements
+  size_type size() const noexcept { return size_; };
+
+  // returns maximal possible number of elements
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(Key);
+  };
+
+  // destroys all the elements and frees the nodes
+  void clear() noexcept {
+    if (root_ != nullptr) delete_subtree(root_);
+    root_ = leftmost_ = rightmost_ = nullptr;
+    size_ = 0;
+  };
+
+  // swaps contents with other
+  void swap(BTree& other) noexcept {
+    if constexpr (value_traits::propagate_on_container_swap::value)
+      std::swap(alloc_, other.alloc_);
+    swap_contents(other);
+  };
+
+  // inserts value. with unique true nothing is inserted if there is an
+  // equivalent element, which is returned then; otherwise value goes after
+  // the equivalent elements
+  template <typename Value>
+  std::pair<iterator, bool> insert(Value&& value, bool unique) {
+    if (root_ == nullptr) root_ = leftmost_ = rightmost_ = create_leaf();
+    const key_type& key = KeyOfValue()(value);
+    NodePtr node = root_;
+    size_type position;
+    while (true) {
+      if (unique) {
+        position = lower_index(node, key);
+        if (position < node->count_ &&
+            !comp()(key, key_of(node->values_[position])))
+          return {iterator(node, position), false};
+      } else {
+        position = upper_index(node, key);
+      }
+      if (node->leaf_) break;
+      node = child(node, position);
+    }
+    Position inserted =
+        insert_into_leaf({node, position}, std::forward<Value>(value));
+    return {iterator(inserted.node, inserted.position), true};
+  };
+
+  // erases element at pos and returns iterator to the element after it
+  iterator erase(const_iterator pos) {
+    NodePtr node = pos.it_.node_;
+    size_type position = pos.it_.position_;
+    bool internal = !node->leaf_;
+    if (internal) {
+      // the value is replaced by its predecessor, the last one of a leaf
+      NodePtr leaf = child(node, position);
+      while (!leaf->leaf_) leaf = child(leaf, leaf->count_);
+      destroy_value(node, position);
+      move_value(node, position, leaf, leaf->count_ - 1);
+      node = leaf;
+      position = leaf->count_ - 1;
+    } else {
+      destroy_value(node, position);
+    }
+    for (size_type i = position + 1; i < node->count_; i++)
+      move_value(node, i - 1, node, i);
+    node->count_--;
+    size_--;
+    Position next = {node, position};
+    rebalance(node, next);
+    if (root_ == nullptr) return end();
+    iterator result(next.node, next.position);
+    if (next.position == next.node->count_) result.climb();
+    // after an internal erase next is the predecessor which took its place
+    if (internal) ++result;
+    return result;
+  };
+
+  // moves the elements of other missing here (all of them if unique is
+  // false) into this tree
+  void merge(BTree& other, bool unique) {
+    if (this == &other) return;
+    for (iterator it = other.begin(); it != other.end();) {
+      if (unique && contains(key_of(*it)))
+        ++it;
+      else {
+        insert(std::move(*it), unique);
+        it = other.erase(it);
+      }
+    }
+  };
+
+  // lookups are templates on the key type like the ones of RBTree
+
+  // returns iterator to the first element equivalent to key or end()
+  template <typename K>
+  iterator find(const K& key) {
+    iterator it = lower_bound(key);
+    return it != end() && !comp()(key, key_of(*it)) ? it : end();
+  };
+  template <typename K>
+  const_iterator find(const K& key) const {
+    const_iterator it = lower_bound(key);
+    return it != end() && !comp()(key, key_of(*it)) ? it : end();
+  };
+
+  // checks if there is an element equivalent to key
+  template <typename K>
+  bool contains(const K& key) const {
+    return find(key) != end();
+  };
+
+  // returns number of elements equivalent to key
+  template <typename K>
+  size_type count(const K& key) const {
+    size_type result = 0;
+    const_iterator last = upper_bound(key);
+    for (const_iterator it = lower_bound(key); it != last; ++it) result++;
+    return result;
+  };
+
+  // returns iterator to the first element not less than key
+  template <typename K>
+  iterator lower_bound(const K& key) {
+    Position found = bound(key, false);
+    return iterator(found.node, found.position);
+  };
+  template <typename K>
+  const_iterator lower_bound(const K& key) const {
+    Position found = bound(key, false);
+    return const_iterator(found.node, found.position);
+  };
+
+  // returns iterator to the first element greater than key
+  template <typename K>
+  iterator upper_bound(const K& key) {
+    Position found = bound(key, true);
+    return iterator(found.node, found.position);
+  };
+  template <typename K>
+  const_iterator upper_bound(const K& key) const {
+    Position found = bound(key, true);
+    return const_iterator(found.node, found.position);
+  };
+
+  // returns range of elements equivalent to key
+  template <typename K>
+  std::pair<iterator, iterator> equal_range(const K& key) {
+    return {lower_bound(key), upper_bound(key)};
+  };
+  template <typename K>
+  std::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  };
+
+  // returns the comparator of the keys
+  key_compare key_comp() const { return comp(); };
+
+  // returns the allocator of the values
+  allocator_type get_allocator() const noexcept { return alloc_; };
+
+  //      =============== PRIVATE ===============
+ private:
+  // returns key of value
+  static const key_type& key_of(const value_type& value) noexcept {
+    return KeyOfValue()(value);
+  };
+
+  // returns i-th child of internal node
+  static NodePtr& child(NodePtr node, size_type i) noexcept {
+    return static_cast<InternalPtr>(node)->children_[i];
+  };
+
+  // makes node i-th child of parent
+  static void set_child(NodePtr parent, size_type i, NodePtr node) noexcept {
+    child(parent, i) = node;
+    node->parent_ = parent;
+    node->position_ = static_cast<count_type>(i);
+  };
+
+  // returns index of the first value of node not less than key
+  template <typename K>
+  size_type lower_index(NodePtr node, const K& key) const {
+    size_type low = 0, high = node->count_;
+    while (low < high) {
+      size_type middle = (low + high) / 2;
+      if (comp()(key_of(node->values_[middle]), key))
+        low = middle + 1;
+      else
+        high = middle;
+    }
+    return low;
+  };
+
+  // returns index of the first value of node greater than key
+  template <typename K>
+  size_type upper_index(NodePtr node, const K& key) const {
+    size_type low = 0, high = node->count_;
+    while (low < high) {
+      size_type middle = (low + high) / 2;
+      if (comp()(key, key_of(node->values_[middle])))
+        high = middle;
+      else
+        low = middle + 1;
+    }
+    return low;
+  };
+
+  // returns position of the first value not less than key (greater than key
+  // if upper is true). the deepest node having such a value holds it
+  template <typename K>
+  Position bound(const K& key, bool upper) const {
+    Position result = {rightmost_, 0};
+    if (rightmost_ != nullptr) result.position = rightmost_->count_;
+    for (NodePtr node = root_; node != nullptr;) {
+      size_type i = upper ? upper_index(node, key) : lower_index(node, key);
+      if (i < node->count_) result = {node, i};
+      if (node->leaf_) break;
+      node = child(node, i);
+    }
+    return result;
+  };
+
+  // inserts value into leaf at position, splitting the leaf first if it is
+  // full. returns where the value is
+  template <typename Value>
+  Position insert_into_leaf(Position at, Value&& value) {
+    if (at.node->count_ < kNodeValues)
+      return construct_in_leaf(at, std::forward<Value>(value));
+    // the value is made before the split, so if its constructor throws the
+    // tree is left as it was
+    ValueHolder held(alloc_, std::forward<Value>(value));
+    NodePtr node = at.node;
+    size_type position = at.position;
+    // at the end or the start of the tree the input is likely sorted, so
+    // the old leaf is left full
+    size_type middle = kNodeValues / 2;
+    if (position == kNodeValues && node == rightmost_)
+      middle = kNodeValues - 1;
+    else if (position == 0 && node == leftmost_)
+      middle = 0;
+    NodePtr sibling = split_node(node, middle);
+    if (position > middle) {
+      node = sibling;
+      position -= middle + 1;
+    }
+    return construct_in_leaf({node, position}, std::move(held.value()));
+  };
+
+  // constructs value at position of leaf with room for it
+  template <typename Value>
+  Position construct_in_leaf(Position at, Value&& value) {
+    NodePtr node = at.node;
+    size_type position = at.position;
+    for (size_type i = node->count_; i > position; i--)
+      move_value(node, i, node, i - 1);
+    try {
+      value_traits::construct(alloc_, std::addressof(node->values_[position]),
+                              std::forward<Value>(value));
+    } catch (...) {
+      for (size_type i = position; i < node->count_; i++)
+        move_value(node, i, node, i + 1);
+      throw;
+    }
+    node->count_++;
+    size_++;
+    return {node, position};
+  };
+
+  // splits full node: its values after middle go to a new right sibling
+  // and the value at middle goes up to the parent. a full parent is split
+  // first, the root gets a new root above it. returns the sibling
+  NodePtr split_node(NodePtr node, size_type middle) {
+    NodePtr sibling = node->leaf_ ? create_leaf() : create_internal();
+    try {
+      if (node == root_) {
+        NodePtr root = create_internal();
+        set_child(root, 0, node);
+        root_ = root;
+      } else if (node->parent_->count_ == kNodeValues) {
+        split_node(node->parent_, kNodeValues / 2);
+      }
+    } catch (...) {
+      delete_node(sibling);
+      throw;
+    }
+    size_type moved = node->count_ - middle - 1;
+    for (size_type i = 0; i < moved; i++)
+      move_value(sibling, i, node, middle + 1 + i);
+    if (!node->leaf_)
+      for (size_type i = 0; i <= moved; i++)
+        set_child(sibling, i, child(node, middle + 1 + i));
+    sibling->count_ = static_cast<count_type>(moved);
+    NodePtr parent = node->parent_;
+    size_type at = node->position_;
+    for (size_type i = parent->count_; i > at; i--) {
+      move_value(parent, i, parent, i - 1);
+      set_child(parent, i + 1, child(parent, i));
+    }
+    move_value(parent, at, node, middle);
+    set_child(parent, at + 1, sibling);
+    parent->count_++;
+    node->count_ = static_cast<count_type>(middle);
+    if (node == rightmost_) rightmost_ = sibling;
+    return sibling;
+  };
+
+  // restores the minimal number of values from node up to the root after
+  // an erase. tracked is moved along with the value it points to
+  void rebalance(NodePtr node, Position& tracked) noexcept {
+    while (node != root_ && node->count_ < kMinValues) {
+      NodePtr parent = node->parent_;
+      size_type at = node->position_;
+      NodePtr left = at > 0 ? child(parent, at - 1) : nullptr;
+      NodePtr right = at < parent->count_ ? child(parent, at + 1) : nullptr;
+      if (left != nullptr && left->count_ + node->count_ < kNodeValues) {
+        merge_nodes(left, node, tracked);
+      } else if (right != nullptr &&
+                 node->count_ + right->count_ < kNodeValues) {
+        merge_nodes(node, right, tracked);
+      } else if (left != nullptr && left->count_ > kMinValues) {
+        borrow_left(left, node, tracked);
+        break;
+      } else if (right != nullptr) {
+        borrow_right(node, right);
+        break;
+      }
+      node = parent;
+    }
+    if (root_->count_ == 0) {
+      NodePtr old = root_;
+      if (old->leaf_) {
+        root_ = leftmost_ = rightmost_ = nullptr;
+      } else {
+        root_ = child(old, 0);
+        root_->parent_ = nullptr;
+        root_->position_ = 0;
+      }
+      delete_node(old);
+    }
+  };
+
+  // moves the separating value of the parent and all of right into left,
+  // then deletes right
+  void merge_nodes(NodePtr left, NodePtr right, Position& tracked) noexcept {
+    NodePtr parent = left->parent_;
+    size_type at = left->position_;
+    size_type offset = left->count_ + 1;
+    move_value(left, left->count_, parent, at);
+    for (size_type i = 0; i < right->count_; i++)
+      move_value(left, offset + i, right, i);
+    if (!left->leaf_)
+      for (size_type i = 0; i <= right->count_; i++)
+        set_child(left, offset + i, child(right, i));
+    left->count_ = static_cast<count_type>(offset + right->count_);
+    for (size_type i = at + 1; i < parent->count_; i++) {
+      move_value(parent, i - 1, parent, i);
+      set_child(parent, i, child(parent, i + 1));
+    }
+    parent->count_--;
+    if (tracked.node == right) tracked = {left, offset + tracked.position};
+    if (right == rightmost_) rightmost_ = left;
+    right->count_ = 0;
+    delete_node(right);
+  };
+
+  // moves the last value of left up to the parent and the separating value
+  // down to the front of node
+  void borrow_left(NodePtr left, NodePtr node, Position& tracked) noexcept {
+    NodePtr parent = node->parent_;
+    size_type at = node->position_ - 1;
+    for (size_type i = node->count_; i > 0; i--)
+      move_value(node, i, node, i - 1);
+    move_value(node, 0, parent, at);
+    move_value(parent, at, left, left->count_ - 1);
+    if (!node->leaf_) {
+      for (size_type i = node->count_ + 1; i > 0; i--)
+        set_child(node, i, child(node, i - 1));
+      set_child(node, 0, child(left, left->count_));
+    }
+    left->count_--;
+    node->count_++;
+    if (tracked.node == node) tracked.position++;
+  };
+
+  // moves the first value of right up to the parent and the separating
+  // value down to the end of node
+  void borrow_right(NodePtr node, NodePtr right) noexcept {
+    NodePtr parent = node->parent_;
+    size_type at = node->position_;
+    move_value(node, node->count_, parent, at);
+    move_value(parent, at, right, 0);
+    for (size_type i = 1; i < right->count_; i++)
+      move_value(right, i - 1, right, i);
+    if (!node->leaf_) {
+      set_child(node, node->count_ + 1, child(right, 0));
+      for (size_type i = 1; i <= right->count_; i++)
+        set_child(right, i - 1, child(right, i));
+    }
+    node->count_++;
+    right->count_--;
+  };
+
+  // move constructs i-th value of to from j-th value of from, which is
+  // destroyed
+  void move_value(NodePtr to, size_type i, NodePtr from,
+                  size_type j) noexcept {
+    value_traits::construct(alloc_, std::addressof(to->values_[i]),
+                            std::move(from->values_[j]));
+    value_traits::destroy(alloc_, std::addressof(from->values_[j]));
+  };
+
+  // destroys i-th value of node
+  void destroy_value(NodePtr node, size_type i) noexcept {
+    value_traits::destroy(alloc_, std::addressof(node->values_[i]));
+  };
+
+  // copies contents of other into empty tree
+  void copy_from(const BTree& other) {
+    if (other.root_ == nullptr) return;
+    root_ = clone(other.root_, nullptr);
+    for (leftmost_ = root_; !leftmost_->leaf_;) leftmost_ = child(leftmost_, 0);
+    for (rightmost_ = root_; !rightmost_->leaf_;)
+      rightmost_ = child(rightmost_, rightmost_->count_);
+    size_ = other.size_;
+  };
+
+  // returns copy of subtree. if a value cannot be copied, everything copied
+  // so far is deleted
+  NodePtr clone(NodePtr source, NodePtr parent) {
+    NodePtr node = source->leaf_ ? create_leaf() : create_internal();
+    node->parent_ = parent;
+    node->position_ = source->position_;
+    try {
+      for (size_type i = 0; i < source->count_; i++, node->count_++)
+        value_traits::construct(alloc_, std::addressof(node->values_[i]),
+                                source->values_[i]);
+      if (!node->leaf_)
+        for (size_type i = 0; i <= source->count_; i++)
+          child(node, i) = clone(child(source, i), node);
+    } catch (...) {
+      delete_subtree(node);
+      throw;
+    }
+    return node;
+  };
+
+  // destroys the values of subtree and frees its nodes
+  void delete_subtree(NodePtr node) noexcept {
+    if (!node->leaf_)
+      for (size_type i = 0; i <= node->count_; i++)
+        if (child(node, i) != nullptr) delete_subtree(child(node, i));
+    for (size_type i = 0; i < node->count_; i++) destroy_value(node, i);
+    delete_node(node);
+  };
+
+  // allocates empty leaf
+  NodePtr create_leaf() {
+    leaf_allocator alloc(alloc_);
+    NodePtr node = leaf_traits::allocate(alloc, 1);
+    return ::new (static_cast<void*>(node)) BNode(true);
+  };
+
+  // allocates empty internal node
+  NodePtr create_internal() {
+    internal_allocator alloc(alloc_);
+    InternalPtr node = internal_traits::allocate(alloc, 1);
+    return ::new (static_cast<void*>(node)) BInternalNode();
+  };
+
+  // frees node. its values must be destroyed or moved out before
+  void delete_node(NodePtr node) noexcept {
+    if (node->leaf_) {
+      leaf_allocator alloc(alloc_);
+      node->~BNode();
+      leaf_traits::deallocate(alloc, node, 1);
+    } else {
+      internal_allocator alloc(alloc_);
+      InternalPtr internal = static_cast<InternalPtr>(node);
+      internal->~BInternalNode();
+      internal_traits::deallocate(alloc, internal, 1);
+    }
+  };
+
+  // swaps nodes and sizes but not the allocators
+  void swap_contents(BTree& other) noexcept {
+    using std::swap;
+    compare_holder::swap_comp(other);
+    swap(root_, other.root_);
+    swap(leftmost_, other.leftmost_);
+    swap(rightmost_, other.rightmost_);
+    swap(size_, other.size_);
+  };
+
+  NodePtr root_;       // root node, nullptr if the tree is empty
+  NodePtr leftmost_;   // leaf holding the first element
+  NodePtr rightmost_;  // leaf holding the last element
+  size_type size_;
+  Allocator alloc_;
+
+  //      =============== NODE CLASSES ===============
+
+  // Leaf node. the values are constructed and destroyed by the tree
+  class BNode {
+   public:
+    explicit BNode(bool leaf)
+        : parent_(nullptr), position_(0), count_(0), leaf_(leaf){};
+
+    ~BNode(){};
+
+    NodePtr parent_;
+    count_type position_;  // index of the node among children of parent
+    count_type count_;     // number of values
+    bool leaf_;
+    union {
+      Key values_[kNodeValues];
+    };
+  };
+
+  // Value constructed outside of the nodes, destroyed along with the holder
+  class ValueHolder {
+   public:
+    template <typename... Args>
+    explicit ValueHolder(Allocator& alloc, Args&&... args) : alloc_(alloc) {
+      value_traits::construct(alloc_, std::addressof(value_),
+                              std::forward<Args>(args)...);
+    };
+
+    ~ValueHolder() { value_traits::destroy(alloc_, std::addressof(value_)); };
+
+    Key& value() noexcept { return value_; };
+
+   private:
+    Allocator& alloc_;
+    union {
+      Key value_;
+    };
+  };
+
+  // Internal node: a leaf with children
+  class BInternalNode : public BNode {
+   public:
+    BInternalNode() : BNode(false), children_(){};
+
+    NodePtr children_[kNodeValues + 1];
+  };
+
+  //      =============== ITERATOR CLASSES ===============
+
+  class BIterator {
+    friend BTree;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Key*;
+    using reference = Key&;
+
+    // default constructor
+    BIterator() : node_(nullptr), position_(0){};
+
+    // constructor with node and position
+    BIterator(NodePtr node, size_type position)
+        : node_(node), position_(position){};
+
+    // * overload returns value
+    reference operator*() const noexcept {
+      return node_->values_[position_];
+    };
+
+    // -> overload returns pointer to value
+    pointer operator->() const noexcept {
+      return std::addressof(node_->values_[position_]);
+    };
+
+    // overload; checks if iterators point to the same place
+    bool operator==(const BIterator& other) const noexcept {
+      return node_ == other.node_ && position_ == other.position_;
+    };
+
+    // overload; checks if iterators point to different places
+    bool operator!=(const BIterator& other) const noexcept {
+      return !(*this == other);
+    };
+
+    // moves to the next element: to the leftmost leaf of the next child of
+    // an internal node, or along the leaf and up when it ends
+    BIterator& operator++() noexcept {
+      if (!node_->leaf_) {
+        node_ = child(node_, position_ + 1);
+        while (!node_->leaf_) node_ = child(node_, 0);
+        position_ = 0;
+      } else if (++position_ == node_->count_) {
+        climb();
+      }
+      return *this;
+    };
+
+    // postfix increment
+    BIterator operator++(int) noexcept {
+      BIterator tmp = *this;
+      ++*this;
+      return tmp;
+    };
+
+    // moves to the previous element the same way
+    BIterator& operator--() noexcept {
+      if (!node_->leaf_) {
+        node_ = child(node_, position_);
+        while (!node_->leaf_) node_ = child(node_, node_->count_);
+        position_ = node_->count_ - 1;
+      } else if (position_ > 0) {
+        position_--;
+      } else {
+        NodePtr node = node_;
+        while (node->parent_ != nullptr && node->position_ == 0)
+          node = node->parent_;
+        if (node->parent_ != nullptr) {
+          position_ = node->position_ - 1;
+          node_ = node->parent_;
+        }
+      }
+      return *this;
+    };
+
+    // postfix decrement
+    BIterator operator--(int) noexcept {
+      BIterator tmp = *this;
+      --*this;
+      return tmp;
+    };
+
+   private:
+    // goes up from the end of a node to the next value of an ancestor. the
+    // end of the rightmost leaf is end(), there it stays
+    void climb() noexcept {
+      NodePtr node = node_;
+      size_type position = position_;
+      while (position == node->count_ && node->parent_ != nullptr) {
+        position = node->position_;
+        node = node->parent_;
+      }
+      if (position < node->count_) {
+        node_ = node;
+        position_ = position;
+      }
+    };
+
+    NodePtr node_;
+    size_type position_;
+  };
+
+  class BConstIterator {
+    friend BTree;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key*;
+    using reference = const Key&;
+
+    // default constructor
+    BConstIterator(){};
+
+    // constructor with node and position
+    BConstIterator(NodePtr node, size_type position) : it_(node, position){};
+
+    // conversion from iterator
+    BConstIterator(const BIterator& it) : it_(it){};
+
+    // * overload returns value
+    reference operator*() const noexcept { return *it_; };
+
+    // -> overload returns pointer to value
+    pointer operator->() const noexcept { return it_.operator->(); };
+
+    // overload; checks if iterators point to the same place
+    bool operator==(const BConstIterator& other) const noexcept {
+      return it_ == other.it_;
+    };
+
+    // overload; checks if iterators point to different places
+    bool operator!=(const BConstIterator& other) const noexcept {
+      return it_ != other.it_;
+    };
+
+    // moves to the next element
+    BConstIterator& operator++() noexcept {
+      ++it_;
+      return *this;
+    };
+
+    // postfix increment
+    BConstIterator operator++(int) noexcept {
+      BConstIterator tmp = *this;
+      ++it_;
+      return tmp;
+    };
+
+    // moves to the previous element
+    BConstIterator& operator--() noexcept {
+      --it_;
+      return *this;
+    };
+
+    // postfix decrement
+    BConstIterator operator--(int) noexcept {
+      BConstIterator tmp = *this;
+      --it_;
+      return tmp;
+    };
+
+   private:
+    BIterator it_;
+  };
+};
+}  // namespace s21
+
+#endif  // SRC_S21_BTREE_H_
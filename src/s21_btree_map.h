@@ -0,0 +1,210 @@
+#ifndef SRC_S21_BTREE_MAP_H_
+#define SRC_S21_BTREE_MAP_H_
+
+#include <stdexcept>
+
+#include "s21_btree.h"
+
+/*
+    Implementation of btree_map
+    btree_map is a map kept in a B-tree, see btree_set. Key-value pairs are
+   stored inside the nodes, so insert and erase invalidate iterators.
+*/
+
+namespace s21 {
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class btree_map {
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using tree = BTree<value_type, PairFirstKey<value_type>, Compare, Allocator>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+ public:
+  using iterator = typename tree::iterator;
+  using const_iterator = typename tree::const_iterator;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  // default constructor, creates an empty map
+  btree_map() : tree_(){};
+
+  // creates an empty map ordered by comp which gets its memory from alloc
+  explicit btree_map(const Compare& comp,
+                     const Allocator& alloc = Allocator())
+      : tree_(comp, alloc){};
+
+  // creates an empty map which gets its memory from alloc
+  explicit btree_map(const Allocator& alloc) : tree_(Compare(), alloc){};
+
+  // initializer list constructor
+  btree_map(std::initializer_list<value_type> const& items,
+            const Compare& comp = Compare(),
+            const Allocator& alloc = Allocator())
+      : btree_map(items.begin(), items.end(), comp, alloc){};
+
+  // range constructor, creates the map from [first, last) in any order
+  template <typename InputIt, typename = if_iterator<InputIt>>
+  btree_map(InputIt first, InputIt last, const Compare& comp = Compare(),
+            const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    for (; first != last; ++first) tree_.insert(*first, true);
+  };
+
+  // copy constructor
+  btree_map(const btree_map& m) : tree_(m.tree_){};
+
+  // move constructor
+  btree_map(btree_map&& m) noexcept : tree_(std::move(m.tree_)){};
+
+  // destructor
+  ~btree_map() = default;
+
+  // assignment operator overload for copying an object
+  btree_map& operator=(const btree_map& m) {
+    tree_ = m.tree_;
+    return *this;
+  };
+
+  // assignment operator overload for moving an object
+  btree_map& operator=(btree_map&& m) {
+    tree_ = std::move(m.tree_);
+    return *this;
+  };
+
+  // access a specified element with bounds checking
+  T& at(const Key& key) {
+    iterator it = tree_.find(key);
+    if (it == tree_.end()) throw std::out_of_range("btree_map::at");
+    return it->second;
+  };
+
+  // access a specified element with bounds checking for const map
+  const T& at(const Key& key) const {
+    const_iterator it = tree_.find(key);
+    if (it == tree_.end()) throw std::out_of_range("btree_map::at");
+    return it->second;
+  };
+
+  // access or insert specified element
+  T& operator[](const Key& key) {
+    iterator it = tree_.find(key);
+    if (it == tree_.end())
+      it = tree_.insert(value_type{key, mapped_type{}}, true).first;
+    return it->second;
+  };
+
+  // returns an iterator to the beginning
+  iterator begin() noexcept { return tree_.begin(); };
+
+  // returns an iterator to the end
+  iterator end() noexcept { return tree_.end(); };
+
+  // returns an iterator to the beginning for const map
+  const_iterator begin() const noexcept { return tree_.begin(); };
+
+  // returns an iterator to the end for const map
+  const_iterator end() const noexcept { return tree_.end(); };
+
+  // checks whether the container is empty
+  bool empty() const noexcept { return tree_.empty(); };
+
+  // returns the number of elements
+  size_type size() const noexcept { return tree_.size(); };
+
+  // returns the maximum possible number of elements
+  size_type max_size() const noexcept { return tree_.max_size(); };
+
+  // clears the contents
+  void clear() noexcept { tree_.clear(); };
+
+  // inserts an element and returns an iterator to where the element is in
+  // the container and bool denoting whether the insertion took place
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return tree_.insert(value, true);
+  };
+
+  // same for an element which is moved in
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return tree_.insert(std::move(value), true);
+  };
+
+  // inserts a value by key
+  std::pair<iterator, bool> insert(const Key& key, const T& obj) {
+    return tree_.insert(value_type{key, obj}, true);
+  };
+
+  // inserts an element or assigns to the current element if the key already
+  // exists
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
+    iterator it = tree_.find(key);
+    if (it == tree_.end()) return tree_.insert(value_type{key, obj}, true);
+    it->second = obj;
+    return {it, false};
+  };
+
+  // erases the element at pos and returns an iterator to the next one
+  iterator erase(const_iterator pos) { return tree_.erase(pos); };
+
+  // swaps the contents
+  void swap(btree_map& other) noexcept { tree_.swap(other.tree_); };
+
+  // moves the elements of other with keys missing here into this map
+  void merge(btree_map& other) { tree_.merge(other.tree_, true); };
+
+  // checks if there is an element with key equivalent to key
+  bool contains(const Key& key) const { return tree_.contains(key); };
+
+  // finds an element with a specific key
+  iterator find(const Key& key) { return tree_.find(key); };
+
+  // same for const map
+  const_iterator find(const Key& key) const { return tree_.find(key); };
+
+  // returns the number of elements with a specific key
+  size_type count(const Key& key) const { return tree_.count(key); };
+
+  // returns an iterator to the first element not less than the given key
+  iterator lower_bound(const Key& key) { return tree_.lower_bound(key); };
+
+  // same for const map
+  const_iterator lower_bound(const Key& key) const {
+    return tree_.lower_bound(key);
+  };
+
+  // returns an iterator to the first element greater than the given key
+  iterator upper_bound(const Key& key) { return tree_.upper_bound(key); };
+
+  // same for const map
+  const_iterator upper_bound(const Key& key) const {
+    return tree_.upper_bound(key);
+  };
+
+  // returns range of elements matching a specific key
+  std::pair<iterator, iterator> equal_range(const Key& key) {
+    return tree_.equal_range(key);
+  };
+
+  // same for const map
+  std::pair<const_iterator, const_iterator> equal_range(const Key& key) const {
+    return tree_.equal_range(key);
+  };
+
+  // returns the function object which compares the keys
+  key_compare key_comp() const { return tree_.key_comp(); };
+
+  // returns the allocator associated with the container
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
+ private:
+  tree tree_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_BTREE_MAP_H_
@@ -0,0 +1,157 @@
+#ifndef SRC_S21_BTREE_MULTISET_H_
+#define SRC_S21_BTREE_MULTISET_H_
+
+#include "s21_btree.h"
+
+/*
+    Implementation of btree_multiset
+    btree_multiset is a multiset kept in a B-tree, see btree_set. Equivalent
+   elements are stored next to each other in the order of insertion.
+*/
+
+namespace s21 {
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class btree_multiset {
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using tree = BTree<value_type, IdentityKey<value_type>, Compare, Allocator>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+ public:
+  // elements of a multiset cannot be changed, so both iterators are constant
+  using iterator = typename tree::const_iterator;
+  using const_iterator = typename tree::const_iterator;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using allocator_type = Allocator;
+
+  // default constructor, creates an empty multiset
+  btree_multiset() : tree_(){};
+
+  // creates an empty multiset ordered by comp which gets its memory from alloc
+  explicit btree_multiset(const Compare& comp,
+                          const Allocator& alloc = Allocator())
+      : tree_(comp, alloc){};
+
+  // creates an empty multiset which gets its memory from alloc
+  explicit btree_multiset(const Allocator& alloc) : tree_(Compare(), alloc){};
+
+  // initializer list constructor
+  btree_multiset(std::initializer_list<value_type> const& items,
+                 const Compare& comp = Compare(),
+                 const Allocator& alloc = Allocator())
+      : btree_multiset(items.begin(), items.end(), comp, alloc){};
+
+  // range constructor, creates the multiset from [first, last) in any order
+  template <typename InputIt, typename = if_iterator<InputIt>>
+  btree_multiset(InputIt first, InputIt last,
+                 const Compare& comp = Compare(),
+                 const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    for (; first != last; ++first) tree_.insert(*first, false);
+  };
+
+  // copy constructor
+  btree_multiset(const btree_multiset& s) : tree_(s.tree_){};
+
+  // move constructor
+  btree_multiset(btree_multiset&& s) noexcept : tree_(std::move(s.tree_)){};
+
+  // destructor
+  ~btree_multiset() = default;
+
+  // assignment operator overload for copying an object
+  btree_multiset& operator=(const btree_multiset& other) {
+    tree_ = other.tree_;
+    return *this;
+  };
+
+  // assignment operator overload for moving an object
+  btree_multiset& operator=(btree_multiset&& other) {
+    tree_ = std::move(other.tree_);
+    return *this;
+  };
+
+  // returns an iterator to the beginning
+  iterator begin() const noexcept { return tree_.begin(); };
+
+  // returns an iterator to the end
+  iterator end() const noexcept { return tree_.end(); };
+
+  // checks whether the container is empty
+  bool empty() const noexcept { return tree_.empty(); };
+
+  // returns the number of elements
+  size_type size() const noexcept { return tree_.size(); };
+
+  // returns the maximum possible number of elements
+  size_type max_size() const noexcept { return tree_.max_size(); };
+
+  // clears the contents
+  void clear() noexcept { tree_.clear(); };
+
+  // inserts an element after the equivalent ones and returns an iterator
+  // to it
+  iterator insert(const_reference key) {
+    return tree_.insert(key, false).first;
+  };
+
+  // same for an element which is moved in
+  iterator insert(value_type&& key) {
+    return tree_.insert(std::move(key), false).first;
+  };
+
+  // erases the element at pos and returns an iterator to the next one
+  iterator erase(const_iterator pos) { return tree_.erase(pos); };
+
+  // swaps the contents
+  void swap(btree_multiset& other) noexcept { tree_.swap(other.tree_); };
+
+  // moves all the elements of other into this multiset
+  void merge(btree_multiset& other) { tree_.merge(other.tree_, false); };
+
+  // finds an element with a specific key
+  iterator find(const_reference key) const { return tree_.find(key); };
+
+  // checks if the container contains an element with a specific key
+  bool contains(const_reference key) const { return tree_.contains(key); };
+
+  // returns the number of elements with a specific key
+  size_type count(const_reference key) const { return tree_.count(key); };
+
+  // returns an iterator to the first element not less than the given key
+  iterator lower_bound(const_reference key) const {
+    return tree_.lower_bound(key);
+  };
+
+  // returns an iterator to the first element greater than the given key
+  iterator upper_bound(const_reference key) const {
+    return tree_.upper_bound(key);
+  };
+
+  // returns range of elements matching a specific key
+  std::pair<iterator, iterator> equal_range(const_reference key) const {
+    return tree_.equal_range(key);
+  };
+
+  // returns the function object which compares the keys
+  key_compare key_comp() const { return tree_.key_comp(); };
+
+  // returns the function object which compares the values
+  value_compare value_comp() const { return tree_.key_comp(); };
+
+  // returns the allocator associated with the container
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
+ private:
+  tree tree_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_BTREE_MULTISET_H_
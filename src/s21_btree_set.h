@@ -0,0 +1,158 @@
+#ifndef SRC_S21_BTREE_SET_H_
+#define SRC_S21_BTREE_SET_H_
+
+#include "s21_btree.h"
+
+/*
+    Implementation of btree_set
+    btree_set is a set of unique elements kept in a B-tree: every node holds
+   a few cache lines of sorted elements, so lookups and in-order walks touch
+   much less memory than in s21::set. The price is that insert and erase
+   move elements inside the nodes and invalidate iterators.
+*/
+
+namespace s21 {
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class btree_set {
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using tree = BTree<value_type, IdentityKey<value_type>, Compare, Allocator>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+ public:
+  // elements of a set cannot be changed, so both iterators are constant
+  using iterator = typename tree::const_iterator;
+  using const_iterator = typename tree::const_iterator;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using allocator_type = Allocator;
+
+  // default constructor, creates an empty set
+  btree_set() : tree_(){};
+
+  // creates an empty set ordered by comp which gets its memory from alloc
+  explicit btree_set(const Compare& comp,
+                     const Allocator& alloc = Allocator())
+      : tree_(comp, alloc){};
+
+  // creates an empty set which gets its memory from alloc
+  explicit btree_set(const Allocator& alloc) : tree_(Compare(), alloc){};
+
+  // initializer list constructor
+  btree_set(std::initializer_list<value_type> const& items,
+            const Compare& comp = Compare(),
+            const Allocator& alloc = Allocator())
+      : btree_set(items.begin(), items.end(), comp, alloc){};
+
+  // range constructor, creates the set from [first, last) in any order
+  template <typename InputIt, typename = if_iterator<InputIt>>
+  btree_set(InputIt first, InputIt last, const Compare& comp = Compare(),
+            const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    for (; first != last; ++first) tree_.insert(*first, true);
+  };
+
+  // copy constructor
+  btree_set(const btree_set& s) : tree_(s.tree_){};
+
+  // move constructor
+  btree_set(btree_set&& s) noexcept : tree_(std::move(s.tree_)){};
+
+  // destructor
+  ~btree_set() = default;
+
+  // assignment operator overload for copying an object
+  btree_set& operator=(const btree_set& other) {
+    tree_ = other.tree_;
+    return *this;
+  };
+
+  // assignment operator overload for moving an object
+  btree_set& operator=(btree_set&& other) {
+    tree_ = std::move(other.tree_);
+    return *this;
+  };
+
+  // returns an iterator to the beginning
+  iterator begin() const noexcept { return tree_.begin(); };
+
+  // returns an iterator to the end
+  iterator end() const noexcept { return tree_.end(); };
+
+  // checks whether the container is empty
+  bool empty() const noexcept { return tree_.empty(); };
+
+  // returns the number of elements
+  size_type size() const noexcept { return tree_.size(); };
+
+  // returns the maximum possible number of elements
+  size_type max_size() const noexcept { return tree_.max_size(); };
+
+  // clears the contents
+  void clear() noexcept { tree_.clear(); };
+
+  // inserts an element and returns an iterator to where the element is in
+  // the container and bool denoting whether the insertion took place
+  std::pair<iterator, bool> insert(const_reference key) {
+    return tree_.insert(key, true);
+  };
+
+  // same for an element which is moved in
+  std::pair<iterator, bool> insert(value_type&& key) {
+    return tree_.insert(std::move(key), true);
+  };
+
+  // erases the element at pos and returns an iterator to the next one
+  iterator erase(const_iterator pos) { return tree_.erase(pos); };
+
+  // swaps the contents
+  void swap(btree_set& other) noexcept { tree_.swap(other.tree_); };
+
+  // moves the elements of other missing here into this set
+  void merge(btree_set& other) { tree_.merge(other.tree_, true); };
+
+  // finds an element with a specific key
+  iterator find(const_reference key) const { return tree_.find(key); };
+
+  // checks if the container contains an element with a specific key
+  bool contains(const_reference key) const { return tree_.contains(key); };
+
+  // returns the number of elements with a specific key
+  size_type count(const_reference key) const { return tree_.count(key); };
+
+  // returns an iterator to the first element not less than the given key
+  iterator lower_bound(const_reference key) const {
+    return tree_.lower_bound(key);
+  };
+
+  // returns an iterator to the first element greater than the given key
+  iterator upper_bound(const_reference key) const {
+    return tree_.upper_bound(key);
+  };
+
+  // returns range of elements matching a specific key
+  std::pair<iterator, iterator> equal_range(const_reference key) const {
+    return tree_.equal_range(key);
+  };
+
+  // returns the function object which compares the keys
+  key_compare key_comp() const { return tree_.key_comp(); };
+
+  // returns the function object which compares the values
+  value_compare value_comp() const { return tree_.key_comp(); };
+
+  // returns the allocator associated with the container
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
+ private:
+  tree tree_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_BTREE_SET_H_
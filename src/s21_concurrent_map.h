@@ -0,0 +1,398 @@
+#ifndef SRC_S21_CONCURRENT_MAP_H_
+#define SRC_S21_CONCURRENT_MAP_H_
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "s21_map.h"
+
+/*
+    Implementation of concurrent_map
+    concurrent_map is a map which many threads may use at once. The elements
+   are split between shards by the hash of their keys, every shard is an
+   s21::map guarded by its own reader-writer lock, so threads working with
+   keys of different shards do not wait for each other and readers of one
+   shard do not wait for each other either.
+
+    References to the elements cannot leave the lock, so there are no
+   iterators: lookups return copies of the mapped values, and visit and
+   for_each call a function on the elements under the lock. The function
+   must not use the map itself.
+
+    Batch operations take a range of keys or elements, group it by shard
+   and lock every shard once for all of its part of the batch. A batch is
+   not atomic: other threads may see some of its shards done and some not.
+   for_each goes over the shards one by one in the same way, unless it is
+   given the consistent tag: then it locks all the shards first and sees
+   the map at one moment, while updates wait.
+
+    Shards are ordered by Compare, but the map as a whole is not: for_each
+   goes over the elements in no particular order, to_map returns them
+   sorted.
+*/
+
+namespace s21 {
+// tag asking for a view of all the shards at one moment
+struct consistent_t {
+  explicit consistent_t() = default;
+};
+inline constexpr consistent_t consistent{};
+
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class concurrent_map {
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using shard_map = map<Key, T, Compare, Allocator>;
+  using size_type = std::size_t;
+  using shared_lock = std::shared_lock<std::shared_mutex>;
+  using unique_lock = std::unique_lock<std::shared_mutex>;
+
+  // shards are put on separate cache lines, so that taking the lock of one
+  // does not slow down threads working with its neighbours
+  static constexpr size_type kLineSize = 64;
+
+  struct alignas(kLineSize) Shard {
+    mutable std::shared_mutex mutex;
+    shard_map map;
+  };
+
+ public:
+  using hasher = Hash;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  // number of shards of a default constructed map
+  static constexpr size_type kDefaultShards = 64;
+
+  // creates an empty map with kDefaultShards shards
+  concurrent_map() : concurrent_map(kDefaultShards){};
+
+  // creates an empty map with shards shards, rounded up to a power of two
+  explicit concurrent_map(size_type shards, const Hash& hash = Hash(),
+                          const Compare& comp = Compare(),
+                          const Allocator& alloc = Allocator())
+      : hash_(hash), mask_(shard_mask(shards)), shards_(new Shard[mask_ + 1]) {
+    for (size_type i = 0; i <= mask_; i++)
+      shards_[i].map = shard_map(comp, alloc);
+  };
+
+  // initializer list constructor
+  concurrent_map(std::initializer_list<value_type> const& items)
+      : concurrent_map() {
+    insert_batch(items.begin(), items.end());
+  };
+
+  // the locks cannot be copied or moved
+  concurrent_map(const concurrent_map&) = delete;
+  concurrent_map& operator=(const concurrent_map&) = delete;
+
+  // destructor
+  ~concurrent_map() = default;
+
+  // returns the number of shards
+  size_type shard_count() const noexcept { return mask_ + 1; };
+
+  // checks whether the container is empty
+  bool empty() const { return size() == 0; };
+
+  // returns the number of elements. shards are counted one by one, so while
+  // other threads update the map the result is approximate
+  size_type size() const {
+    size_type total = 0;
+    for (size_type i = 0; i <= mask_; i++) {
+      shared_lock lock(shards_[i].mutex);
+      total += shards_[i].map.size();
+    }
+    return total;
+  };
+
+  // same for all the shards at one moment
+  size_type size(consistent_t) const {
+    size_type total = 0;
+    for_each_shard([&total](const shard_map& m) { total += m.size(); });
+    return total;
+  };
+
+  // clears the contents
+  void clear() {
+    for (size_type i = 0; i <= mask_; i++) {
+      unique_lock lock(shards_[i].mutex);
+      shards_[i].map.clear();
+    }
+  };
+
+  // inserts value if there is no element with its key. returns whether it
+  // was inserted
+  bool insert(const value_type& value) {
+    Shard& shard = shard_of(value.first);
+    unique_lock lock(shard.mutex);
+    return shard.map.insert(value).second;
+  };
+
+  // inserts value with key and obj if there is no element with key
+  bool insert(const Key& key, const T& obj) {
+    return try_emplace(key, obj);
+  };
+
+  // inserts an element or assigns to the current element if the key
+  // already exists. returns whether it was inserted
+  template <typename M>
+  bool insert_or_assign(const Key& key, M&& obj) {
+    Shard& shard = shard_of(key);
+    unique_lock lock(shard.mutex);
+    return shard.map.insert_or_assign(key, std::forward<M>(obj)).second;
+  };
+
+  // inserts an element with key and mapped value constructed from args if
+  // there is no element with key. returns whether it was inserted
+  template <typename... Args>
+  bool try_emplace(const Key& key, Args&&... args) {
+    Shard& shard = shard_of(key);
+    unique_lock lock(shard.mutex);
+    return shard.map.try_emplace(key, std::forward<Args>(args)...).second;
+  };
+
+  // erases the element with key. returns the number of erased elements
+  size_type erase(const Key& key) {
+    Shard& shard = shard_of(key);
+    unique_lock lock(shard.mutex);
+    return shard.map.erase(key);
+  };
+
+  // checks if there is an element with key equivalent to key in the container
+  bool contains(const Key& key) const {
+    const Shard& shard = shard_of(key);
+    shared_lock lock(shard.mutex);
+    return shard.map.contains(key);
+  };
+
+  // returns the number of elements with a specific key
+  size_type count(const Key& key) const { return contains(key) ? 1 : 0; };
+
+  // returns a copy of the mapped value of key, nothing if there is no key
+  std::optional<T> get(const Key& key) const {
+    const Shard& shard = shard_of(key);
+    shared_lock lock(shard.mutex);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end()) return std::nullopt;
+    return (*it).second;
+  };
+
+  // returns a copy of the mapped value of key with bounds checking
+  T at(const Key& key) const {
+    std::optional<T> value = get(key);
+    if (!value) throw std::out_of_range("concurrent_map::at");
+    return std::move(*value);
+  };
+
+  // calls func(value_type&) on the element with key under the write lock of
+  // its shard. returns whether there was such an element
+  template <typename Func>
+  bool visit(const Key& key, Func&& func) {
+    Shard& shard = shard_of(key);
+    unique_lock lock(shard.mutex);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end()) return false;
+    func(*it);
+    return true;
+  };
+
+  // calls func(const value_type&) on the element with key under the read
+  // lock of its shard. returns whether there was such an element
+  template <typename Func>
+  bool cvisit(const Key& key, Func&& func) const {
+    const Shard& shard = shard_of(key);
+    shared_lock lock(shard.mutex);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end()) return false;
+    func(*it);
+    return true;
+  };
+
+  // calls func(const value_type&) on every element, locking the shards one
+  // by one
+  template <typename Func>
+  void for_each(Func&& func) const {
+    for (size_type i = 0; i <= mask_; i++) {
+      shared_lock lock(shards_[i].mutex);
+      for (const value_type& value : shards_[i].map) func(value);
+    }
+  };
+
+  // same with all the shards locked at once, so func sees the elements the
+  // map had at one moment
+  template <typename Func>
+  void for_each(consistent_t, Func&& func) const {
+    for_each_shard([&func](const shard_map& m) {
+      for (const value_type& value : m) func(value);
+    });
+  };
+
+  // returns a sorted copy of the elements the map had at one moment
+  shard_map to_map() const {
+    shard_map result(shards_[0].map.key_comp(),
+                     shards_[0].map.get_allocator());
+    for_each_shard([&result](const shard_map& m) {
+      for (const value_type& value : m) result.insert(value);
+    });
+    return result;
+  };
+
+  //      =============== BATCHES ===============
+
+  // inserts the elements of [first, last) which keys are not in the map yet.
+  // returns the number of inserted elements
+  template <typename RandomIt>
+  size_type insert_batch(RandomIt first, RandomIt last) {
+    size_type inserted = 0;
+    auto key_of = [](const auto& value) -> const Key& {
+      return value.first;
+    };
+    for_each_group(first, last, key_of, [&](Shard& shard, Group group) {
+      unique_lock lock(shard.mutex);
+      for (; group.first != group.second; ++group.first)
+        inserted += shard.map.insert(first[*group.first]).second;
+    });
+    return inserted;
+  };
+
+  // erases the elements with the keys of [first, last). returns the number
+  // of erased elements
+  template <typename RandomIt>
+  size_type erase_batch(RandomIt first, RandomIt last) {
+    size_type erased = 0;
+    for_each_group(first, last, KeyOf(), [&](Shard& shard, Group group) {
+      unique_lock lock(shard.mutex);
+      for (; group.first != group.second; ++group.first)
+        erased += shard.map.erase(first[*group.first]);
+    });
+    return erased;
+  };
+
+  // writes a copy of the mapped value of every key of [first, last) to out,
+  // nothing for the missing keys, as std::optional<T>. the keys of a shard
+  // are searched together by find_batch of s21::map
+  template <typename RandomIt, typename OutputIt>
+  OutputIt find_batch(RandomIt first, RandomIt last, OutputIt out) const {
+    std::vector<std::optional<T>> values(std::distance(first, last));
+    std::vector<Key> keys;
+    std::vector<typename shard_map::const_iterator> found;
+    for_each_group(first, last, KeyOf(), [&](const Shard& shard, Group group) {
+      gather(first, group, keys);
+      found.resize(keys.size());
+      shared_lock lock(shard.mutex);
+      shard.map.find_batch(keys.begin(), keys.end(), found.begin());
+      for (size_type i = 0; i < keys.size(); i++)
+        if (found[i] != shard.map.end())
+          values[group.first[i]] = (*found[i]).second;
+    });
+    return std::move(values.begin(), values.end(), out);
+  };
+
+  // writes whether the map contains every key of [first, last) to out
+  template <typename RandomIt, typename OutputIt>
+  OutputIt contains_batch(RandomIt first, RandomIt last, OutputIt out) const {
+    std::vector<unsigned char> present(std::distance(first, last));
+    std::vector<Key> keys;
+    std::vector<unsigned char> found;
+    for_each_group(first, last, KeyOf(), [&](const Shard& shard, Group group) {
+      gather(first, group, keys);
+      found.resize(keys.size());
+      shared_lock lock(shard.mutex);
+      shard.map.contains_batch(keys.begin(), keys.end(), found.begin());
+      for (size_type i = 0; i < keys.size(); i++)
+        present[group.first[i]] = found[i];
+    });
+    for (unsigned char flag : present) *out++ = flag != 0;
+    return out;
+  };
+
+ private:
+  // positions of the batch elements which belong to one shard
+  using Group = std::pair<const size_type*, const size_type*>;
+
+  // batches of keys are their own keys
+  struct KeyOf {
+    const Key& operator()(const Key& key) const noexcept { return key; };
+  };
+
+  // returns mask selecting a shard of at least shards ones
+  static size_type shard_mask(size_type shards) noexcept {
+    size_type count = 1;
+    while (count < shards) count <<= 1;
+    return count - 1;
+  };
+
+  // returns index of the shard of key. the hash is mixed by a multiplication,
+  // since hashes of numbers are the numbers themselves
+  size_type index_of(const Key& key) const {
+    std::uint64_t mixed =
+        static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_type>(mixed >> 32) & mask_;
+  };
+
+  // returns shard of key
+  Shard& shard_of(const Key& key) { return shards_[index_of(key)]; };
+
+  // same for const map
+  const Shard& shard_of(const Key& key) const {
+    return shards_[index_of(key)];
+  };
+
+  // copies the keys of group to keys
+  template <typename RandomIt>
+  static void gather(RandomIt first, Group group, std::vector<Key>& keys) {
+    keys.clear();
+    for (; group.first != group.second; ++group.first)
+      keys.push_back(first[*group.first]);
+  };
+
+  // calls func(const shard_map&) on every shard with all the shards locked.
+  // the locks are taken in one order, so two such calls cannot deadlock
+  template <typename Func>
+  void for_each_shard(Func&& func) const {
+    std::vector<shared_lock> locks;
+    locks.reserve(mask_ + 1);
+    for (size_type i = 0; i <= mask_; i++)
+      locks.emplace_back(shards_[i].mutex);
+    for (size_type i = 0; i <= mask_; i++) func(shards_[i].map);
+  };
+
+  // groups positions of the elements of [first, last) by the shard of
+  // key_of(element) and calls func(shard, group) on every shard with some
+  template <typename RandomIt, typename KeyOfElement, typename Func>
+  void for_each_group(RandomIt first, RandomIt last, KeyOfElement key_of,
+                      Func&& func) const {
+    size_type count = std::distance(first, last);
+    std::vector<size_type> shard(count), offsets(mask_ + 2, 0), order(count);
+    for (size_type i = 0; i < count; i++) {
+      shard[i] = index_of(key_of(first[i]));
+      offsets[shard[i] + 1]++;
+    }
+    for (size_type i = 1; i < offsets.size(); i++) offsets[i] += offsets[i - 1];
+    std::vector<size_type> next(offsets.begin(), offsets.end() - 1);
+    for (size_type i = 0; i < count; i++) order[next[shard[i]]++] = i;
+    for (size_type i = 0; i <= mask_; i++)
+      if (offsets[i] != offsets[i + 1])
+        func(shards_[i], Group(order.data() + offsets[i],
+                               order.data() + offsets[i + 1]));
+  };
+
+  hasher hash_;
+  size_type mask_;                    // number of shards - 1
+  std::unique_ptr<Shard[]> shards_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_CONCURRENT_MAP_H_
@@ -2,6 +2,15 @@
 #define SRC_S21_CONTAINERSPLUS_H_
 
 #include "s21_array.h"
+#include "s21_btree_map.h"
+#include "s21_btree_multiset.h"
+#include "s21_btree_set.h"
+#include "s21_concurrent_map.h"
+#include "s21_frozen_map.h"
+#include "s21_frozen_set.h"
 #include "s21_multiset.h"
+#include "s21_persistent_map.h"
+#include "s21_unordered_map.h"
+#include "s21_unordered_set.h"
 
 #endif  // SRC_S21_CONTAINERSPLUS_H_
\ No newline at end of file
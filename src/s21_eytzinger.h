@@ -0,0 +1,462 @@
+#ifndef SRC_S21_EYTZINGER_H_
+#define SRC_S21_EYTZINGER_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "s21_tree.h"
+
+/*
+    Implementation of the Eytzinger array
+    A container which is built once and then only searched does not need
+   nodes and links at all. The Eytzinger array keeps its sorted values in one
+   contiguous array laid out like a complete binary search tree stored level
+   by level (as a binary heap is):
+
+    1. The root is at index 1, the children of index k are at 2k and 2k + 1,
+   index 0 is not used. The values are placed so that an in-order walk of
+   this implicit tree visits them sorted.
+    2. A search goes from k to 2k + (value at k is less than key) without a
+   branch, so there are no mispredictions. When it falls out of the array,
+   the right turns made after the last left one are cancelled by a shift and
+   what remains is the index of the lower bound (0 if there is none).
+    3. The descendants of k four levels down (for 4-byte values) are 16
+   consecutive values, one cache line. The array is aligned to cache lines,
+   so a search prefetches the line it will need a few steps ahead while it
+   compares.
+
+    The top levels of the tree share a few cache lines which stay cached, so
+   a lookup costs far fewer misses than in a red-black tree with the same
+   number of levels. In-order iteration walks the implicit tree: ++ and --
+   take O(1) amortized. The values are never changed, so all iterators are
+   constant and stay valid until the array is destroyed or assigned.
+*/
+
+namespace s21 {
+// Key is the stored value type, KeyOfValue extracts the part of it the
+// array is ordered and searched by, Compare orders the keys, Allocator
+// provides memory for the values
+template <typename Key, typename KeyOfValue = IdentityKey<Key>,
+          typename Compare = std::less<typename KeyOfValue::key_type>,
+          typename Allocator = std::allocator<Key>>
+class EytzingerArray : private CompareHolder<Compare> {
+  using compare_holder = CompareHolder<Compare>;
+  using compare_holder::comp;
+  class EytzingerIterator;
+  using value_traits = std::allocator_traits<Allocator>;
+  using size_type = std::size_t;
+
+  // size of a cache line the array is aligned to
+  static constexpr size_type kLineSize = 64;
+  // a search prefetches the descendants of the current index this many
+  // times further in the array: the first value of a line some levels down
+  static constexpr size_type kPrefetchStride =
+      std::max<size_type>(1, kLineSize / sizeof(Key));
+
+ public:
+  using const_iterator = EytzingerIterator;
+  using value_type = Key;
+  using key_type = typename KeyOfValue::key_type;
+  using key_compare = Compare;
+
+  // creates empty array
+  explicit EytzingerArray(const Compare& comp = Compare(),
+                          const Allocator& alloc = Allocator())
+      : compare_holder(comp),
+        memory_(nullptr),
+        values_(nullptr),
+        capacity_(0),
+        size_(0),
+        alloc_(alloc){};
+
+  // copy constructor
+  EytzingerArray(const EytzingerArray& other)
+      : EytzingerArray(other.comp(),
+                       value_traits::select_on_container_copy_construction(
+                           other.alloc_)) {
+    assign_sorted(other.begin(), other.end(), other.size_);
+  };
+
+  // move constructor
+  EytzingerArray(EytzingerArray&& other) noexcept
+      : EytzingerArray(other.comp(), other.alloc_) {
+    swap_contents(other);
+  };
+
+  // destructor
+  ~EytzingerArray() { clear(); };
+
+  // copy assignment. the copy is made first, so on failure this array is
+  // left as it was. the memory comes from the allocator of this array
+  // unless the allocator of other is copied along
+  EytzingerArray& operator=(const EytzingerArray& other) {
+    if (this != &other) {
+      constexpr bool propagate =
+          value_traits::propagate_on_container_copy_assignment::value;
+      EytzingerArray copy(other.comp(), propagate ? other.alloc_ : alloc_);
+      copy.assign_sorted(other.begin(), other.end(), other.size_);
+      clear();
+      if constexpr (propagate) alloc_ = other.alloc_;
+      swap_contents(copy);
+    }
+    return *this;
+  };
+
+  // move assignment. the array is taken over if the allocator is moved
+  // along or the allocators are equal, otherwise the values are copied
+  EytzingerArray& operator=(EytzingerArray&& other) {
+    if (this != &other) {
+      clear();
+      static_cast<compare_holder&>(*this) = other;
+      if constexpr (value_traits::propagate_on_container_move_assignment::
+                        value)
+        alloc_ = std::move(other.alloc_);
+      if (alloc_ == other.alloc_) {
+        swap_contents(other);
+      } else {
+        assign_sorted(other.begin(), other.end(), other.size_);
+        other.clear();
+      }
+    }
+    return *this;
+  };
+
+  // returns iterator to the smallest element
+  const_iterator begin() const noexcept {
+    return const_iterator(values_, size_, leftmost(1));
+  };
+
+  // returns iterator after the greatest element
+  const_iterator end() const noexcept {
+    return const_iterator(values_, size_, 0);
+  };
+
+  // checks whether the array is empty
+  bool empty() const noexcept { return size_ == 0; };
+
+  // returns number of elements
+  size_type size() const noexcept { return size_; };
+
+  // returns max possible number of elements
+  size_type max_size() const noexcept {
+    return std::min<size_type>(value_traits::max_size(alloc_),
+                               std::numeric_limits<size_type>::max() / 2) -
+           1 - kLineSize;
+  };
+
+  // destroys all the elements and frees the array
+  void clear() noexcept {
+    if (memory_ == nullptr) return;
+    for (size_type k = 1; k <= size_; k++)
+      value_traits::destroy(alloc_, values_ + k);
+    value_traits::deallocate(alloc_, memory_, capacity_);
+    memory_ = values_ = nullptr;
+    capacity_ = size_ = 0;
+  };
+
+  // replaces contents with count elements of [first, last), which is sorted
+  // by comp and has no equivalent elements. the values are taken in order
+  // by an in-order walk of the implicit tree, so one pass is enough
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last, size_type count) {
+    clear();
+    if (count == 0) return;
+    allocate(count);
+    size_type k = leftmost(1);
+    size_type built = 0;
+    try {
+      for (; built < count && first != last; ++first, built++) {
+        value_traits::construct(alloc_, values_ + k, *first);
+        k = next(k, size_);
+      }
+    } catch (...) {
+      size_ = 0;
+      for (k = leftmost(1); built > 0; built--, k = next(k, count))
+        value_traits::destroy(alloc_, values_ + k);
+      value_traits::deallocate(alloc_, memory_, capacity_);
+      memory_ = values_ = nullptr;
+      capacity_ = 0;
+      throw;
+    }
+  };
+
+  // same for [first, last) in any order. only the first of equivalent
+  // elements is kept
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last) {
+    std::vector<value_type> items(first, last);
+    std::vector<const value_type*> order;
+    order.reserve(items.size());
+    for (const value_type& item : items) order.push_back(&item);
+    auto less = [this](const value_type* lhs, const value_type* rhs) {
+      return comp()(KeyOfValue()(*lhs), KeyOfValue()(*rhs));
+    };
+    std::stable_sort(order.begin(), order.end(), less);
+    auto equal = [&less](const value_type* lhs, const value_type* rhs) {
+      return !less(lhs, rhs);
+    };
+    order.erase(std::unique(order.begin(), order.end(), equal), order.end());
+    auto deref = [](const value_type* item) -> const value_type& {
+      return *item;
+    };
+    assign_sorted(make_transform(order.begin(), deref),
+                  make_transform(order.end(), deref), order.size());
+  };
+
+  // swaps the contents
+  void swap(EytzingerArray& other) noexcept {
+    if constexpr (value_traits::propagate_on_container_swap::value)
+      std::swap(alloc_, other.alloc_);
+    swap_contents(other);
+  };
+
+  // returns iterator to the element with key, end() if there is none
+  template <typename K>
+  const_iterator find(const K& key) const noexcept {
+    size_type k = lower_bound_index(key);
+    if (k != 0 && comp()(key, key_of(values_[k]))) k = 0;
+    return const_iterator(values_, size_, k);
+  };
+
+  // checks if there is an element with key
+  template <typename K>
+  bool contains(const K& key) const noexcept {
+    size_type k = lower_bound_index(key);
+    return k != 0 && !comp()(key, key_of(values_[k]));
+  };
+
+  // returns number of elements with key, 0 or 1
+  template <typename K>
+  size_type count(const K& key) const noexcept {
+    return contains(key) ? 1 : 0;
+  };
+
+  // returns iterator to the first element not less than key
+  template <typename K>
+  const_iterator lower_bound(const K& key) const noexcept {
+    return const_iterator(values_, size_, lower_bound_index(key));
+  };
+
+  // returns iterator to the first element greater than key
+  template <typename K>
+  const_iterator upper_bound(const K& key) const noexcept {
+    size_type k = 1;
+    while (k <= size_) {
+      prefetch(k);
+      k = 2 * k + !comp()(key, key_of(values_[k]));
+    }
+    return const_iterator(values_, size_, cancel_right_turns(k));
+  };
+
+  // returns range of elements with key
+  template <typename K>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const K& key) const noexcept {
+    const_iterator first = lower_bound(key), last = first;
+    if (first != end() && !comp()(key, key_of(*first))) ++last;
+    return {first, last};
+  };
+
+  // returns function object which compares keys
+  key_compare key_comp() const { return comp(); };
+
+  // returns allocator of the values
+  Allocator get_allocator() const noexcept { return alloc_; };
+
+ private:
+  // returns key of value
+  static const key_type& key_of(const value_type& value) noexcept {
+    return KeyOfValue()(value);
+  };
+
+  // returns index of the first element not less than key, 0 if there is
+  // none. the descent has no branches, so every search takes as many steps
+  // as the tree has levels
+  template <typename K>
+  size_type lower_bound_index(const K& key) const noexcept {
+    size_type k = 1;
+    while (k <= size_) {
+      prefetch(k);
+      k = 2 * k + comp()(key_of(values_[k]), key);
+    }
+    return cancel_right_turns(k);
+  };
+
+  // asks the processor for the line with the descendants of k a few levels
+  // down. the address may be past the array, prefetches do not fault
+  void prefetch(size_type k) const noexcept {
+#if defined(__GNUC__)
+    __builtin_prefetch(reinterpret_cast<const void*>(
+        reinterpret_cast<std::uintptr_t>(values_) +
+        k * kPrefetchStride * sizeof(value_type)));
+#else
+    (void)k;
+#endif
+  };
+
+  // returns the node the search turned left at for the last time: drops the
+  // trailing one bits of k (the right turns) and the zero bit before them
+  static size_type cancel_right_turns(size_type k) noexcept {
+#if defined(__GNUC__)
+    return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+#else
+    while (k & 1) k >>= 1;
+    return k >> 1;
+#endif
+  };
+
+  // returns the leftmost index in subtree of k, 0 for an empty tree
+  size_type leftmost(size_type k) const noexcept {
+    if (k > size_) return 0;
+    while (2 * k <= size_) k *= 2;
+    return k;
+  };
+
+  // returns in-order successor of k in a tree of size elements, 0 after the
+  // last one
+  static size_type next(size_type k, size_type size) noexcept {
+    if (2 * k + 1 <= size) {
+      k = 2 * k + 1;
+      while (2 * k <= size) k *= 2;
+      return k;
+    }
+    while (k & 1) k >>= 1;
+    return k >> 1;
+  };
+
+  // returns in-order predecessor of k, the last element for 0
+  static size_type prev(size_type k, size_type size) noexcept {
+    if (k == 0) {
+      if (size == 0) return 0;
+      k = 1;
+      while (2 * k + 1 <= size) k = 2 * k + 1;
+      return k;
+    }
+    if (2 * k <= size) {
+      k = 2 * k;
+      while (2 * k + 1 <= size) k = 2 * k + 1;
+      return k;
+    }
+    while (k > 1 && !(k & 1)) k >>= 1;
+    return k >> 1;
+  };
+
+  // allocates array for count elements. memory for a cache line more is
+  // taken, so that the array can start where a line does when lines hold a
+  // whole number of values
+  void allocate(size_type count) {
+    size_type extra = kLineSize / sizeof(value_type) + 1;
+    capacity_ = count + 1 + extra;
+    memory_ = value_traits::allocate(alloc_, capacity_);
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(memory_);
+    size_type gap = (kLineSize - address % kLineSize) % kLineSize;
+    values_ = memory_;
+    if (gap % sizeof(value_type) == 0 && gap / sizeof(value_type) < extra)
+      values_ += gap / sizeof(value_type);
+    size_ = count;
+  };
+
+  // swaps everything but the allocators
+  void swap_contents(EytzingerArray& other) noexcept {
+    this->swap_comp(other);
+    std::swap(memory_, other.memory_);
+    std::swap(values_, other.values_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+  };
+
+  // input iterator which passes the values of It through func
+  template <typename It, typename Func>
+  class TransformIterator {
+   public:
+    TransformIterator(It it, Func func) : it_(it), func_(func){};
+    decltype(auto) operator*() const { return func_(*it_); };
+    TransformIterator& operator++() {
+      ++it_;
+      return *this;
+    };
+    bool operator!=(const TransformIterator& other) const {
+      return it_ != other.it_;
+    };
+
+   private:
+    It it_;
+    Func func_;
+  };
+
+  template <typename It, typename Func>
+  static TransformIterator<It, Func> make_transform(It it, Func func) {
+    return TransformIterator<It, Func>(it, func);
+  };
+
+  //      =============== ITERATOR CLASS ===============
+
+  // Iterator class
+  // index 0 is end(), decrementing it gives the last element
+  class EytzingerIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key*;
+    using reference = const Key&;
+
+    EytzingerIterator() : values_(nullptr), size_(0), index_(0){};
+
+    EytzingerIterator(const Key* values, size_type size, size_type index)
+        : values_(values), size_(size), index_(index){};
+
+    reference operator*() const { return values_[index_]; };
+
+    pointer operator->() const { return values_ + index_; };
+
+    EytzingerIterator& operator++() {
+      index_ = next(index_, size_);
+      return *this;
+    };
+
+    EytzingerIterator operator++(int) {
+      EytzingerIterator copy = *this;
+      ++*this;
+      return copy;
+    };
+
+    EytzingerIterator& operator--() {
+      index_ = prev(index_, size_);
+      return *this;
+    };
+
+    EytzingerIterator operator--(int) {
+      EytzingerIterator copy = *this;
+      --*this;
+      return copy;
+    };
+
+    bool operator==(const EytzingerIterator& other) const {
+      return values_ == other.values_ && index_ == other.index_;
+    };
+
+    bool operator!=(const EytzingerIterator& other) const {
+      return !(*this == other);
+    };
+
+   private:
+    const Key* values_;
+    size_type size_;
+    size_type index_;
+  };
+
+  Key* memory_;          // allocated memory
+  Key* values_;          // the array, values_[1] is the root
+  size_type capacity_;   // number of values memory_ has room for
+  size_type size_;       // number of elements
+  Allocator alloc_;      // source of the memory
+};
+}  // namespace s21
+
+#endif  // SRC_S21_EYTZINGER_H_
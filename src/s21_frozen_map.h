@@ -0,0 +1,170 @@
+#ifndef SRC_S21_FROZEN_MAP_H_
+#define SRC_S21_FROZEN_MAP_H_
+
+#include <stdexcept>
+
+#include "s21_eytzinger.h"
+#include "s21_map.h"
+
+/*
+    Implementation of frozen_map
+    frozen_map is a map which is built once and then only searched, see
+   frozen_set. Key-value pairs are kept in one Eytzinger array and neither
+   the keys nor the mapped values can be changed.
+*/
+
+namespace s21 {
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class frozen_map {
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using array = EytzingerArray<value_type, PairFirstKey<value_type>, Compare,
+                               Allocator>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+ public:
+  using iterator = typename array::const_iterator;
+  using const_iterator = typename array::const_iterator;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  // default constructor, creates an empty map
+  frozen_map() : array_(){};
+
+  // creates an empty map ordered by comp which gets its memory from alloc
+  explicit frozen_map(const Compare& comp,
+                      const Allocator& alloc = Allocator())
+      : array_(comp, alloc){};
+
+  // initializer list constructor
+  frozen_map(std::initializer_list<value_type> const& items,
+             const Compare& comp = Compare(),
+             const Allocator& alloc = Allocator())
+      : frozen_map(items.begin(), items.end(), comp, alloc){};
+
+  // range constructor, creates the map from [first, last) in any order. of
+  // equivalent keys the first one is kept
+  template <typename InputIt, typename = if_iterator<InputIt>>
+  frozen_map(InputIt first, InputIt last, const Compare& comp = Compare(),
+             const Allocator& alloc = Allocator())
+      : array_(comp, alloc) {
+    array_.assign(first, last);
+  };
+
+  // creates the map from [first, last) sorted by key without equivalent
+  // keys in O(n)
+  template <typename ForwardIt>
+  frozen_map(sorted_unique_t, ForwardIt first, ForwardIt last,
+             const Compare& comp = Compare(),
+             const Allocator& alloc = Allocator())
+      : array_(comp, alloc) {
+    array_.assign_sorted(first, last, std::distance(first, last));
+  };
+
+  // creates the map from the elements of m in O(n)
+  template <typename MapAllocator, bool Threaded>
+  explicit frozen_map(const map<Key, T, Compare, MapAllocator, Threaded>& m,
+                      const Allocator& alloc = Allocator())
+      : array_(m.key_comp(), alloc) {
+    array_.assign_sorted(m.begin(), m.end(), m.size());
+  };
+
+  // copy constructor
+  frozen_map(const frozen_map& m) : array_(m.array_){};
+
+  // move constructor
+  frozen_map(frozen_map&& m) noexcept : array_(std::move(m.array_)){};
+
+  // destructor
+  ~frozen_map() = default;
+
+  // assignment operator overload for copying an object
+  frozen_map& operator=(const frozen_map& m) {
+    array_ = m.array_;
+    return *this;
+  };
+
+  // assignment operator overload for moving an object
+  frozen_map& operator=(frozen_map&& m) {
+    array_ = std::move(m.array_);
+    return *this;
+  };
+
+  // access a specified element with bounds checking
+  const T& at(const Key& key) const {
+    const_iterator it = array_.find(key);
+    if (it == array_.end()) throw std::out_of_range("frozen_map::at");
+    return it->second;
+  };
+
+  // returns an iterator to the beginning
+  const_iterator begin() const noexcept { return array_.begin(); };
+
+  // returns an iterator to the end
+  const_iterator end() const noexcept { return array_.end(); };
+
+  // checks whether the container is empty
+  bool empty() const noexcept { return array_.empty(); };
+
+  // returns the number of elements
+  size_type size() const noexcept { return array_.size(); };
+
+  // returns the maximum possible number of elements
+  size_type max_size() const noexcept { return array_.max_size(); };
+
+  // clears the contents
+  void clear() noexcept { array_.clear(); };
+
+  // swaps the contents
+  void swap(frozen_map& other) noexcept { array_.swap(other.array_); };
+
+  // returns an s21::map with the same elements, built in O(n)
+  map<Key, T, Compare, Allocator> to_map() const {
+    return map<Key, T, Compare, Allocator>(sorted_unique, begin(), end(),
+                                           key_comp(), get_allocator());
+  };
+
+  // checks if there is an element with key equivalent to key in the container
+  bool contains(const Key& key) const { return array_.contains(key); };
+
+  // finds an element with a specific key
+  const_iterator find(const Key& key) const { return array_.find(key); };
+
+  // returns the number of elements with a specific key
+  size_type count(const Key& key) const { return array_.count(key); };
+
+  // returns an iterator to the first element not less than the given key
+  const_iterator lower_bound(const Key& key) const {
+    return array_.lower_bound(key);
+  };
+
+  // returns an iterator to the first element greater than the given key
+  const_iterator upper_bound(const Key& key) const {
+    return array_.upper_bound(key);
+  };
+
+  // returns range of elements matching a specific key
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key& key) const {
+    return array_.equal_range(key);
+  };
+
+  // returns the function object which compares the keys
+  key_compare key_comp() const { return array_.key_comp(); };
+
+  // returns the allocator associated with the container
+  allocator_type get_allocator() const noexcept {
+    return array_.get_allocator();
+  };
+
+ private:
+  array array_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_FROZEN_MAP_H_
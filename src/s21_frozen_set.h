@@ -0,0 +1,166 @@
+#ifndef SRC_S21_FROZEN_SET_H_
+#define SRC_S21_FROZEN_SET_H_
+
+#include "s21_eytzinger.h"
+#include "s21_set.h"
+
+/*
+    Implementation of frozen_set
+    frozen_set is a set of unique elements which is built once and then only
+   searched. The elements are kept in one Eytzinger array, see
+   s21_eytzinger.h: no nodes, no links, and lookups without branches that
+   miss the cache much less than in s21::set. There is no insert or erase,
+   a changed set is built anew, for example from to_set().
+*/
+
+namespace s21 {
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class frozen_set {
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using array = EytzingerArray<value_type, IdentityKey<value_type>, Compare,
+                               Allocator>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+ public:
+  // elements of a frozen set cannot be changed, so both iterators are
+  // constant
+  using iterator = typename array::const_iterator;
+  using const_iterator = typename array::const_iterator;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using allocator_type = Allocator;
+
+  // default constructor, creates an empty set
+  frozen_set() : array_(){};
+
+  // creates an empty set ordered by comp which gets its memory from alloc
+  explicit frozen_set(const Compare& comp,
+                      const Allocator& alloc = Allocator())
+      : array_(comp, alloc){};
+
+  // initializer list constructor
+  frozen_set(std::initializer_list<value_type> const& items,
+             const Compare& comp = Compare(),
+             const Allocator& alloc = Allocator())
+      : frozen_set(items.begin(), items.end(), comp, alloc){};
+
+  // range constructor, creates the set from [first, last) in any order
+  template <typename InputIt, typename = if_iterator<InputIt>>
+  frozen_set(InputIt first, InputIt last, const Compare& comp = Compare(),
+             const Allocator& alloc = Allocator())
+      : array_(comp, alloc) {
+    array_.assign(first, last);
+  };
+
+  // creates the set from [first, last) sorted by comp without equivalent
+  // elements in O(n)
+  template <typename ForwardIt>
+  frozen_set(sorted_unique_t, ForwardIt first, ForwardIt last,
+             const Compare& comp = Compare(),
+             const Allocator& alloc = Allocator())
+      : array_(comp, alloc) {
+    array_.assign_sorted(first, last, std::distance(first, last));
+  };
+
+  // creates the set from the elements of s in O(n)
+  template <typename SetAllocator, bool Threaded>
+  explicit frozen_set(const set<Key, Compare, SetAllocator, Threaded>& s,
+                      const Allocator& alloc = Allocator())
+      : array_(s.key_comp(), alloc) {
+    array_.assign_sorted(s.begin(), s.end(), s.size());
+  };
+
+  // copy constructor
+  frozen_set(const frozen_set& s) : array_(s.array_){};
+
+  // move constructor
+  frozen_set(frozen_set&& s) noexcept : array_(std::move(s.array_)){};
+
+  // destructor
+  ~frozen_set() = default;
+
+  // assignment operator overload for copying an object
+  frozen_set& operator=(const frozen_set& other) {
+    array_ = other.array_;
+    return *this;
+  };
+
+  // assignment operator overload for moving an object
+  frozen_set& operator=(frozen_set&& other) {
+    array_ = std::move(other.array_);
+    return *this;
+  };
+
+  // returns an iterator to the beginning
+  iterator begin() const noexcept { return array_.begin(); };
+
+  // returns an iterator to the end
+  iterator end() const noexcept { return array_.end(); };
+
+  // checks whether the container is empty
+  bool empty() const noexcept { return array_.empty(); };
+
+  // returns the number of elements
+  size_type size() const noexcept { return array_.size(); };
+
+  // returns the maximum possible number of elements
+  size_type max_size() const noexcept { return array_.max_size(); };
+
+  // clears the contents
+  void clear() noexcept { array_.clear(); };
+
+  // swaps the contents
+  void swap(frozen_set& other) noexcept { array_.swap(other.array_); };
+
+  // returns an s21::set with the same elements, built in O(n)
+  set<Key, Compare, Allocator> to_set() const {
+    return set<Key, Compare, Allocator>(sorted_unique, begin(), end(),
+                                        key_comp(), get_allocator());
+  };
+
+  // finds an element with a specific key
+  iterator find(const_reference key) const { return array_.find(key); };
+
+  // checks if the container contains an element with a specific key
+  bool contains(const_reference key) const { return array_.contains(key); };
+
+  // returns the number of elements with a specific key
+  size_type count(const_reference key) const { return array_.count(key); };
+
+  // returns an iterator to the first element not less than the given key
+  iterator lower_bound(const_reference key) const {
+    return array_.lower_bound(key);
+  };
+
+  // returns an iterator to the first element greater than the given key
+  iterator upper_bound(const_reference key) const {
+    return array_.upper_bound(key);
+  };
+
+  // returns range of elements matching a specific key
+  std::pair<iterator, iterator> equal_range(const_reference key) const {
+    return array_.equal_range(key);
+  };
+
+  // returns the function object which compares the keys
+  key_compare key_comp() const { return array_.key_comp(); };
+
+  // returns the function object which compares the values
+  value_compare value_comp() const { return array_.key_comp(); };
+
+  // returns the allocator associated with the container
+  allocator_type get_allocator() const noexcept {
+    return array_.get_allocator();
+  };
+
+ private:
+  array array_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_FROZEN_SET_H_
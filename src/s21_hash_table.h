@@ -0,0 +1,731 @@
+#ifndef SRC_S21_HASH_TABLE_H_
+#define SRC_S21_HASH_TABLE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "s21_tree.h"
+
+/*
+    Implementation of the hash table
+    The hash table keeps its elements in one array of slots with open
+   addressing, in the way of Swiss tables. Next to the slots there is an
+   array of control bytes, one per slot: a full slot has the low 7 bits of
+   the hash of its key there (h2), an empty or a deleted one has a negative
+   byte. The rest of the hash (h1) chooses a group of kGroupWidth slots
+   where the search starts.
+
+    A search compares h2 with all the control bytes of a group at once with
+   SIMD instructions (SSE2, or the same done in a 64-bit word elsewhere) and
+   looks at the keys only of the slots which matched, so a miss rarely
+   touches a key at all. If the group has an empty slot the search is over,
+   otherwise it goes on to the group i steps further on the i-th step, which
+   visits every group since their number is a power of two.
+
+    An erased slot becomes empty if its group still has an empty slot: no
+   search has gone past such a group. Otherwise it becomes deleted, so that
+   the searches going past it go on; deleted slots are reused by inserts and
+   dropped when the table is rehashed. The table grows twice when the full
+   and deleted slots reach max_load_factor of it, or is rehashed in place if
+   they are mostly deleted.
+
+    Elements are moved when the table is rehashed, so unlike
+   std::unordered_map, every insert which rehashes invalidates all the
+   iterators, pointers and references to the elements.
+*/
+
+namespace s21 {
+// control byte of a slot
+using ctrl_t = signed char;
+
+// control bytes of the slots which are not full. every one has the high bit
+// set, full slots have a hash value from 0 to 127 there
+constexpr ctrl_t kCtrlEmpty = -128;
+constexpr ctrl_t kCtrlDeleted = -2;
+// marks the end of the table for iterators
+constexpr ctrl_t kCtrlSentinel = -1;
+
+// control bytes of a group of slots, compared all at once. the match
+// functions return a mask with a bit for every slot which matched, slot i
+// has bit i << kShift
+class HashGroup {
+ public:
+#if defined(__SSE2__)
+  static constexpr std::size_t kWidth = 16;
+  static constexpr int kShift = 0;
+
+  explicit HashGroup(const ctrl_t* ctrl) noexcept
+      : ctrl_(_mm_load_si128(reinterpret_cast<const __m128i*>(ctrl))){};
+
+  // slots with control byte h2
+  std::uint64_t match(ctrl_t h2) const noexcept {
+    return static_cast<std::uint16_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+  };
+
+  // empty slots
+  std::uint64_t match_empty() const noexcept { return match(kCtrlEmpty); };
+
+  // empty and deleted slots
+  std::uint64_t match_free() const noexcept {
+    return static_cast<std::uint16_t>(_mm_movemask_epi8(ctrl_));
+  };
+
+ private:
+  __m128i ctrl_;
+#else
+  static constexpr std::size_t kWidth = 8;
+  static constexpr int kShift = 3;
+
+  explicit HashGroup(const ctrl_t* ctrl) noexcept {
+    std::memcpy(&ctrl_, ctrl, sizeof(ctrl_));
+  };
+
+  // slots with control byte h2. may also report a slot right after a match,
+  // which the key comparison then rejects
+  std::uint64_t match(ctrl_t h2) const noexcept {
+    std::uint64_t bytes = ctrl_ ^ (kLsbs * static_cast<unsigned char>(h2));
+    return (bytes - kLsbs) & ~bytes & kMsbs;
+  };
+
+  // empty slots: the high bit is set and the second lowest one is not
+  std::uint64_t match_empty() const noexcept {
+    return ctrl_ & ~(ctrl_ << 6) & kMsbs;
+  };
+
+  // empty and deleted slots
+  std::uint64_t match_free() const noexcept { return ctrl_ & kMsbs; };
+
+ private:
+  static constexpr std::uint64_t kLsbs = 0x0101010101010101ULL;
+  static constexpr std::uint64_t kMsbs = 0x8080808080808080ULL;
+
+  std::uint64_t ctrl_;
+#endif
+
+ public:
+  // returns the lowest slot of a non-empty mask
+  static std::size_t lowest(std::uint64_t mask) noexcept {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctzll(mask)) >> kShift;
+#else
+    std::size_t bit = 0;
+    while (!(mask & 1)) {
+      mask >>= 1;
+      bit++;
+    }
+    return bit >> kShift;
+#endif
+  };
+};
+
+// Value is the stored value type, KeyOfValue extracts the key from it, Hash
+// hashes the keys, KeyEqual compares them, Allocator provides memory for
+// the slots and the control bytes
+template <typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+class HashTable {
+  template <typename V>
+  class HashIterator;
+  using value_traits = std::allocator_traits<Allocator>;
+  using size_type = std::size_t;
+
+  // the control bytes are allocated in blocks, which keeps the groups
+  // aligned for SIMD loads
+  static constexpr size_type kBlock = 16;
+  struct alignas(kBlock) CtrlBlock {
+    ctrl_t bytes[kBlock];
+  };
+  using ctrl_allocator =
+      typename value_traits::template rebind_alloc<CtrlBlock>;
+  using ctrl_traits = std::allocator_traits<ctrl_allocator>;
+
+  static constexpr size_type kGroupWidth = HashGroup::kWidth;
+  // smallest capacity of a non-empty table
+  static constexpr size_type kMinCapacity = 16;
+
+ public:
+  using iterator = HashIterator<Value>;
+  using const_iterator = HashIterator<const Value>;
+  using value_type = Value;
+  using key_type = typename KeyOfValue::key_type;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  // load factor of a default constructed table: full and deleted slots may
+  // take up to 7/8 of it
+  static constexpr float kDefaultMaxLoad = 0.875f;
+
+  // creates empty table. it allocates nothing until the first insert
+  explicit HashTable(const Hash& hash = Hash(),
+                     const KeyEqual& equal = KeyEqual(),
+                     const Allocator& alloc = Allocator())
+      : ctrl_(empty_ctrl()),
+        slots_(nullptr),
+        capacity_(0),
+        size_(0),
+        growth_left_(0),
+        max_load_(kDefaultMaxLoad),
+        hash_(hash),
+        equal_(equal),
+        alloc_(alloc){};
+
+  // copy constructor. the copy gets a table just big enough for the
+  // elements
+  HashTable(const HashTable& other)
+      : HashTable(other.hash_, other.equal_,
+                  value_traits::select_on_container_copy_construction(
+                      other.alloc_)) {
+    max_load_ = other.max_load_;
+    copy_from(other);
+  };
+
+  // move constructor
+  HashTable(HashTable&& other) noexcept
+      : HashTable(other.hash_, other.equal_, other.alloc_) {
+    max_load_ = other.max_load_;
+    swap_contents(other);
+  };
+
+  // destructor
+  ~HashTable() { release(); };
+
+  // copy assignment. the copy is made first, so on failure this table is
+  // left as it was. the slots come from the allocator of this table unless
+  // the allocator of other is copied along
+  HashTable& operator=(const HashTable& other) {
+    if (this != &other) {
+      constexpr bool propagate =
+          value_traits::propagate_on_container_copy_assignment::value;
+      HashTable copy(other.hash_, other.equal_,
+                     propagate ? other.alloc_ : alloc_);
+      copy.max_load_ = other.max_load_;
+      copy.copy_from(other);
+      release();
+      if constexpr (propagate) alloc_ = other.alloc_;
+      hash_ = other.hash_;
+      equal_ = other.equal_;
+      max_load_ = other.max_load_;
+      swap_contents(copy);
+    }
+    return *this;
+  };
+
+  // move assignment. the table is taken over if the allocator is moved
+  // along or the allocators are equal, otherwise the elements are moved
+  // one by one
+  HashTable& operator=(HashTable&& other) {
+    if (this != &other) {
+      // the old slots go back to the allocator they came from
+      release();
+      hash_ = other.hash_;
+      equal_ = other.equal_;
+      max_load_ = other.max_load_;
+      if constexpr (value_traits::propagate_on_container_move_assignment::
+                        value)
+        alloc_ = std::move(other.alloc_);
+      if (alloc_ == other.alloc_) {
+        swap_contents(other);
+      } else {
+        move_from(other);
+        other.clear();
+      }
+    }
+    return *this;
+  };
+
+  // returns iterator to the first element
+  iterator begin() noexcept { return iterator(ctrl_, slots_).skip_free(); };
+
+  // same for const table
+  const_iterator begin() const noexcept {
+    return const_iterator(ctrl_, slots_).skip_free();
+  };
+
+  // returns iterator after the last element
+  iterator end() noexcept {
+    return iterator(ctrl_ + capacity_, slots_ + capacity_);
+  };
+
+  // same for const table
+  const_iterator end() const noexcept {
+    return const_iterator(ctrl_ + capacity_, slots_ + capacity_);
+  };
+
+  // checks whether the table is empty
+  bool empty() const noexcept { return size_ == 0; };
+
+  // returns number of elements
+  size_type size() const noexcept { return size_; };
+
+  // returns max possible number of elements
+  size_type max_size() const noexcept {
+    return std::min<size_type>(value_traits::max_size(alloc_),
+                               std::numeric_limits<size_type>::max() / 2);
+  };
+
+  // destroys the elements, keeps the memory
+  void clear() noexcept {
+    destroy_all();
+    if (capacity_ != 0) {
+      std::memset(ctrl_, kCtrlEmpty, capacity_);
+      growth_left_ = growth_limit(capacity_);
+    }
+    size_ = 0;
+  };
+
+  // returns number of slots
+  size_type bucket_count() const noexcept { return capacity_; };
+
+  // returns share of the slots taken by elements
+  float load_factor() const noexcept {
+    return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / capacity_;
+  };
+
+  // returns the share of the slots at which the table grows
+  float max_load_factor() const noexcept { return max_load_; };
+
+  // sets the share of the slots at which the table grows. it is kept
+  // between 1/8 and 7/8, since a search stops only at an empty slot, and
+  // the table is rebuilt if it is already past the new limit
+  void max_load_factor(float load) {
+    size_type deleted_slots = deleted();
+    max_load_ = std::min(std::max(load, 0.125f), kDefaultMaxLoad);
+    if (capacity_ == 0) return;
+    if (size_ + deleted_slots > growth_limit(capacity_))
+      resize(capacity_for(size_));
+    else
+      growth_left_ = growth_limit(capacity_) - size_ - deleted_slots;
+  };
+
+  // rebuilds the table with at least count slots and enough of them for
+  // the elements under max_load_factor. deleted slots are dropped
+  void rehash(size_type count) {
+    if (size_ == 0 && count == 0) {
+      deallocate();
+      return;
+    }
+    size_type capacity = capacity_for(size_);
+    while (capacity < count) capacity *= 2;
+    resize(capacity);
+  };
+
+  // makes room for count elements, so that inserting them does not rehash
+  void reserve(size_type count) {
+    if (count > size_ + growth_left_)
+      resize(std::max(capacity_for(count), capacity_));
+  };
+
+  // returns the hash function
+  hasher hash_function() const { return hash_; };
+
+  // returns the key comparison function
+  key_equal key_eq() const { return equal_; };
+
+  // returns allocator of the table
+  Allocator get_allocator() const noexcept { return alloc_; };
+
+  // swaps the contents
+  void swap(HashTable& other) noexcept {
+    using std::swap;
+    swap(hash_, other.hash_);
+    swap(equal_, other.equal_);
+    swap(max_load_, other.max_load_);
+    if constexpr (value_traits::propagate_on_container_swap::value)
+      swap(alloc_, other.alloc_);
+    swap_contents(other);
+  };
+
+  // returns iterator to the element with key, end() if there is none
+  template <typename K>
+  iterator find(const K& key) {
+    size_type index = find_index(key, hash_of(key));
+    return iterator(ctrl_ + index, slots_ + index);
+  };
+
+  // same for const table
+  template <typename K>
+  const_iterator find(const K& key) const {
+    size_type index = find_index(key, hash_of(key));
+    return const_iterator(ctrl_ + index, slots_ + index);
+  };
+
+  // checks if there is an element with key
+  template <typename K>
+  bool contains(const K& key) const {
+    return find_index(key, hash_of(key)) != capacity_;
+  };
+
+  // inserts the element constructed from args if there is no element with
+  // key, which must be the key of that element. returns iterator to the
+  // element with key and whether it was inserted
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplace_key(const K& key, Args&&... args) {
+    size_type hash = hash_of(key);
+    size_type index = find_index(key, hash);
+    if (index != capacity_)
+      return {iterator(ctrl_ + index, slots_ + index), false};
+    index = prepare_insert(hash);
+    value_traits::construct(alloc_, slots_ + index,
+                            std::forward<Args>(args)...);
+    set_full(index, hash);
+    return {iterator(ctrl_ + index, slots_ + index), true};
+  };
+
+  // inserts the element constructed from args if its key is not there yet
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    Value value(std::forward<Args>(args)...);
+    return emplace_key(key_of(value), std::move(value));
+  };
+
+  // erases the element at pos
+  void erase(const_iterator pos) noexcept {
+    erase_index(static_cast<size_type>(pos.ctrl_ - ctrl_));
+  };
+
+  // erases the element with key. returns number of erased elements
+  template <typename K>
+  size_type erase_key(const K& key) {
+    size_type index = find_index(key, hash_of(key));
+    if (index == capacity_) return 0;
+    erase_index(index);
+    return 1;
+  };
+
+  // erases all the elements pred returns true for and returns their number.
+  // erasing does not move the other elements, so one pass is enough
+  template <typename Predicate>
+  size_type erase_if(Predicate& pred) {
+    size_type erased = 0;
+    for (size_type i = 0; i < capacity_; i++) {
+      if (is_full(ctrl_[i]) && pred(static_cast<const Value&>(slots_[i]))) {
+        erase_index(i);
+        erased++;
+      }
+    }
+    return erased;
+  };
+
+ private:
+  // returns key of value
+  static const key_type& key_of(const value_type& value) noexcept {
+    return KeyOfValue()(value);
+  };
+
+  // checks if control byte belongs to a full slot
+  static bool is_full(ctrl_t ctrl) noexcept { return ctrl >= 0; };
+
+  // returns control bytes of a table without slots: a search in them stops
+  // at once and an iteration finds the end right away
+  static ctrl_t* empty_ctrl() noexcept {
+    alignas(kBlock) static ctrl_t sentinels[kBlock] = {
+        kCtrlSentinel, kCtrlSentinel, kCtrlSentinel, kCtrlSentinel,
+        kCtrlSentinel, kCtrlSentinel, kCtrlSentinel, kCtrlSentinel,
+        kCtrlSentinel, kCtrlSentinel, kCtrlSentinel, kCtrlSentinel,
+        kCtrlSentinel, kCtrlSentinel, kCtrlSentinel, kCtrlSentinel};
+    return sentinels;
+  };
+
+  // returns hash of key. the hash is mixed by a multiplication, since
+  // hashes of numbers are the numbers themselves, and h1 and h2 need
+  // different bits of it
+  template <typename K>
+  size_type hash_of(const K& key) const {
+    std::uint64_t hash =
+        static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_type>(hash ^ (hash >> 32));
+  };
+
+  // returns h2 of hash, the part kept in the control byte
+  static ctrl_t h2(size_type hash) noexcept {
+    return static_cast<ctrl_t>(hash & 0x7F);
+  };
+
+  // returns first group to look at for hash
+  size_type first_group(size_type hash) const noexcept {
+    return (hash >> 7) & (capacity_ / kGroupWidth - 1);
+  };
+
+  // returns index of the element with key, capacity_ if there is none
+  template <typename K>
+  size_type find_index(const K& key, size_type hash) const {
+    if (capacity_ == 0) return 0;
+    size_type mask = capacity_ / kGroupWidth - 1;
+    size_type group = first_group(hash);
+    for (size_type step = 1;; step++) {
+      size_type start = group * kGroupWidth;
+      HashGroup bytes(ctrl_ + start);
+      for (std::uint64_t match = bytes.match(h2(hash)); match != 0;
+           match &= match - 1) {
+        size_type index = start + HashGroup::lowest(match);
+        if (equal_(key, key_of(slots_[index]))) return index;
+      }
+      if (bytes.match_empty() != 0) return capacity_;
+      group = (group + step) & mask;
+    }
+  };
+
+  // returns index of the first empty or deleted slot on the way of hash
+  size_type find_free(size_type hash) const noexcept {
+    size_type mask = capacity_ / kGroupWidth - 1;
+    size_type group = first_group(hash);
+    for (size_type step = 1;; step++) {
+      size_type start = group * kGroupWidth;
+      std::uint64_t free = HashGroup(ctrl_ + start).match_free();
+      if (free != 0) return start + HashGroup::lowest(free);
+      group = (group + step) & mask;
+    }
+  };
+
+  // returns index of the slot the element with hash is to be put in,
+  // growing the table if there is no room
+  size_type prepare_insert(size_type hash) {
+    if (capacity_ == 0) {
+      resize(kMinCapacity);
+      return find_free(hash);
+    }
+    size_type index = find_free(hash);
+    if (growth_left_ == 0 && ctrl_[index] != kCtrlDeleted) {
+      // mostly deleted slots are dropped in place, otherwise the table grows
+      if (size_ <= growth_limit(capacity_) / 2)
+        resize(capacity_);
+      else
+        resize(capacity_ * 2);
+      index = find_free(hash);
+    }
+    return index;
+  };
+
+  // marks slot index taken by an element with hash
+  void set_full(size_type index, size_type hash) noexcept {
+    if (ctrl_[index] == kCtrlEmpty) growth_left_--;
+    ctrl_[index] = h2(hash);
+    size_++;
+  };
+
+  // destroys the element at index and frees its slot
+  void erase_index(size_type index) noexcept {
+    value_traits::destroy(alloc_, slots_ + index);
+    size_type start = index & ~(kGroupWidth - 1);
+    if (HashGroup(ctrl_ + start).match_empty() != 0) {
+      ctrl_[index] = kCtrlEmpty;
+      growth_left_++;
+    } else {
+      ctrl_[index] = kCtrlDeleted;
+    }
+    size_--;
+  };
+
+  // returns number of deleted slots
+  size_type deleted() const noexcept {
+    return growth_limit(capacity_) - size_ - growth_left_;
+  };
+
+  // returns how many slots of a table with capacity slots may be taken
+  size_type growth_limit(size_type capacity) const noexcept {
+    if (capacity == 0) return 0;
+    size_type limit = static_cast<size_type>(capacity * max_load_);
+    return std::min(limit, capacity - 1);
+  };
+
+  // returns smallest capacity which takes count elements
+  size_type capacity_for(size_type count) const noexcept {
+    size_type capacity = kMinCapacity;
+    while (growth_limit(capacity) < count) capacity *= 2;
+    return capacity;
+  };
+
+  // moves the elements to a new table with capacity slots. if an element
+  // has to be copied and the copy throws, the table is left as it was
+  void resize(size_type capacity) {
+    HashTable fresh(hash_, equal_, alloc_);
+    fresh.max_load_ = max_load_;
+    fresh.allocate(capacity);
+    for (size_type i = 0; i < capacity_; i++) {
+      if (!is_full(ctrl_[i])) continue;
+      size_type hash = hash_of(key_of(slots_[i]));
+      size_type index = fresh.find_free(hash);
+      value_traits::construct(fresh.alloc_, fresh.slots_ + index,
+                              std::move_if_noexcept(slots_[i]));
+      fresh.set_full(index, hash);
+    }
+    swap_contents(fresh);
+  };
+
+  // fills empty table with copies of the elements of other
+  void copy_from(const HashTable& other) {
+    if (other.size_ == 0) return;
+    allocate(capacity_for(other.size_));
+    for (const Value& value : other) {
+      size_type hash = hash_of(key_of(value));
+      size_type index = find_free(hash);
+      value_traits::construct(alloc_, slots_ + index, value);
+      set_full(index, hash);
+    }
+  };
+
+  // fills empty table with the elements of other moved one by one
+  void move_from(HashTable& other) {
+    if (other.size_ == 0) return;
+    allocate(capacity_for(other.size_));
+    for (Value& value : other) {
+      size_type hash = hash_of(key_of(value));
+      size_type index = find_free(hash);
+      value_traits::construct(alloc_, slots_ + index, std::move(value));
+      set_full(index, hash);
+    }
+  };
+
+  // destroys the elements and frees the slots
+  void release() noexcept {
+    destroy_all();
+    deallocate();
+    size_ = 0;
+  };
+
+  // allocates capacity empty slots for empty table without slots
+  void allocate(size_type capacity) {
+    ctrl_allocator ctrl_alloc(alloc_);
+    CtrlBlock* blocks =
+        ctrl_traits::allocate(ctrl_alloc, capacity / kBlock + 1);
+    try {
+      slots_ = value_traits::allocate(alloc_, capacity);
+    } catch (...) {
+      ctrl_traits::deallocate(ctrl_alloc, blocks, capacity / kBlock + 1);
+      throw;
+    }
+    ctrl_ = blocks->bytes;
+    std::memset(ctrl_, kCtrlEmpty, capacity);
+    std::memset(ctrl_ + capacity, kCtrlSentinel, kBlock);
+    capacity_ = capacity;
+    growth_left_ = growth_limit(capacity);
+  };
+
+  // frees the slots of table without elements
+  void deallocate() noexcept {
+    if (capacity_ != 0) {
+      ctrl_allocator ctrl_alloc(alloc_);
+      ctrl_traits::deallocate(ctrl_alloc,
+                              reinterpret_cast<CtrlBlock*>(ctrl_),
+                              capacity_ / kBlock + 1);
+      value_traits::deallocate(alloc_, slots_, capacity_);
+    }
+    ctrl_ = empty_ctrl();
+    slots_ = nullptr;
+    capacity_ = 0;
+    growth_left_ = 0;
+  };
+
+  // destroys all the elements, leaves the control bytes as they are
+  void destroy_all() noexcept {
+    if constexpr (!std::is_trivially_destructible<Value>::value) {
+      for (size_type i = 0; i < capacity_; i++)
+        if (is_full(ctrl_[i])) value_traits::destroy(alloc_, slots_ + i);
+    }
+  };
+
+  // swaps the slots with other table, keeps hash, comparison and load
+  // factor
+  void swap_contents(HashTable& other) noexcept {
+    using std::swap;
+    swap(ctrl_, other.ctrl_);
+    swap(slots_, other.slots_);
+    swap(capacity_, other.capacity_);
+    swap(size_, other.size_);
+    swap(growth_left_, other.growth_left_);
+  };
+
+  //      =============== ITERATOR CLASS ===============
+
+  // Iterator class
+  // points to a slot and its control byte. an iteration skips the free
+  // slots and stops at the sentinel after the last slot
+  template <typename V>
+  class HashIterator {
+    friend HashTable;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = V*;
+    using reference = V&;
+
+    HashIterator() : ctrl_(nullptr), slot_(nullptr){};
+
+    // iterator converts to const_iterator
+    template <typename W, typename = std::enable_if_t<
+                              std::is_same<const W, V>::value &&
+                              !std::is_same<W, V>::value>>
+    HashIterator(const HashIterator<W>& other)
+        : ctrl_(other.ctrl_), slot_(other.slot_){};
+
+    reference operator*() const noexcept { return *slot_; };
+
+    pointer operator->() const noexcept { return slot_; };
+
+    HashIterator& operator++() noexcept {
+      ++ctrl_;
+      ++slot_;
+      return skip_free();
+    };
+
+    HashIterator operator++(int) noexcept {
+      HashIterator copy = *this;
+      ++*this;
+      return copy;
+    };
+
+    friend bool operator==(const HashIterator& lhs,
+                           const HashIterator& rhs) noexcept {
+      return lhs.ctrl_ == rhs.ctrl_;
+    };
+
+    friend bool operator!=(const HashIterator& lhs,
+                           const HashIterator& rhs) noexcept {
+      return lhs.ctrl_ != rhs.ctrl_;
+    };
+
+   private:
+    template <typename>
+    friend class HashIterator;
+
+    HashIterator(const ctrl_t* ctrl, Value* slot) : ctrl_(ctrl), slot_(slot){};
+
+    // moves forward to a full slot or the sentinel
+    HashIterator& skip_free() noexcept {
+      while (*ctrl_ < kCtrlSentinel) {
+        ++ctrl_;
+        ++slot_;
+      }
+      return *this;
+    };
+
+    const ctrl_t* ctrl_;
+    V* slot_;
+  };
+
+  ctrl_t* ctrl_;              // control bytes, followed by a sentinel block
+  Value* slots_;              // elements
+  size_type capacity_;        // number of slots: 0 or a power of two
+  size_type size_;            // number of elements
+  size_type growth_left_;     // empty slots which may be taken before growth
+  float max_load_;            // share of full and deleted slots to grow at
+  hasher hash_;
+  key_equal equal_;
+  Allocator alloc_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_HASH_TABLE_H_
@@ -4,13 +4,18 @@
 #include <initializer_list>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <memory_resource>
 
 namespace s21 {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class list {
   class ListNode;
   class ListIterator;
   class ListConstIterator;
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<ListNode>;
+  using node_traits = std::allocator_traits<node_allocator>;
 
   // ------------------------------ PUBLIC ------------------------------
  public:
@@ -27,16 +32,22 @@ class list {
                           // constant type for iterating through the container
   using size_type = std::size_t;  // Size_t defines the type of the container
                                   // size (standard type is size_t)
+  using allocator_type = Allocator;  // Allocator defines the type used to get
+                                     // memory for the nodes
 
   // List Functions
   // Default constructor, creates empty list
-  list() {
+  list() : list(Allocator()) {}
+
+  // Creates empty list which gets its memory from alloc
+  explicit list(const Allocator& alloc) : alloc_(alloc) {
     size_ = 0;
-    head_ = new ListNode;
+    head_ = create_node();
   }
 
   // Parameterized constructor, creates the list of size n
-  explicit list(size_type n) : list() {
+  explicit list(size_type n, const Allocator& alloc = Allocator())
+      : list(alloc) {
     while (n > 0) {
       push_front(value_type{});
       n--;
@@ -45,25 +56,50 @@ class list {
 
   // Initializer list constructor, creates list initizialized using
   // std::initializer_list
-  list(std::initializer_list<value_type> const& items) : list() {
+  list(std::initializer_list<value_type> const& items,
+       const Allocator& alloc = Allocator())
+      : list(alloc) {
     for (auto& elem : items) push_back(elem);
   }
 
   // Copy constructor
-  list(const list& other) : list() { *this = other; }
+  list(const list& other)
+      : list(node_traits::select_on_container_copy_construction(other.alloc_)) {
+    *this = other;
+  }
+
+  // Copy constructor which gets memory from alloc
+  list(const list& other, const Allocator& alloc) : list(alloc) {
+    *this = other;
+  }
 
   // Move constructor
-  list(list&& other) : list() { *this = std::move(other); }
+  list(list&& other) : list(other.alloc_) { *this = std::move(other); }
+
+  // Move constructor which gets memory from alloc
+  list(list&& other, const Allocator& alloc) : list(alloc) {
+    move_from(other);
+  }
 
   // Destructor
   ~list() {
     clear();
-    delete head_;
+    delete_node(head_);
   }
 
   // Assignment operator overload for coping object
   list& operator=(const list& other) {
     if (this != &other) {
+      if constexpr (node_traits::propagate_on_container_copy_assignment::
+                        value) {
+        if (alloc_ != other.alloc_) {
+          // nodes of the old allocator cannot be reused
+          clear();
+          delete_node(head_);
+          alloc_ = other.alloc_;
+          head_ = create_node();
+        }
+      }
       size_type count = other.size_ < size_ ? other.size_ : size_;
       iterator iter = begin();
       const_iterator iter_other = other.begin();
@@ -82,14 +118,26 @@ class list {
   }
 
   // Assignment operator overload for moving object
-  list& operator=(list&& other) noexcept {
+  // nodes are taken over if the allocator is moved along or the allocators
+  // are equal, otherwise the values are moved one by one
+  list& operator=(list&& other) {
     if (this != &other) {
       clear();
-      swap(other);
+      if constexpr (node_traits::propagate_on_container_move_assignment::
+                        value) {
+        std::swap(alloc_, other.alloc_);
+        std::swap(size_, other.size_);
+        std::swap(head_, other.head_);
+      } else {
+        move_from(other);
+      }
     }
     return *this;
   }
 
+  // Returns the allocator associated with the container
+  allocator_type get_allocator() const noexcept { return alloc_; }
+
   // List Element access
   // Access the first element
   reference front() noexcept { return *begin(); }
@@ -137,15 +185,12 @@ class list {
   // Inserts element into concrete pos and returns the iterator that points to
   // the new element
   iterator insert(iterator pos, const_reference value) {
-    ListNode* new_Node = new ListNode;
-    new_Node->data_ = value;
-    new_Node->next_ = pos.currentNode_;
-    new_Node->prev_ = pos.currentNode_->prev_;
+    return link_node(pos, create_node(value));
+  }
 
-    pos.currentNode_->prev_->next_ = new_Node;
-    pos.currentNode_->prev_ = new_Node;
-    size_++;
-    return iterator(new_Node);
+  // Same for value which is moved into the new element
+  iterator insert(iterator pos, value_type&& value) {
+    return link_node(pos, create_node(std::move(value)));
   }
 
   // Erases element at pos
@@ -154,7 +199,7 @@ class list {
       pos.currentNode_->prev_->next_ = pos.currentNode_->next_;
       pos.currentNode_->next_->prev_ = pos.currentNode_->prev_;
 
-      delete pos.currentNode_;
+      delete_node(pos.currentNode_);
       size_--;
     }
   }
@@ -162,9 +207,15 @@ class list {
   // Adds an element to the end
   void push_back(const_reference value) { insert(end(), value); }
 
+  // Same for value which is moved into the new element
+  void push_back(value_type&& value) { insert(end(), std::move(value)); }
+
   // Adds an element to the head
   void push_front(const_reference value) { insert(begin(), value); }
 
+  // Same for value which is moved into the new element
+  void push_front(value_type&& value) { insert(begin(), std::move(value)); }
+
   // Removes the last element
   void pop_back() { erase(--end()); }
 
@@ -174,6 +225,8 @@ class list {
   // Swaps the contents
   void swap(list& other) {
     if (this != &other) {
+      if constexpr (node_traits::propagate_on_container_swap::value)
+        std::swap(alloc_, other.alloc_);
       std::swap(size_, other.size_);
       std::swap(head_, other.head_);
     }
@@ -278,19 +331,68 @@ class list {
  private:
   // ------------------------- Node -------------------------
   // Node for list
+  // the value is constructed and destroyed by the list through its allocator
   class ListNode {
    public:
-    // Default constructor, creates empty node
+    // Default constructor, creates node linked to itself
     ListNode() {
-      data_ = value_type{};
       next_ = this;
       prev_ = this;
     }
-    value_type data_;
+    ~ListNode() {}
+    union {
+      value_type data_;
+    };
     ListNode* next_;
     ListNode* prev_;
   };
 
+  // Takes nodes of other if they come from the same allocator, otherwise
+  // moves the values one by one into empty list
+  void move_from(list& other) {
+    if (alloc_ == other.alloc_) {
+      std::swap(size_, other.size_);
+      std::swap(head_, other.head_);
+    } else {
+      for (auto& elem : other) push_back(std::move(elem));
+      other.clear();
+    }
+  }
+
+  // ----------------------- Allocation -----------------------
+  // Allocates node and constructs its value from args
+  template <typename... Args>
+  ListNode* create_node(Args&&... args) {
+    ListNode* node = node_traits::allocate(alloc_, 1);
+    ::new (static_cast<void*>(node)) ListNode;
+    try {
+      node_traits::construct(alloc_, std::addressof(node->data_),
+                             std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(alloc_, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  // Destroys node and its value and frees the memory
+  void delete_node(ListNode* node) noexcept {
+    node_traits::destroy(alloc_, std::addressof(node->data_));
+    node->~ListNode();
+    node_traits::deallocate(alloc_, node, 1);
+  }
+
+  // Links node into the list before pos
+  iterator link_node(iterator pos, ListNode* node) noexcept {
+    node->next_ = pos.currentNode_;
+    node->prev_ = pos.currentNode_->prev_;
+
+    pos.currentNode_->prev_->next_ = node;
+    pos.currentNode_->prev_ = node;
+    size_++;
+    return iterator(node);
+  }
+
   // ----------------------- Iterator -----------------------
   // Internal class ListIterator<T> defines the type for iterating through the
   // containe
@@ -452,10 +554,16 @@ class list {
     }
   }
 
-  ListNode* head_;  // Service node
-  size_type size_;  // Amount of elements
+  ListNode* head_;        // Service node
+  size_type size_;        // Amount of elements
+  node_allocator alloc_;  // Allocator of the nodes
 
 };  // list
+
+namespace pmr {
+template <typename T>
+using list = s21::list<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // SRC_S21_LIST_H
@@ -1,6 +1,9 @@
 #ifndef SRC_S21_MAP_H_
 #define SRC_S21_MAP_H_
 
+#include <tuple>
+#include <utility>
+
 #include "s21_tree.h"
 
 /*
@@ -15,26 +18,88 @@
 */
 
 namespace s21 {
-template <typename Key, typename T>
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>,
+          bool Threaded = false>
 class map {
   using key_type = Key;
   using mapped_type = T;
   using value_type = std::pair<const key_type, mapped_type>;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using tree = RBTree<value_type>;
+  using tree = RBTree<value_type, PairFirstKey<value_type>, Compare,
+                      Allocator, Threaded>;
   using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
 
  public:
   using iterator = typename tree::iterator;
   using const_iterator = typename tree::const_iterator;
+  using node_type = typename tree::node_type;
+  using insert_return_type = NodeInsertReturn<iterator, node_type>;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  // compares the elements by their keys
+  class value_compare {
+    friend map;
+
+   public:
+    bool operator()(const value_type& lhs, const value_type& rhs) const {
+      return comp_(lhs.first, rhs.first);
+    };
+
+   protected:
+    value_compare(Compare comp) : comp_(comp){};
+    Compare comp_;
+  };
 
   // default constructor, creates an empty map
   map() : tree_(){};
 
+  // creates an empty map ordered by comp which gets its memory from alloc
+  explicit map(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_(comp, alloc){};
+
+  // creates an empty map which gets its memory from alloc
+  explicit map(const Allocator& alloc) : tree_(alloc){};
+
+  // initializer list constructor with allocator
+  map(std::initializer_list<value_type> const& items, const Allocator& alloc)
+      : map(items, Compare(), alloc){};
+
+  // range constructor, creates the map from [first, last) in any order
+  template <typename InputIt, typename = if_iterator<InputIt>>
+  map(InputIt first, InputIt last, const Compare& comp = Compare(),
+      const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.assign(first, last, true);
+  };
+
+  // bulk load constructor, creates the map from [first, last) sorted by
+  // comp in O(n)
+  template <typename InputIt>
+  map(sorted_unique_t, InputIt first, InputIt last,
+      const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.assign_sorted(first, last, true);
+  };
+
+  // parallel range constructor, creates the map from random access range
+  // [first, last) in any order. the values are constructed, sorted and
+  // linked on policy.threads threads
+  template <typename RandomIt>
+  map(parallel_policy policy, RandomIt first, RandomIt last,
+      const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.assign(first, last, true, policy.threads);
+  };
+
   // initializer list constructor, creates the map initizialized using
   // std::initializer_list
-  map(std::initializer_list<value_type> const& items) {
+  map(std::initializer_list<value_type> const& items,
+      const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
     for (auto it : items) {
       tree_.insert(it);
     }
@@ -43,9 +108,16 @@ class map {
   // copy constructor
   map(const map& m) : tree_(m.tree_){};
 
+  // copy constructor which gets memory from alloc
+  map(const map& m, const Allocator& alloc) : tree_(m.tree_, alloc){};
+
   // move constructor
   map(map&& m) : tree_(std::move(m.tree_)){};
 
+  // move constructor which gets memory from alloc
+  map(map&& m, const Allocator& alloc)
+      : tree_(std::move(m.tree_), alloc){};
+
   // destructor
   ~map() = default;
 
@@ -63,30 +135,26 @@ class map {
 
   // access a specified element with bounds checking
   T& at(const Key& key) {
-    // value_type value = {key, mapped_type{}};
-    iterator it = map_find(key);
+    iterator it = tree_.find(key);
     if (it == tree_.end()) throw std::out_of_range("map::at");
     return (*it).second;
   };
 
   // access a specified element with bounds checking for const map
   const T& at(const Key& key) const {
-    // value_type value = {key, mapped_type{}};
-    const_iterator it = map_find(key);
+    const_iterator it = tree_.find(key);
     if (it == tree_.end()) throw std::out_of_range("map::at");
     return (*it).second;
   };
 
-  // access or insert specified element
-  T& operator[](const Key& key) {
-    value_type value = {key, mapped_type{}};
-    iterator it = map_find(key);
-    if (it == tree_.end()) {
-      auto res = tree_.insert(value);
-      return (*res.first).second;
-    }
-    return (*it).second;
-  }
+  // access or insert specified element. the tree is searched once and the
+  // mapped value is default constructed only if the key is missing
+  T& operator[](const Key& key) { return (*try_emplace(key).first).second; };
+
+  // same for key which is moved into the new element
+  T& operator[](Key&& key) {
+    return (*try_emplace(std::move(key)).first).second;
+  };
 
   // returns an iterator to the beginning
   iterator begin() noexcept { return tree_.begin(); };
@@ -112,47 +180,99 @@ class map {
   // clears the contents
   void clear() { tree_.clear(); };
 
+  // replaces the contents with the elements of [first, last) in any order
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last) {
+    tree_.assign(first, last, true);
+  };
+
+  // same for [first, last) sorted by key_comp(). builds a balanced tree
+  // in O(n)
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    tree_.assign_sorted(first, last, true);
+  };
+
+  // same as assign for random access range on policy.threads threads
+  template <typename RandomIt>
+  void assign(parallel_policy policy, RandomIt first, RandomIt last) {
+    tree_.assign(first, last, true, policy.threads);
+  };
+
+  // returns the function object which compares the keys
+  key_compare key_comp() const { return tree_.key_comp(); };
+
+  // returns the function object which compares the elements by keys
+  value_compare value_comp() const { return value_compare(key_comp()); };
+
+  // returns the allocator associated with the container
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
   // inserts a node and returns an iterator to where the element is in
   // the container and bool denoting whether the insertion took place
   std::pair<iterator, bool> insert(const value_type& value) {
-    iterator it = map_find(value.first);
-    if (it == end()) {
-      auto res = tree_.insert(value);
-      return res;
-    }
-    return {it, false};
+    return tree_.insert(value);
+  };
+
+  // inserts a node as close as possible to the position just before hint
+  // and returns an iterator to the element with this key. a correct hint
+  // saves the search, so sorted input is inserted in amortized O(1)
+  // comparisons
+  iterator insert(const_iterator hint, const value_type& value) {
+    return tree_.insert(hint, value).first;
+  };
+
+  // same as hinted insert for the element constructed from args
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return tree_.emplace_hint(hint, std::forward<Args>(args)...).first;
   };
 
   // inserts a value by key and returns an iterator to where the
   // element is in the container and bool denoting whether the insertion took
   // place
   std::pair<iterator, bool> insert(const Key& key, const T& obj) {
-    value_type value = {key, obj};
-    iterator it = map_find(value.first);
-    if (it == end()) {
-      auto res = tree_.insert(value);
-      return res;
-    }
-    return {it, false};
+    return tree_.insert(value_type{key, obj});
   };
 
   // inserts an element or assigns to the current element if the key already
-  // exists
-  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
-    value_type value = {key, obj};
-    iterator it = map_find(key);
-    if (it == tree_.end())
-      return tree_.insert(value);
-    else {
-      (*it).second = obj;
-      return {it, false};
-    }
+  // exists. obj is forwarded straight to the mapped value, no temporary pair
+  // is made
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+    std::pair<iterator, bool> res = try_emplace(key, std::forward<M>(obj));
+    // try_emplace leaves obj untouched if the key is there
+    if (!res.second) (*res.first).second = std::forward<M>(obj);
+    return res;
+  };
+
+  // same for key which is moved into the new element
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj) {
+    std::pair<iterator, bool> res =
+        try_emplace(std::move(key), std::forward<M>(obj));
+    if (!res.second) (*res.first).second = std::forward<M>(obj);
+    return res;
   };
 
   // erases an element at pos
-  void erase(iterator pos) {
-    auto it = map_find((*pos).first);
-    if (it != end()) tree_.erase(pos);
+  void erase(iterator pos) { tree_.erase(pos); };
+
+  // erases the elements of [first, last) and returns an iterator to last. a
+  // long range is cut out at once, so k elements take O(k + log n)
+  iterator erase(const_iterator first, const_iterator last) {
+    return tree_.erase(first, last);
+  };
+
+  // erases the element with key and returns the number of erased elements
+  size_type erase(const Key& key) { return tree_.erase_key(key); };
+
+  // erases all the elements pred returns true for and returns their number
+  template <typename Predicate>
+  size_type erase_if(Predicate pred) {
+    return tree_.erase_if(pred);
   };
 
   // swaps the contents
@@ -161,44 +281,272 @@ class map {
   // splices nodes from another container
   void merge(map& other) { tree_.merge(other.tree_); };
 
+  // node handles move elements between containers without copying them
+
+  // unlinks the element at pos and returns it in a node handle
+  node_type extract(const_iterator pos) { return tree_.extract(pos); };
+
+  // same for an element with key, empty handle if there is none
+  node_type extract(const Key& key) { return tree_.extract_key(key); };
+
+  // inserts the element owned by node. if the key is already there, the
+  // handle is given back in the result
+  insert_return_type insert(node_type&& node) {
+    std::pair<iterator, bool> res = tree_.insert(end(), std::move(node), true);
+    return {res.first, res.second, std::move(node)};
+  };
+
+  // same as insert of node as close as possible to the position just before
+  // hint. returns the element with the key of node
+  iterator insert(const_iterator hint, node_type&& node) {
+    return tree_.insert(hint, std::move(node), true).first;
+  };
+
+  // makes this empty map take its nodes from the pool of other, so that
+  // extracted nodes move between the two without moving the values. returns
+  // false if the map is not empty or the allocators differ. such
+  // containers must not be modified from different threads at the same time
+  bool share_pool(map& other) { return tree_.share_pool(other.tree_); };
+
+  // calls func for every element in order and returns it. the mapped values
+  // may be changed
+  template <typename Function>
+  Function for_each(Function func) {
+    auto visit = [&func](reference value) { func(value); };
+    tree_.for_each(visit);
+    return func;
+  };
+
+  // same for const map
+  template <typename Function>
+  Function for_each(Function func) const {
+    auto visit = [&func](const_reference value) { func(value); };
+    tree_.for_each(visit);
+    return func;
+  };
+
+  // calls func for every element on policy.threads threads. each thread
+  // walks a run of consecutive elements, func is called concurrently
+  template <typename Function>
+  void for_each(parallel_policy policy, Function func) {
+    auto visit = [&func](reference value) { func(value); };
+    tree_.for_each(visit, policy.threads);
+  };
+
+  // same for const map
+  template <typename Function>
+  void for_each(parallel_policy policy, Function func) const {
+    auto visit = [&func](const_reference value) { func(value); };
+    tree_.for_each(visit, policy.threads);
+  };
+
   // checks if there is an element with key equivalent to key in the container
   bool contains(const Key& key) const noexcept {
-    const_iterator it = map_find(key);
-    return it == end() ? 0 : 1;
+    return tree_.contains(key);
+  };
+
+  // finds an element with a specific key
+  iterator find(const Key& key) { return tree_.find(key); };
+
+  // same for const map
+  const_iterator find(const Key& key) const { return tree_.find(key); };
+
+  // returns the number of elements with a specific key. keys are unique, so
+  // one search is enough
+  size_type count(const Key& key) const { return tree_.contains(key) ? 1 : 0; };
+
+  // batched lookups of many keys at once. the searches run interleaved and
+  // prefetch their next nodes, so the cache misses of different keys
+  // overlap. this pays off for trees much bigger than the cache
+
+  // writes an iterator to the element with every key of random access range
+  // [first, last) to out, end() for a missing key. returns the end of output
+  template <typename RandomIt, typename OutputIt>
+  OutputIt find_batch(RandomIt first, RandomIt last, OutputIt out) {
+    return tree_.find_batch(first, last, out);
+  };
+
+  // same for const map
+  template <typename RandomIt, typename OutputIt>
+  OutputIt find_batch(RandomIt first, RandomIt last, OutputIt out) const {
+    return tree_.find_batch(first, last, out);
+  };
+
+  // writes whether the map contains every key of [first, last) to out
+  template <typename RandomIt, typename OutputIt>
+  OutputIt contains_batch(RandomIt first, RandomIt last, OutputIt out) const {
+    return tree_.contains_batch(first, last, out);
+  };
+
+  // returns an iterator to the first element not less than the given key
+  iterator lower_bound(const Key& key) { return tree_.lower_bound(key); };
+
+  // same for const map
+  const_iterator lower_bound(const Key& key) const {
+    return tree_.lower_bound(key);
+  };
+
+  // returns an iterator to the first element greater than the given key
+  iterator upper_bound(const Key& key) { return tree_.upper_bound(key); };
+
+  // same for const map
+  const_iterator upper_bound(const Key& key) const {
+    return tree_.upper_bound(key);
+  };
+
+  // returns range of elements matching a specific key
+  std::pair<iterator, iterator> equal_range(const Key& key) {
+    return tree_.equal_range(key);
+  };
+
+  // same for const map
+  std::pair<const_iterator, const_iterator> equal_range(const Key& key) const {
+    return tree_.equal_range(key);
+  };
+
+  // order statistics. every node knows the size of its subtree, so these
+  // take O(log n)
+
+  // returns iterator to the element at position k in sorted order (counting
+  // from 0), end() if there is no such element
+  iterator nth(size_type k) { return tree_.nth(k); };
+
+  // same for const map
+  const_iterator nth(size_type k) const { return tree_.nth(k); };
+
+  // returns number of elements less than key
+  size_type rank(const Key& key) const { return tree_.rank(key); };
+
+  // returns number of increments needed to get from first to last
+  difference_type distance(const_iterator first, const_iterator last) const {
+    return tree_.distance(first, last);
+  };
+
+  // heterogeneous lookup: the overloads below take any key type comparable
+  // with Key and are available only for transparent comparators
+
+  // finds an element with a key equivalent to key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  iterator find(const K& key) {
+    return tree_.find(key);
+  };
+
+  // same for const map
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  const_iterator find(const K& key) const {
+    return tree_.find(key);
+  };
+
+  // checks if the container contains an element equivalent to key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  bool contains(const K& key) const {
+    return tree_.contains(key);
   };
 
-  // inserts new elements into the container
+  // returns the number of elements equivalent to key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  size_type count(const K& key) const {
+    return tree_.count(key);
+  };
+
+  // returns an iterator to the first element not less than key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  iterator lower_bound(const K& key) {
+    return tree_.lower_bound(key);
+  };
+
+  // same for const map
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  const_iterator lower_bound(const K& key) const {
+    return tree_.lower_bound(key);
+  };
+
+  // returns an iterator to the first element greater than key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  iterator upper_bound(const K& key) {
+    return tree_.upper_bound(key);
+  };
+
+  // same for const map
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  const_iterator upper_bound(const K& key) const {
+    return tree_.upper_bound(key);
+  };
+
+  // returns range of elements equivalent to key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  std::pair<iterator, iterator> equal_range(const K& key) {
+    return tree_.equal_range(key);
+  };
+
+  // same for const map
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const K& key) const {
+    return tree_.equal_range(key);
+  };
+
+  // returns number of elements less than key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  size_type rank(const K& key) const {
+    return tree_.rank(key);
+  };
+
+  // constructs an element from args in place and inserts it if there is no
+  // element with its key. returns the element with the key and whether the
+  // insertion took place
   template <typename... Args>
-  std::vector<std::pair<iterator, bool>> emplace(Args&&... args) {
+  std::pair<iterator, bool> emplace(Args&&... args) {
     return tree_.emplace(std::forward<Args>(args)...);
   };
 
- private:
-  // finds element with param key
-  iterator map_find(const Key& key) noexcept {
-    iterator it = tree_.begin();
-    if (it == tree_.end() || it == nullptr) return end();
-    while (it != tree_.end()) {
-      if ((*it).first == key) return it;
-      it++;
-    }
-    return end();
-  }
-
-  // finds element with param key for const map
-  const_iterator map_find(const Key& key) const noexcept {
-    const_iterator it = tree_.begin();
-    if (it == tree_.end()) return end();
-    while (it != tree_.end()) {
-      if ((*it).first == key) return it;
-      it++;
-    }
-    return end();
-  }
+  // inserts an element with key and the mapped value constructed from args
+  // if there is no element with key. otherwise nothing is constructed and
+  // args are left untouched
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    return tree_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  };
+
+  // same for key which is moved into the new element
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+    return tree_.try_emplace(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  };
 
+  // inserts new elements into the container, one per argument
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    return tree_.insert_many(std::forward<Args>(args)...);
+  };
+
+ private:
   // red black tree variable
   tree tree_;
 };
+
+// erases all the elements of c pred returns true for, returns their number
+template <typename Key, typename T, typename Compare, typename Allocator,
+          bool Threaded, typename Predicate>
+std::size_t erase_if(map<Key, T, Compare, Allocator, Threaded>& c,
+                     Predicate pred) {
+  return c.erase_if(pred);
+}
+
+// map whose iterators follow successor links instead of climbing the tree
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+using threaded_map = map<Key, T, Compare, Allocator, true>;
+
+namespace pmr {
+template <typename Key, typename T, typename Compare = std::less<Key>>
+using map = s21::map<Key, T, Compare,
+                     std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // SRC_S21_MAP_H_
\ No newline at end of file
@@ -14,36 +14,94 @@
 */
 
 namespace s21 {
-template <typename Key>
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>, bool Threaded = false>
 class multiset {
   using key_type = Key;
   using value_type = Key;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using tree = RBTree<value_type>;
+  using tree = RBTree<value_type, IdentityKey<value_type>, Compare, Allocator,
+                      Threaded>;
   using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
 
  public:
   using iterator = typename tree::iterator;
   using const_iterator = typename tree::const_iterator;
+  using node_type = typename tree::node_type;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using allocator_type = Allocator;
 
   // default constructor, creates an empty set
   multiset() : tree_(){};
 
+  // creates an empty set ordered by comp which gets its memory from alloc
+  explicit multiset(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_(comp, alloc){};
+
+  // creates an empty set which gets its memory from alloc
+  explicit multiset(const Allocator& alloc) : tree_(alloc){};
+
   // initializer list constructor, creates the set initizialized using
   // std::initializer_list
-  multiset(std::initializer_list<value_type> const& items) {
+  multiset(std::initializer_list<value_type> const& items,
+           const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
     for (auto it : items) {
       tree_.insert_duplicate(it);
     }
   };
 
+  // initializer list constructor with allocator
+  multiset(std::initializer_list<value_type> const& items,
+           const Allocator& alloc)
+      : multiset(items, Compare(), alloc){};
+
+  // range constructor, creates the multiset from [first, last) in any order
+  template <typename InputIt, typename = if_iterator<InputIt>>
+  multiset(InputIt first, InputIt last, const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.assign(first, last, false);
+  };
+
+  // bulk load constructor, creates the multiset from [first, last) sorted by
+  // comp in O(n)
+  template <typename InputIt>
+  multiset(sorted_equivalent_t, InputIt first, InputIt last,
+           const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.assign_sorted(first, last, false);
+  };
+
+  // parallel range constructor, creates the multiset from random access range
+  // [first, last) in any order. the values are constructed, sorted and
+  // linked on policy.threads threads
+  template <typename RandomIt>
+  multiset(parallel_policy policy, RandomIt first, RandomIt last,
+           const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.assign(first, last, false, policy.threads);
+  };
+
   // copy constructor
   multiset(const multiset& s) : tree_(s.tree_){};
 
+  // copy constructor which gets memory from alloc
+  multiset(const multiset& s, const Allocator& alloc) : tree_(s.tree_, alloc){};
+
   // move constructor
   multiset(multiset&& s) : tree_(std::move(s.tree_)){};
 
+  // move constructor which gets memory from alloc
+  multiset(multiset&& s, const Allocator& alloc)
+      : tree_(std::move(s.tree_), alloc){};
+
   // destructor
   ~multiset() = default;
 
@@ -63,9 +121,38 @@ class multiset {
   // container
   iterator insert(const_reference key) { return tree_.insert_duplicate(key); };
 
+  // inserts a node as close as possible to the position just before hint
+  // and returns an iterator to the inserted element. a correct hint
+  // saves the search, so sorted input is inserted in amortized O(1)
+  // comparisons
+  iterator insert(const_iterator hint, const_reference key) {
+    return tree_.insert_duplicate(hint, key);
+  };
+
+  // same as hinted insert for the element constructed from args
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return tree_.emplace_hint_duplicate(hint, std::forward<Args>(args)...);
+  };
+
   // erases an element at pos
   void erase(iterator pos) { tree_.erase(pos); };
 
+  // erases the elements of [first, last) and returns an iterator to last. a
+  // long range is cut out at once, so k elements take O(k + log n)
+  iterator erase(const_iterator first, const_iterator last) {
+    return tree_.erase(first, last);
+  };
+
+  // erases all the elements with key and returns the number of erased elements
+  size_type erase(const Key& key) { return tree_.erase_key(key); };
+
+  // erases all the elements pred returns true for and returns their number
+  template <typename Predicate>
+  size_type erase_if(Predicate pred) {
+    return tree_.erase_if(pred);
+  };
+
   // checks whether the container is empty
   bool empty() const noexcept { return tree_.empty(); };
 
@@ -78,12 +165,178 @@ class multiset {
   // clears the contents
   void clear() { tree_.clear(); };
 
+  // replaces the contents with the elements of [first, last) in any order
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last) {
+    tree_.assign(first, last, false);
+  };
+
+  // same for [first, last) sorted by key_comp(). builds a balanced tree
+  // in O(n)
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    tree_.assign_sorted(first, last, false);
+  };
+
+  // same as assign for random access range on policy.threads threads
+  template <typename RandomIt>
+  void assign(parallel_policy policy, RandomIt first, RandomIt last) {
+    tree_.assign(first, last, false, policy.threads);
+  };
+
+  // returns the function object which compares the keys
+  key_compare key_comp() const { return tree_.key_comp(); };
+
+  // returns the function object which compares the values
+  value_compare value_comp() const { return tree_.key_comp(); };
+
+  // returns the allocator associated with the container
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
   // swaps the contents
   void swap(multiset& other) { tree_.swap(other.tree_); };
 
   // splices nodes from another container
   void merge(multiset& other) { tree_.merge_duplicates(other.tree_); };
 
+  // node handles move elements between containers without copying them
+
+  // unlinks the element at pos and returns it in a node handle
+  node_type extract(const_iterator pos) { return tree_.extract(pos); };
+
+  // same for an element with key, empty handle if there is none
+  node_type extract(const_reference key) { return tree_.extract_key(key); };
+
+  // inserts the element owned by node
+  iterator insert(node_type&& node) {
+    return tree_.insert(end(), std::move(node), false).first;
+  };
+
+  // same as insert of node as close as possible to the position just before
+  // hint
+  iterator insert(const_iterator hint, node_type&& node) {
+    return tree_.insert(hint, std::move(node), false).first;
+  };
+
+  // makes this empty multiset take its nodes from the pool of other, so that
+  // extracted nodes move between the two without moving the values. returns
+  // false if the multiset is not empty or the allocators differ. such
+  // containers must not be modified from different threads at the same time
+  bool share_pool(multiset& other) { return tree_.share_pool(other.tree_); };
+
+  // set algebra: the multiset becomes the union (intersection, difference,
+  // symmetric difference) of itself and other. an rvalue other gives its
+  // nodes away and is left empty, otherwise its elements are copied. the
+  // trees are split and joined, which takes O(m log(n / m + 1)) for sizes
+  // m <= n only if the multisets share a pool (see share_pool): otherwise
+  // all of other is copied or moved into this pool first
+  void set_union(multiset&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kUnion, false);
+  };
+
+  // same, other is copied
+  void set_union(const multiset& other) {
+    tree_.set_operation(other.tree_, SetOperation::kUnion, false);
+  };
+
+  // same for intersection
+  void set_intersection(multiset&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kIntersection, false);
+  };
+
+  // same, other is copied
+  void set_intersection(const multiset& other) {
+    tree_.set_operation(other.tree_, SetOperation::kIntersection, false);
+  };
+
+  // same for difference
+  void set_difference(multiset&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kDifference, false);
+  };
+
+  // same, other is copied
+  void set_difference(const multiset& other) {
+    tree_.set_operation(other.tree_, SetOperation::kDifference, false);
+  };
+
+  // same for symmetric difference
+  void symmetric_difference(multiset&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kSymmetricDifference, false);
+  };
+
+  // same, other is copied
+  void symmetric_difference(const multiset& other) {
+    tree_.set_operation(other.tree_, SetOperation::kSymmetricDifference, false);
+  };
+
+  // set algebra on policy.threads threads: subtrees of big parts of both
+  // trees are combined in parallel. a copy of lvalue other is made on this
+  // thread
+  void set_union(parallel_policy policy, multiset&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kUnion, false,
+                        policy.threads);
+  };
+
+  // same, other is copied
+  void set_union(parallel_policy policy, const multiset& other) {
+    tree_.set_operation(other.tree_, SetOperation::kUnion, false,
+                        policy.threads);
+  };
+
+  // same for intersection
+  void set_intersection(parallel_policy policy, multiset&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kIntersection, false,
+                        policy.threads);
+  };
+
+  // same, other is copied
+  void set_intersection(parallel_policy policy, const multiset& other) {
+    tree_.set_operation(other.tree_, SetOperation::kIntersection, false,
+                        policy.threads);
+  };
+
+  // same for difference
+  void set_difference(parallel_policy policy, multiset&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kDifference, false,
+                        policy.threads);
+  };
+
+  // same, other is copied
+  void set_difference(parallel_policy policy, const multiset& other) {
+    tree_.set_operation(other.tree_, SetOperation::kDifference, false,
+                        policy.threads);
+  };
+
+  // same for symmetric difference
+  void symmetric_difference(parallel_policy policy, multiset&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kSymmetricDifference, false,
+                        policy.threads);
+  };
+
+  // same, other is copied
+  void symmetric_difference(parallel_policy policy, const multiset& other) {
+    tree_.set_operation(other.tree_, SetOperation::kSymmetricDifference, false,
+                        policy.threads);
+  };
+
+  // calls func for every element in order and returns it
+  template <typename Function>
+  Function for_each(Function func) const {
+    auto visit = [&func](const_reference value) { func(value); };
+    tree_.for_each(visit);
+    return func;
+  };
+
+  // calls func for every element on policy.threads threads. each thread
+  // walks a run of consecutive elements, func is called concurrently
+  template <typename Function>
+  void for_each(parallel_policy policy, Function func) const {
+    auto visit = [&func](const_reference value) { func(value); };
+    tree_.for_each(visit, policy.threads);
+  };
+
   // finds element with a specific key
   iterator find(const_reference key) noexcept { return tree_.find(key); };
 
@@ -147,16 +400,131 @@ class multiset {
     return tree_.upper_bound(key);
   };
 
-  // inserts new elements into the container
+  // order statistics. every node knows the size of its subtree, so these
+  // take O(log n)
+
+  // returns iterator to the element at position k in sorted order (counting
+  // from 0), end() if there is no such element
+  iterator nth(size_type k) { return tree_.nth(k); };
+
+  // same for const multiset
+  const_iterator nth(size_type k) const { return tree_.nth(k); };
+
+  // returns number of elements less than key
+  size_type rank(const_reference key) const { return tree_.rank(key); };
+
+  // returns number of increments needed to get from first to last
+  difference_type distance(const_iterator first, const_iterator last) const {
+    return tree_.distance(first, last);
+  };
+
+  // heterogeneous lookup: the overloads below take any key type comparable
+  // with key_type and are available only for transparent comparators
+
+  // finds an element with a key equivalent to key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  iterator find(const K& key) {
+    return tree_.find(key);
+  };
+
+  // same for const multiset
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  const_iterator find(const K& key) const {
+    return tree_.find(key);
+  };
+
+  // checks if the container contains an element equivalent to key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  bool contains(const K& key) const {
+    return tree_.contains(key);
+  };
+
+  // returns the number of elements equivalent to key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  size_type count(const K& key) const {
+    return tree_.count(key);
+  };
+
+  // returns an iterator to the first element not less than key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  iterator lower_bound(const K& key) {
+    return tree_.lower_bound(key);
+  };
+
+  // same for const multiset
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  const_iterator lower_bound(const K& key) const {
+    return tree_.lower_bound(key);
+  };
+
+  // returns an iterator to the first element greater than key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  iterator upper_bound(const K& key) {
+    return tree_.upper_bound(key);
+  };
+
+  // same for const multiset
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  const_iterator upper_bound(const K& key) const {
+    return tree_.upper_bound(key);
+  };
+
+  // returns range of elements equivalent to key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  std::pair<iterator, iterator> equal_range(const K& key) {
+    return tree_.equal_range(key);
+  };
+
+  // same for const multiset
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const K& key) const {
+    return tree_.equal_range(key);
+  };
+
+  // returns number of elements less than key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  size_type rank(const K& key) const {
+    return tree_.rank(key);
+  };
+
+  // constructs an element from args in place, inserts it after the
+  // equivalent ones and returns an iterator to it
   template <typename... Args>
-  std::vector<std::pair<iterator, bool>> emplace(Args&&... args) {
+  iterator emplace(Args&&... args) {
     return tree_.emplace_duplicate(std::forward<Args>(args)...);
   };
 
+  // inserts new elements into the container, one per argument
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    return tree_.insert_many_duplicate(std::forward<Args>(args)...);
+  };
+
  private:
   // red black tree variable
   tree tree_;
 };
+
+// erases all the elements of c pred returns true for, returns their number
+template <typename Key, typename Compare, typename Allocator, bool Threaded,
+          typename Predicate>
+std::size_t erase_if(multiset<Key, Compare, Allocator, Threaded>& c,
+                     Predicate pred) {
+  return c.erase_if(pred);
+}
+
+// multiset whose iterators follow successor links instead of climbing the
+// tree
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+using threaded_multiset = multiset<Key, Compare, Allocator, true>;
+
+namespace pmr {
+template <typename Key, typename Compare = std::less<Key>>
+using multiset =
+    s21::multiset<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // SRC_S21_MULTISET_H
\ No newline at end of file
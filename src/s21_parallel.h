@@ -0,0 +1,140 @@
+#ifndef SRC_S21_PARALLEL_H_
+#define SRC_S21_PARALLEL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+/*
+    Helpers for parallel container operations
+    Work is split by fork-join: a task that has more than one thread at its
+   disposal hands one half of its work and half of its threads to a new
+   thread, does the other half itself and waits for the helper. The halves
+   are split further in the same way, so a task given p threads runs on p
+   threads at most and nothing outlives the call. A task smaller than
+   kParallelGrain is not split at all.
+
+    If a thread cannot be started the work is done on the calling thread.
+*/
+
+namespace s21 {
+// smallest number of elements worth handing to another thread
+constexpr std::size_t kParallelGrain = 1 << 12;
+
+// execution policy of container operations which may run on several threads
+struct parallel_policy {
+  std::size_t threads;  // number of threads the operation may use
+};
+
+// returns policy using threads threads, all the hardware threads by default
+inline parallel_policy parallel(std::size_t threads = 0) noexcept {
+  if (threads == 0) threads = std::thread::hardware_concurrency();
+  return {threads > 0 ? threads : 1};
+}
+
+// runs left(threads / 2) on a new thread and right(threads - threads / 2)
+// on this one, then waits for both. with one thread both run here
+template <typename Left, typename Right>
+void fork_join(std::size_t threads, Left&& left, Right&& right) {
+  if (threads > 1) {
+    std::future<void> helper;
+    try {
+      helper = std::async(std::launch::async, [&left, threads] {
+        left(threads / 2);
+      });
+    } catch (...) {
+      threads = 1;
+    }
+    if (helper.valid()) {
+      // the destructor of helper waits for it if right throws
+      right(threads - threads / 2);
+      helper.get();
+      return;
+    }
+  }
+  left(threads);
+  right(threads);
+}
+
+// calls body(first, last) for pieces of [begin, end) split between threads
+template <typename Body>
+void parallel_for(std::size_t begin, std::size_t end, std::size_t threads,
+                  Body& body) {
+  if (threads < 2 || end - begin < 2 * kParallelGrain) {
+    body(begin, end);
+    return;
+  }
+  std::size_t middle = begin + (end - begin) / threads * (threads / 2);
+  fork_join(
+      threads,
+      [&](std::size_t part) { parallel_for(begin, middle, part, body); },
+      [&](std::size_t part) { parallel_for(middle, end, part, body); });
+}
+
+// moves the sorted ranges [first1, last1) and [first2, last2) merged to out
+// equivalent elements of the first range go before the ones of the second
+template <typename InputIt, typename OutputIt, typename Compare>
+void parallel_merge(InputIt first1, InputIt last1, InputIt first2,
+                    InputIt last2, OutputIt out, Compare comp,
+                    std::size_t threads) {
+  std::size_t size1 = last1 - first1, size2 = last2 - first2;
+  if (threads < 2 || size1 + size2 < 2 * kParallelGrain) {
+    std::merge(std::make_move_iterator(first1), std::make_move_iterator(last1),
+               std::make_move_iterator(first2), std::make_move_iterator(last2),
+               out, comp);
+    return;
+  }
+  // the middle of the longer range splits the shorter one
+  InputIt middle1, middle2;
+  if (size1 >= size2) {
+    middle1 = first1 + size1 / 2;
+    middle2 = std::lower_bound(first2, last2, *middle1, comp);
+  } else {
+    middle2 = first2 + size2 / 2;
+    middle1 = std::upper_bound(first1, last1, *middle2, comp);
+  }
+  OutputIt out2 = out + ((middle1 - first1) + (middle2 - first2));
+  fork_join(
+      threads,
+      [&](std::size_t part) {
+        parallel_merge(first1, middle1, first2, middle2, out, comp, part);
+      },
+      [&](std::size_t part) {
+        parallel_merge(middle1, last1, middle2, last2, out2, comp, part);
+      });
+}
+
+// stable sort of [first, last) on threads threads. halves are sorted in
+// parallel and merged in parallel through a buffer, so the elements must be
+// default constructible
+template <typename RandomIt, typename Compare>
+void parallel_stable_sort(RandomIt first, RandomIt last, Compare comp,
+                          std::size_t threads) {
+  using value_type = typename std::iterator_traits<RandomIt>::value_type;
+  std::size_t size = last - first;
+  if (threads < 2 || size < 2 * kParallelGrain) {
+    std::stable_sort(first, last, comp);
+    return;
+  }
+  RandomIt middle = first + size / 2;
+  fork_join(
+      threads,
+      [&](std::size_t part) {
+        parallel_stable_sort(first, middle, comp, part);
+      },
+      [&](std::size_t part) {
+        parallel_stable_sort(middle, last, comp, part);
+      });
+  std::vector<value_type> merged(size);
+  parallel_merge(first, middle, middle, last, merged.begin(), comp, threads);
+  auto move_back = [&merged, first](std::size_t begin, std::size_t end) {
+    std::move(merged.begin() + begin, merged.begin() + end, first + begin);
+  };
+  parallel_for(0, size, threads, move_back);
+}
+}  // namespace s21
+
+#endif  // SRC_S21_PARALLEL_H_
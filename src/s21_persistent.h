@@ -0,0 +1,596 @@
+#ifndef SRC_S21_PERSISTENT_H_
+#define SRC_S21_PERSISTENT_H_
+
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "s21_tree.h"
+
+/*
+    Implementation of the persistent tree
+    RBTree changes its nodes in place and every node knows its parent, so
+   two trees cannot share nodes and a copy takes O(n). The persistent tree
+   is a left-leaning red-black tree whose nodes have no parent links and are
+   never changed once another tree can see them:
+
+    1. Every node counts the links and trees pointing to it. A copy of the
+   tree takes one more reference to the root, O(1), and the two trees share
+   all the nodes from then on.
+    2. An update copies the nodes it changes: the path from the root down to
+   the key and the few neighbours the rotations touch, O(log n) new nodes.
+   A copy takes references to the children of the original, so the rest of
+   the tree is shared. The update works on a new root and replaces the old
+   one only when it is done, so if a constructor or an allocation throws,
+   the tree is left as it was.
+    3. A node is freed when its last reference is dropped, which frees the
+   nodes only it pointed to. Old versions cost no memory once no copy of
+   them is left.
+
+    The counts are atomic and a node is never changed after it is linked
+   into a published tree, so copies of a tree may be read and destroyed on
+   different threads at the same time while one thread updates its own copy,
+   without locks. A single tree object is not thread-safe: readers should
+   take their own copy (a snapshot) of it. Nodes are taken from Allocator
+   directly, not from a pool, since any thread may free them.
+
+    There are no parent links, so an iterator keeps the path from the root
+   to its element. It stays valid while the tree it came from is alive and
+   not updated.
+*/
+
+namespace s21 {
+// Key is the stored value type, KeyOfValue extracts the part of it the
+// tree is ordered and searched by, Compare orders the keys, Allocator
+// provides memory for the nodes
+template <typename Key, typename KeyOfValue = IdentityKey<Key>,
+          typename Compare = std::less<typename KeyOfValue::key_type>,
+          typename Allocator = std::allocator<Key>>
+class PersistentTree : private CompareHolder<Compare> {
+  using compare_holder = CompareHolder<Compare>;
+  using compare_holder::comp;
+  class PNode;
+  class PIterator;
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<PNode>;
+  using node_traits = std::allocator_traits<node_allocator>;
+  using size_type = std::size_t;
+  using NodePtr = PNode*;
+
+  // size is limited, so that a path from the root fits into an iterator:
+  // a red-black tree of n nodes is at most 2 log2(n + 1) levels high
+  static constexpr size_type kMaxHeight = 64;
+
+ public:
+  using const_iterator = PIterator;
+  using value_type = Key;
+  using key_type = typename KeyOfValue::key_type;
+  using key_compare = Compare;
+
+  // creates empty tree
+  explicit PersistentTree(const Compare& comp = Compare(),
+                          const Allocator& alloc = Allocator())
+      : compare_holder(comp), root_(nullptr), size_(0), alloc_(alloc){};
+
+  // copy constructor. shares all the nodes with other, O(1)
+  PersistentTree(const PersistentTree& other)
+      : compare_holder(other.comp()),
+        root_(retain(other.root_)),
+        size_(other.size_),
+        alloc_(other.alloc_){};
+
+  // move constructor
+  PersistentTree(PersistentTree&& other) noexcept
+      : compare_holder(other.comp()),
+        root_(other.root_),
+        size_(other.size_),
+        alloc_(other.alloc_) {
+    other.root_ = nullptr;
+    other.size_ = 0;
+  };
+
+  // destructor. drops the reference to the root
+  ~PersistentTree() { release(root_); };
+
+  // copy assignment. shares all the nodes with other, O(1)
+  PersistentTree& operator=(const PersistentTree& other) {
+    if (this != &other) {
+      NodePtr root = retain(other.root_);
+      release(root_);
+      static_cast<compare_holder&>(*this) = other;
+      alloc_ = other.alloc_;
+      root_ = root;
+      size_ = other.size_;
+    }
+    return *this;
+  };
+
+  // move assignment
+  PersistentTree& operator=(PersistentTree&& other) noexcept {
+    if (this != &other) {
+      release(root_);
+      static_cast<compare_holder&>(*this) = other;
+      alloc_ = other.alloc_;
+      root_ = other.root_;
+      size_ = other.size_;
+      other.root_ = nullptr;
+      other.size_ = 0;
+    }
+    return *this;
+  };
+
+  // returns iterator to the smallest element
+  const_iterator begin() const noexcept {
+    const_iterator it(root_);
+    for (NodePtr node = root_; node != nullptr; node = node->left_)
+      it.push(node);
+    return it;
+  };
+
+  // returns iterator after the greatest element
+  const_iterator end() const noexcept { return const_iterator(root_); };
+
+  // checks whether the tree is empty
+  bool empty() const noexcept { return size_ == 0; };
+
+  // returns number of elements
+  size_type size() const noexcept { return size_; };
+
+  // returns max possible number of elements
+  size_type max_size() const noexcept {
+    return std::min<size_type>(node_traits::max_size(alloc_),
+                               std::numeric_limits<std::uint32_t>::max());
+  };
+
+  // drops all the elements. nodes shared with other trees stay alive
+  void clear() noexcept {
+    release(root_);
+    root_ = nullptr;
+    size_ = 0;
+  };
+
+  // swaps the contents
+  void swap(PersistentTree& other) noexcept {
+    using std::swap;
+    compare_holder::swap_comp(other);
+    swap(root_, other.root_);
+    swap(size_, other.size_);
+    if constexpr (node_traits::propagate_on_container_swap::value)
+      swap(alloc_, other.alloc_);
+  };
+
+  // inserts the element constructed from args if there is no element with
+  // key, or replaces the element with key if replace is true. returns
+  // whether a new element was inserted
+  template <typename... Args>
+  bool insert(const key_type& key, bool replace, Args&&... args) {
+    bool found = contains(key);
+    if (found && !replace) return false;
+    NodePtr root = retain(root_);
+    try {
+      put(root, key, std::forward<Args>(args)...);
+      root->red_ = false;
+    } catch (...) {
+      release(root);
+      throw;
+    }
+    release(root_);
+    root_ = root;
+    if (!found) size_++;
+    return !found;
+  };
+
+  // erases the element with key. returns number of erased elements
+  template <typename K>
+  size_type erase(const K& key) {
+    if (!contains(key)) return 0;
+    NodePtr root = retain(root_);
+    try {
+      own(root);
+      if (!is_red(root->left_) && !is_red(root->right_)) root->red_ = true;
+      erase(root, key);
+      if (root != nullptr) root->red_ = false;
+    } catch (...) {
+      release(root);
+      throw;
+    }
+    release(root_);
+    root_ = root;
+    size_--;
+    return 1;
+  };
+
+  // returns iterator to the element with key, end() if there is none
+  template <typename K>
+  const_iterator find(const K& key) const noexcept {
+    const_iterator it = lower_bound(key);
+    if (it != end() && comp()(key, key_of(*it))) return end();
+    return it;
+  };
+
+  // checks if there is an element with key
+  template <typename K>
+  bool contains(const K& key) const noexcept {
+    NodePtr node = root_;
+    while (node != nullptr) {
+      if (comp()(key, key_of(node->data_)))
+        node = node->left_;
+      else if (comp()(key_of(node->data_), key))
+        node = node->right_;
+      else
+        return true;
+    }
+    return false;
+  };
+
+  // returns iterator to the first element not less than key
+  template <typename K>
+  const_iterator lower_bound(const K& key) const noexcept {
+    auto go_left = [this, &key](NodePtr node) {
+      return !comp()(key_of(node->data_), key);
+    };
+    return bound(go_left);
+  };
+
+  // returns iterator to the first element greater than key
+  template <typename K>
+  const_iterator upper_bound(const K& key) const noexcept {
+    auto go_left = [this, &key](NodePtr node) {
+      return comp()(key, key_of(node->data_));
+    };
+    return bound(go_left);
+  };
+
+  // returns function object which compares keys
+  key_compare key_comp() const { return comp(); };
+
+  // returns allocator of the tree
+  Allocator get_allocator() const noexcept { return Allocator(alloc_); };
+
+ private:
+  // returns key of value
+  static const key_type& key_of(const value_type& value) noexcept {
+    return KeyOfValue()(value);
+  };
+
+  // checks if node is red. leaves are black
+  static bool is_red(NodePtr node) noexcept {
+    return node != nullptr && node->red_;
+  };
+
+  // returns iterator to the first element go_left is true for. go_left must
+  // be false for a prefix of the elements and true for the rest
+  template <typename GoLeft>
+  const_iterator bound(GoLeft& go_left) const noexcept {
+    const_iterator it(root_);
+    unsigned char depth = 0;
+    for (NodePtr node = root_; node != nullptr;) {
+      it.push(node);
+      if (go_left(node)) {
+        depth = it.depth_;
+        node = node->left_;
+      } else {
+        node = node->right_;
+      }
+    }
+    it.depth_ = depth;
+    return it;
+  };
+
+  //      =============== REFERENCES ===============
+
+  // takes one more reference to node
+  static NodePtr retain(NodePtr node) noexcept {
+    if (node != nullptr) node->refs_.fetch_add(1, std::memory_order_relaxed);
+    return node;
+  };
+
+  // drops a reference to node, frees it if it was the last one
+  void release(NodePtr node) noexcept {
+    while (node != nullptr &&
+           node->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      NodePtr right = node->right_;
+      release(node->left_);
+      delete_node(node);
+      node = right;
+    }
+  };
+
+  // allocates unlinked red node and constructs its value from args
+  template <typename... Args>
+  NodePtr create_node(Args&&... args) {
+    NodePtr node = node_traits::allocate(alloc_, 1);
+    ::new (static_cast<void*>(node)) PNode;
+    try {
+      node_traits::construct(alloc_, std::addressof(node->data_),
+                             std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(alloc_, node, 1);
+      throw;
+    }
+    return node;
+  };
+
+  // destroys node and frees its memory
+  void delete_node(NodePtr node) noexcept {
+    node_traits::destroy(alloc_, std::addressof(node->data_));
+    node->~PNode();
+    node_traits::deallocate(alloc_, node, 1);
+  };
+
+  // makes link point to a node this update may change: a node shared with
+  // anything else is replaced with a copy. if the copy fails the link is
+  // left as it was
+  void own(NodePtr& link) {
+    if (link->refs_.load(std::memory_order_acquire) == 1) return;
+    NodePtr copy = create_node(link->data_);
+    copy->red_ = link->red_;
+    copy->left_ = retain(link->left_);
+    copy->right_ = retain(link->right_);
+    release(link);
+    link = copy;
+  };
+
+  //      =============== BALANCING ===============
+
+  // the functions below take links to nodes owned by the update and keep
+  // every link holding exactly one reference, so if one throws half way the
+  // new tree can still be released as a whole
+
+  // left rotation of subtree at link
+  void rotate_left(NodePtr& link) {
+    own(link->right_);
+    NodePtr top = link->right_;
+    link->right_ = top->left_;
+    top->left_ = link;
+    top->red_ = link->red_;
+    link->red_ = true;
+    link = top;
+  };
+
+  // right rotation of subtree at link
+  void rotate_right(NodePtr& link) {
+    own(link->left_);
+    NodePtr top = link->left_;
+    link->left_ = top->right_;
+    top->right_ = link;
+    top->red_ = link->red_;
+    link->red_ = true;
+    link = top;
+  };
+
+  // flips colors of node and both of its children
+  void flip_colors(NodePtr node) {
+    own(node->left_);
+    own(node->right_);
+    node->red_ = !node->red_;
+    node->left_->red_ = !node->left_->red_;
+    node->right_->red_ = !node->right_->red_;
+  };
+
+  // makes the left child of node at link or one of its children red
+  void move_red_left(NodePtr& link) {
+    flip_colors(link);
+    if (is_red(link->right_->left_)) {
+      rotate_right(link->right_);
+      rotate_left(link);
+      flip_colors(link);
+    }
+  };
+
+  // makes the right child of node at link or one of its children red
+  void move_red_right(NodePtr& link) {
+    flip_colors(link);
+    if (is_red(link->left_->left_)) {
+      rotate_right(link);
+      flip_colors(link);
+    }
+  };
+
+  // restores left-leaning red-black shape of subtree at link on the way up
+  void balance(NodePtr& link) {
+    if (is_red(link->right_) && !is_red(link->left_)) rotate_left(link);
+    if (is_red(link->left_) && is_red(link->left_->left_)) rotate_right(link);
+    if (is_red(link->left_) && is_red(link->right_)) flip_colors(link);
+  };
+
+  //      =============== UPDATES ===============
+
+  // inserts the element constructed from args into subtree at link, or
+  // replaces the element with key
+  template <typename... Args>
+  void put(NodePtr& link, const key_type& key, Args&&... args) {
+    if (link == nullptr) {
+      link = create_node(std::forward<Args>(args)...);
+      return;
+    }
+    if (!comp()(key, key_of(link->data_)) &&
+        !comp()(key_of(link->data_), key)) {
+      NodePtr fresh = create_node(std::forward<Args>(args)...);
+      fresh->red_ = link->red_;
+      fresh->left_ = retain(link->left_);
+      fresh->right_ = retain(link->right_);
+      release(link);
+      link = fresh;
+      return;
+    }
+    own(link);
+    if (comp()(key, key_of(link->data_)))
+      put(link->left_, key, std::forward<Args>(args)...);
+    else
+      put(link->right_, key, std::forward<Args>(args)...);
+    balance(link);
+  };
+
+  // erases the element with key from subtree at link. it must be there
+  template <typename K>
+  void erase(NodePtr& link, const K& key) {
+    own(link);
+    if (comp()(key, key_of(link->data_))) {
+      if (!is_red(link->left_) && !is_red(link->left_->left_))
+        move_red_left(link);
+      erase(link->left_, key);
+    } else {
+      if (is_red(link->left_)) rotate_right(link);
+      if (!comp()(key_of(link->data_), key) && link->right_ == nullptr) {
+        release(link);
+        link = nullptr;
+        return;
+      }
+      if (!is_red(link->right_) && !is_red(link->right_->left_))
+        move_red_right(link);
+      if (!comp()(key_of(link->data_), key)) {
+        // the smallest node of the right subtree takes the place of the node
+        NodePtr min = nullptr;
+        try {
+          detach_min(link->right_, min);
+        } catch (...) {
+          release(min);
+          throw;
+        }
+        min->left_ = link->left_;
+        min->right_ = link->right_;
+        min->red_ = link->red_;
+        link->left_ = link->right_ = nullptr;
+        release(link);
+        link = min;
+      } else {
+        erase(link->right_, key);
+      }
+    }
+    balance(link);
+  };
+
+  // unlinks the smallest node of subtree at link and gives it to min
+  void detach_min(NodePtr& link, NodePtr& min) {
+    own(link);
+    if (link->left_ == nullptr) {
+      min = link;
+      link = nullptr;
+      return;
+    }
+    if (!is_red(link->left_) && !is_red(link->left_->left_))
+      move_red_left(link);
+    detach_min(link->left_, min);
+    balance(link);
+  };
+
+  //      =============== NODE CLASS ===============
+
+  // Node class
+  // the value is constructed and destroyed by the tree through its allocator
+  class PNode {
+   public:
+    // default constructor. creates unlinked red node with one reference
+    PNode() : refs_(1), left_(nullptr), right_(nullptr), red_(true){};
+
+    ~PNode(){};
+
+    std::atomic<std::size_t> refs_;  // number of links and trees to node
+    NodePtr left_;
+    NodePtr right_;
+    bool red_;
+    union {
+      Key data_;
+    };
+  };
+
+  //      =============== ITERATOR CLASS ===============
+
+  // Iterator class
+  // keeps the path from the root to the element, the empty path is end()
+  class PIterator {
+    friend PersistentTree;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key*;
+    using reference = const Key&;
+
+    PIterator() : root_(nullptr), depth_(0){};
+
+    reference operator*() const { return path_[depth_ - 1]->data_; };
+
+    pointer operator->() const {
+      return std::addressof(path_[depth_ - 1]->data_);
+    };
+
+    // goes down to the leftmost node of the right subtree if there is one,
+    // otherwise up past the nodes whose right subtree it leaves
+    PIterator& operator++() {
+      NodePtr node = path_[depth_ - 1];
+      if (node->right_ != nullptr) {
+        for (node = node->right_; node != nullptr; node = node->left_)
+          push(node);
+      } else {
+        NodePtr child = path_[--depth_];
+        while (depth_ > 0 && path_[depth_ - 1]->right_ == child)
+          child = path_[--depth_];
+      }
+      return *this;
+    };
+
+    PIterator operator++(int) {
+      PIterator copy = *this;
+      ++*this;
+      return copy;
+    };
+
+    // same in the other direction. end() goes to the greatest element
+    PIterator& operator--() {
+      if (depth_ == 0) {
+        for (NodePtr node = root_; node != nullptr; node = node->right_)
+          push(node);
+        return *this;
+      }
+      NodePtr node = path_[depth_ - 1];
+      if (node->left_ != nullptr) {
+        for (node = node->left_; node != nullptr; node = node->right_)
+          push(node);
+      } else {
+        NodePtr child = path_[--depth_];
+        while (depth_ > 0 && path_[depth_ - 1]->left_ == child)
+          child = path_[--depth_];
+      }
+      return *this;
+    };
+
+    PIterator operator--(int) {
+      PIterator copy = *this;
+      --*this;
+      return copy;
+    };
+
+    bool operator==(const PIterator& other) const {
+      if (depth_ == 0 || other.depth_ == 0) return depth_ == other.depth_;
+      return path_[depth_ - 1] == other.path_[other.depth_ - 1];
+    };
+
+    bool operator!=(const PIterator& other) const {
+      return !(*this == other);
+    };
+
+   private:
+    explicit PIterator(NodePtr root) : root_(root), depth_(0){};
+
+    // appends node to the path
+    void push(NodePtr node) noexcept { path_[depth_++] = node; };
+
+    NodePtr root_;               // root of the tree, to step back from end()
+    NodePtr path_[kMaxHeight];   // nodes from the root down to the element
+    unsigned char depth_;        // number of nodes in the path
+  };
+
+  NodePtr root_;           // root of the tree, shared with its copies
+  size_type size_;         // number of elements
+  node_allocator alloc_;   // source of the nodes
+};
+}  // namespace s21
+
+#endif  // SRC_S21_PERSISTENT_H_
@@ -0,0 +1,190 @@
+#ifndef SRC_S21_PERSISTENT_MAP_H_
+#define SRC_S21_PERSISTENT_MAP_H_
+
+#include <stdexcept>
+#include <utility>
+
+#include "s21_map.h"
+#include "s21_persistent.h"
+
+/*
+    Implementation of persistent_map
+    persistent_map is a map whose copies are O(1) snapshots: a copy shares
+   all the nodes with the original, and an update of either one copies only
+   the O(log n) nodes on its path (see PersistentTree). A snapshot never
+   changes, so a writer can keep updating its map and hand snapshots to
+   reader threads, which search and iterate them without locks. Snapshots
+   may be read and destroyed on any thread while the writer goes on; one
+   persistent_map object, like std::shared_ptr, must not be used by several
+   threads at once if any of them changes it.
+
+    Elements can be read but not changed through the map: there are no
+   non-const iterators and no operator[], updates go through insert,
+   insert_or_assign and erase.
+*/
+
+namespace s21 {
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class persistent_map {
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using tree = PersistentTree<value_type, PairFirstKey<value_type>, Compare,
+                              Allocator>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+ public:
+  using iterator = typename tree::const_iterator;
+  using const_iterator = typename tree::const_iterator;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  // default constructor, creates an empty map
+  persistent_map() : tree_(){};
+
+  // creates an empty map ordered by comp which gets its memory from alloc
+  explicit persistent_map(const Compare& comp,
+                          const Allocator& alloc = Allocator())
+      : tree_(comp, alloc){};
+
+  // initializer list constructor
+  persistent_map(std::initializer_list<value_type> const& items,
+                 const Compare& comp = Compare(),
+                 const Allocator& alloc = Allocator())
+      : persistent_map(items.begin(), items.end(), comp, alloc){};
+
+  // range constructor, creates the map from [first, last) in any order. of
+  // equivalent keys the first one is kept
+  template <typename InputIt, typename = if_iterator<InputIt>>
+  persistent_map(InputIt first, InputIt last, const Compare& comp = Compare(),
+                 const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    for (; first != last; ++first) insert(*first);
+  };
+
+  // creates the map from the elements of m
+  template <typename MapAllocator, bool Threaded>
+  explicit persistent_map(
+      const map<Key, T, Compare, MapAllocator, Threaded>& m,
+      const Allocator& alloc = Allocator())
+      : persistent_map(m.begin(), m.end(), m.key_comp(), alloc){};
+
+  // copy constructor. takes a snapshot of m in O(1)
+  persistent_map(const persistent_map& m) : tree_(m.tree_){};
+
+  // move constructor
+  persistent_map(persistent_map&& m) noexcept : tree_(std::move(m.tree_)){};
+
+  // destructor
+  ~persistent_map() = default;
+
+  // assignment operator overload for copying an object. O(1)
+  persistent_map& operator=(const persistent_map& m) {
+    tree_ = m.tree_;
+    return *this;
+  };
+
+  // assignment operator overload for moving an object
+  persistent_map& operator=(persistent_map&& m) noexcept {
+    tree_ = std::move(m.tree_);
+    return *this;
+  };
+
+  // returns a copy of the map which later updates of either one do not
+  // affect, in O(1)
+  persistent_map snapshot() const { return *this; };
+
+  // access a specified element with bounds checking
+  const T& at(const Key& key) const {
+    const_iterator it = tree_.find(key);
+    if (it == tree_.end()) throw std::out_of_range("persistent_map::at");
+    return it->second;
+  };
+
+  // returns an iterator to the beginning
+  const_iterator begin() const noexcept { return tree_.begin(); };
+
+  // returns an iterator to the end
+  const_iterator end() const noexcept { return tree_.end(); };
+
+  // checks whether the container is empty
+  bool empty() const noexcept { return tree_.empty(); };
+
+  // returns the number of elements
+  size_type size() const noexcept { return tree_.size(); };
+
+  // returns the maximum possible number of elements
+  size_type max_size() const noexcept { return tree_.max_size(); };
+
+  // clears the contents. snapshots keep their elements
+  void clear() noexcept { tree_.clear(); };
+
+  // inserts value if there is no element with its key. returns whether it
+  // was inserted
+  bool insert(const value_type& value) {
+    return tree_.insert(value.first, false, value);
+  };
+
+  // inserts value with key and obj if there is no element with key
+  bool insert(const Key& key, const T& obj) {
+    return tree_.insert(key, false, key, obj);
+  };
+
+  // inserts an element or assigns to the current element if the key
+  // already exists. returns whether it was inserted
+  template <typename M>
+  bool insert_or_assign(const Key& key, M&& obj) {
+    return tree_.insert(key, true, key, std::forward<M>(obj));
+  };
+
+  // erases the element with key. returns the number of erased elements
+  size_type erase(const Key& key) { return tree_.erase(key); };
+
+  // swaps the contents
+  void swap(persistent_map& other) noexcept { tree_.swap(other.tree_); };
+
+  // checks if there is an element with key equivalent to key in the container
+  bool contains(const Key& key) const { return tree_.contains(key); };
+
+  // finds an element with a specific key
+  const_iterator find(const Key& key) const { return tree_.find(key); };
+
+  // returns the number of elements with a specific key
+  size_type count(const Key& key) const {
+    return tree_.contains(key) ? 1 : 0;
+  };
+
+  // returns an iterator to the first element not less than the given key
+  const_iterator lower_bound(const Key& key) const {
+    return tree_.lower_bound(key);
+  };
+
+  // returns an iterator to the first element greater than the given key
+  const_iterator upper_bound(const Key& key) const {
+    return tree_.upper_bound(key);
+  };
+
+  // returns range of elements matching a specific key
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key& key) const {
+    return {tree_.lower_bound(key), tree_.upper_bound(key)};
+  };
+
+  // returns the function object which compares the keys
+  key_compare key_comp() const { return tree_.key_comp(); };
+
+  // returns the allocator associated with the container
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
+ private:
+  tree tree_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_PERSISTENT_MAP_H_
@@ -0,0 +1,144 @@
+#ifndef SRC_S21_POOL_H_
+#define SRC_S21_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+/*
+    Implementation of the node pool
+    Node based containers allocate one node per element. Getting every node
+   from the heap makes inserts and erases pay for malloc/free and scatters
+   neighbouring nodes over memory. The pool instead hands out nodes from
+   contiguous chunks:
+
+    1. A node is taken from the free list if it is not empty, otherwise the
+   next untouched slot of the newest chunk is used. When the chunk is full a
+   new one twice as big is allocated (up to kMaxChunk slots).
+    2. A freed node is pushed on the free list and reused by the next
+   allocation.
+    3. release() gives back all chunks at once, so dropping all the nodes
+   costs O(chunks) instead of O(nodes).
+    4. reserve(n) allocates one chunk big enough for n nodes, so a container
+   which knows its size in advance (a copy) gets all its nodes in one block.
+
+    The pool only manages raw storage: constructing and destroying the objects
+   living in it is up to the owner. Chunks are taken from Allocator.
+*/
+
+namespace s21 {
+template <typename Node, typename Allocator = std::allocator<Node>>
+class NodePool {
+  using size_type = std::size_t;
+
+  // storage of one node; while the node is free it links the free list
+  union Slot {
+    Slot* next_;
+    alignas(Node) unsigned char storage_[sizeof(Node)];
+  };
+
+  // header of a chunk; it takes first slots of the chunk
+  struct Chunk {
+    Chunk* next_;
+    size_type size_;
+  };
+
+  using slot_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Slot>;
+  using slot_traits = std::allocator_traits<slot_allocator>;
+
+  static constexpr size_type kMinChunk = 16;
+  static constexpr size_type kMaxChunk = 4096;
+  // number of slots taken by the chunk header
+  static constexpr size_type kHeader =
+      (sizeof(Chunk) + sizeof(Slot) - 1) / sizeof(Slot);
+
+ public:
+  // default constructor. no memory is allocated until the first node
+  explicit NodePool(const Allocator& alloc = Allocator()) noexcept
+      : chunks_(nullptr),
+        free_(nullptr),
+        next_(nullptr),
+        last_(nullptr),
+        chunk_size_(kMinChunk),
+        chunk_count_(0),
+        alloc_(alloc){};
+
+  NodePool(const NodePool&) = delete;
+  NodePool& operator=(const NodePool&) = delete;
+
+  // destructor. frees all chunks
+  ~NodePool() { release(); };
+
+  // returns storage for one node
+  Node* allocate() {
+    Slot* slot = free_;
+    if (slot != nullptr) {
+      free_ = slot->next_;
+    } else {
+      if (next_ == last_) {
+        add_chunk(chunk_size_);
+        if (chunk_size_ < kMaxChunk) chunk_size_ *= 2;
+      }
+      slot = next_++;
+    }
+    return reinterpret_cast<Node*>(slot);
+  };
+
+  // puts node storage back to the pool
+  void deallocate(Node* node) noexcept {
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next_ = free_;
+    free_ = slot;
+  };
+
+  // frees every chunk. all the nodes given out become invalid
+  void release() noexcept {
+    while (chunks_ != nullptr) {
+      Chunk* next = chunks_->next_;
+      size_type size = chunks_->size_;
+      chunks_->~Chunk();
+      slot_traits::deallocate(alloc_, reinterpret_cast<Slot*>(chunks_),
+                              kHeader + size);
+      chunks_ = next;
+    }
+    free_ = next_ = last_ = nullptr;
+    chunk_size_ = kMinChunk;
+    chunk_count_ = 0;
+  };
+
+  // makes sure the next n allocations are served from one chunk. freed
+  // nodes are still reused first
+  void reserve(size_type n) {
+    if (static_cast<size_type>(last_ - next_) < n) add_chunk(n);
+  };
+
+  // returns the allocator the chunks are taken from
+  Allocator get_allocator() const noexcept { return Allocator(alloc_); };
+
+  // returns number of allocated chunks
+  size_type chunks() const noexcept { return chunk_count_; };
+
+ private:
+  // allocates a chunk of size slots and makes them available. untouched
+  // slots of the previous chunk are not used anymore
+  void add_chunk(size_type size) {
+    Slot* memory = slot_traits::allocate(alloc_, kHeader + size);
+    chunks_ = ::new (static_cast<void*>(memory)) Chunk{chunks_, size};
+    next_ = memory + kHeader;
+    last_ = next_ + size;
+    chunk_count_++;
+  };
+
+  Chunk* chunks_;           // list of allocated chunks, newest first
+  Slot* free_;              // list of freed slots
+  Slot* next_;              // first untouched slot of the newest chunk
+  Slot* last_;              // end of the newest chunk
+  size_type chunk_size_;    // number of slots in the next chunk
+  size_type chunk_count_;   // number of allocated chunks
+  slot_allocator alloc_;    // source of the chunks
+};
+}  // namespace s21
+
+#endif  // SRC_S21_POOL_H_
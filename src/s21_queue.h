@@ -4,7 +4,7 @@
 #include "s21_list.h"
 
 namespace s21 {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class queue {
   // ------------------------------ PUBLIC ------------------------------
  public:
@@ -16,14 +16,21 @@ class queue {
       const T &;  // const T & defines the type of the constant reference
   using size_type = std::size_t;  // Size_t defines the type of the container
                                   // size (standard type is size_t)
+  using allocator_type = Allocator;  // Allocator defines the type used to get
+                                     // memory for the elements
 
   // Queue Member functions
   // Default constructor, creates empty queue
   queue() : list_() {}
 
+  // Creates empty queue which gets its memory from alloc
+  explicit queue(const Allocator &alloc) : list_(alloc) {}
+
   // Initializer list constructor, creates list initizialized using
   // std::initializer_list
-  queue(std::initializer_list<value_type> const &items) : list_(items) {}
+  queue(std::initializer_list<value_type> const &items,
+        const Allocator &alloc = Allocator())
+      : list_(items, alloc) {}
 
   // Copy constructor
   queue(const queue &q) : list_(q.list_) {}
@@ -84,8 +91,13 @@ class queue {
 
   // ------------------------------ PRIVATE ------------------------------
  private:
-  s21::list<T> list_;
+  s21::list<T, Allocator> list_;
 };  // queue
+
+namespace pmr {
+template <typename T>
+using queue = s21::queue<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // SRC_S21_QUEUE_H
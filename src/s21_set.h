@@ -16,36 +16,91 @@
 */
 
 namespace s21 {
-template <typename Key>
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>, bool Threaded = false>
 class set {
   using key_type = Key;
   using value_type = Key;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using tree = RBTree<value_type>;
+  using tree = RBTree<value_type, IdentityKey<value_type>, Compare, Allocator,
+                      Threaded>;
   using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
 
  public:
   using iterator = typename tree::iterator;
   using const_iterator = typename tree::const_iterator;
+  using node_type = typename tree::node_type;
+  using insert_return_type = NodeInsertReturn<iterator, node_type>;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using allocator_type = Allocator;
 
   // default constructor, creates an empty set
   set() : tree_(){};
 
+  // creates an empty set ordered by comp which gets its memory from alloc
+  explicit set(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_(comp, alloc){};
+
+  // creates an empty set which gets its memory from alloc
+  explicit set(const Allocator& alloc) : tree_(alloc){};
+
   // initializer list constructor, creates the set initizialized using
   // std::initializer_list
-  set(std::initializer_list<value_type> const& items) {
+  set(std::initializer_list<value_type> const& items,
+      const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
     for (auto it : items) {
       tree_.insert(it);
     }
   };
 
+  // initializer list constructor with allocator
+  set(std::initializer_list<value_type> const& items, const Allocator& alloc)
+      : set(items, Compare(), alloc){};
+
+  // range constructor, creates the set from [first, last) in any order
+  template <typename InputIt, typename = if_iterator<InputIt>>
+  set(InputIt first, InputIt last, const Compare& comp = Compare(),
+      const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.assign(first, last, true);
+  };
+
+  // bulk load constructor, creates the set from [first, last) sorted by
+  // comp in O(n)
+  template <typename InputIt>
+  set(sorted_unique_t, InputIt first, InputIt last,
+      const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.assign_sorted(first, last, true);
+  };
+
+  // parallel range constructor, creates the set from random access range
+  // [first, last) in any order. the values are constructed, sorted and
+  // linked on policy.threads threads
+  template <typename RandomIt>
+  set(parallel_policy policy, RandomIt first, RandomIt last,
+      const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.assign(first, last, true, policy.threads);
+  };
+
   // copy constructor
   set(const set& s) : tree_(s.tree_){};
 
+  // copy constructor which gets memory from alloc
+  set(const set& s, const Allocator& alloc) : tree_(s.tree_, alloc){};
+
   // move constructor
   set(set&& s) : tree_(std::move(s.tree_)){};
 
+  // move constructor which gets memory from alloc
+  set(set&& s, const Allocator& alloc)
+      : tree_(std::move(s.tree_), alloc){};
+
   // default constructor
   ~set() = default;
 
@@ -67,9 +122,38 @@ class set {
     return tree_.insert(key);
   };
 
+  // inserts a node as close as possible to the position just before hint
+  // and returns an iterator to the element with this key. a correct hint
+  // saves the search, so sorted input is inserted in amortized O(1)
+  // comparisons
+  iterator insert(const_iterator hint, const_reference key) {
+    return tree_.insert(hint, key).first;
+  };
+
+  // same as hinted insert for the element constructed from args
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return tree_.emplace_hint(hint, std::forward<Args>(args)...).first;
+  };
+
   // erases an element at pos
   void erase(iterator pos) { tree_.erase(pos); };
 
+  // erases the elements of [first, last) and returns an iterator to last. a
+  // long range is cut out at once, so k elements take O(k + log n)
+  iterator erase(const_iterator first, const_iterator last) {
+    return tree_.erase(first, last);
+  };
+
+  // erases the element with key and returns the number of erased elements
+  size_type erase(const Key& key) { return tree_.erase_key(key); };
+
+  // erases all the elements pred returns true for and returns their number
+  template <typename Predicate>
+  size_type erase_if(Predicate pred) {
+    return tree_.erase_if(pred);
+  };
+
   // checks whether the container is empty
   bool empty() const noexcept { return tree_.empty(); };
 
@@ -82,11 +166,180 @@ class set {
   // clears the contents
   void clear() { tree_.clear(); };
 
+  // replaces the contents with the elements of [first, last) in any order
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last) {
+    tree_.assign(first, last, true);
+  };
+
+  // same for [first, last) sorted by key_comp(). builds a balanced tree
+  // in O(n)
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    tree_.assign_sorted(first, last, true);
+  };
+
+  // same as assign for random access range on policy.threads threads
+  template <typename RandomIt>
+  void assign(parallel_policy policy, RandomIt first, RandomIt last) {
+    tree_.assign(first, last, true, policy.threads);
+  };
+
+  // returns the function object which compares the keys
+  key_compare key_comp() const { return tree_.key_comp(); };
+
+  // returns the function object which compares the values
+  value_compare value_comp() const { return tree_.key_comp(); };
+
+  // returns the allocator associated with the container
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
   // swaps the contents
   void swap(set& other) { tree_.swap(other.tree_); };
 
   // splices nodes from another container
-  void merge(set& other) noexcept { tree_.merge(other.tree_); };
+  void merge(set& other) { tree_.merge(other.tree_); };
+
+  // node handles move elements between containers without copying them
+
+  // unlinks the element at pos and returns it in a node handle
+  node_type extract(const_iterator pos) { return tree_.extract(pos); };
+
+  // same for an element with key, empty handle if there is none
+  node_type extract(const_reference key) { return tree_.extract_key(key); };
+
+  // inserts the element owned by node. if the key is already there, the
+  // handle is given back in the result
+  insert_return_type insert(node_type&& node) {
+    std::pair<iterator, bool> res = tree_.insert(end(), std::move(node), true);
+    return {res.first, res.second, std::move(node)};
+  };
+
+  // same as insert of node as close as possible to the position just before
+  // hint. returns the element with the key of node
+  iterator insert(const_iterator hint, node_type&& node) {
+    return tree_.insert(hint, std::move(node), true).first;
+  };
+
+  // makes this empty set take its nodes from the pool of other, so that
+  // extracted nodes move between the two without moving the values. returns
+  // false if the set is not empty or the allocators differ. such
+  // containers must not be modified from different threads at the same time
+  bool share_pool(set& other) { return tree_.share_pool(other.tree_); };
+
+  // set algebra: the set becomes the union (intersection, difference,
+  // symmetric difference) of itself and other. the set is split by the
+  // elements of other and joined back, which takes O(m log(n / m + 1)) for
+  // sizes m <= n: only the elements of other that get into the result are
+  // copied, or moved out of an rvalue other, which is left empty. sets that
+  // share a pool give the nodes themselves away
+  void set_union(set&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kUnion, true);
+  };
+
+  // same, other is kept intact
+  void set_union(const set& other) {
+    tree_.set_operation(other.tree_, SetOperation::kUnion, true);
+  };
+
+  // same for intersection
+  void set_intersection(set&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kIntersection, true);
+  };
+
+  // same, other is kept intact
+  void set_intersection(const set& other) {
+    tree_.set_operation(other.tree_, SetOperation::kIntersection, true);
+  };
+
+  // same for difference
+  void set_difference(set&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kDifference, true);
+  };
+
+  // same, other is kept intact
+  void set_difference(const set& other) {
+    tree_.set_operation(other.tree_, SetOperation::kDifference, true);
+  };
+
+  // same for symmetric difference
+  void symmetric_difference(set&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kSymmetricDifference, true);
+  };
+
+  // same, other is kept intact
+  void symmetric_difference(const set& other) {
+    tree_.set_operation(other.tree_, SetOperation::kSymmetricDifference, true);
+  };
+
+  // set algebra on policy.threads threads: subtrees of big parts of both
+  // trees are combined in parallel. a copy of lvalue other is made on this
+  // thread, and the elements of an rvalue other from another pool are moved
+  // into this pool first
+  void set_union(parallel_policy policy, set&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kUnion, true,
+                        policy.threads);
+  };
+
+  // same, other is copied
+  void set_union(parallel_policy policy, const set& other) {
+    tree_.set_operation(other.tree_, SetOperation::kUnion, true,
+                        policy.threads);
+  };
+
+  // same for intersection
+  void set_intersection(parallel_policy policy, set&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kIntersection, true,
+                        policy.threads);
+  };
+
+  // same, other is copied
+  void set_intersection(parallel_policy policy, const set& other) {
+    tree_.set_operation(other.tree_, SetOperation::kIntersection, true,
+                        policy.threads);
+  };
+
+  // same for difference
+  void set_difference(parallel_policy policy, set&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kDifference, true,
+                        policy.threads);
+  };
+
+  // same, other is copied
+  void set_difference(parallel_policy policy, const set& other) {
+    tree_.set_operation(other.tree_, SetOperation::kDifference, true,
+                        policy.threads);
+  };
+
+  // same for symmetric difference
+  void symmetric_difference(parallel_policy policy, set&& other) {
+    tree_.set_operation(other.tree_, SetOperation::kSymmetricDifference, true,
+                        policy.threads);
+  };
+
+  // same, other is copied
+  void symmetric_difference(parallel_policy policy, const set& other) {
+    tree_.set_operation(other.tree_, SetOperation::kSymmetricDifference, true,
+                        policy.threads);
+  };
+
+  // calls func for every element in order and returns it
+  template <typename Function>
+  Function for_each(Function func) const {
+    auto visit = [&func](const_reference value) { func(value); };
+    tree_.for_each(visit);
+    return func;
+  };
+
+  // calls func for every element on policy.threads threads. each thread
+  // walks a run of consecutive elements, func is called concurrently
+  template <typename Function>
+  void for_each(parallel_policy policy, Function func) const {
+    auto visit = [&func](const_reference value) { func(value); };
+    tree_.for_each(visit, policy.threads);
+  };
 
   // finds an element with a specific key
   iterator find(const_reference key) { return tree_.find(key); };
@@ -97,6 +350,150 @@ class set {
   // checks if the container contains an element with a specific key
   bool contains(const_reference key) const { return tree_.contains(key); };
 
+  // returns the number of elements with a specific key. keys are unique, so
+  // one search is enough
+  size_type count(const_reference key) const {
+    return tree_.contains(key) ? 1 : 0;
+  };
+
+  // batched lookups of many keys at once. the searches run interleaved and
+  // prefetch their next nodes, so the cache misses of different keys
+  // overlap. this pays off for trees much bigger than the cache
+
+  // writes an iterator to the element with every key of random access range
+  // [first, last) to out, end() for a missing key. returns the end of output
+  template <typename RandomIt, typename OutputIt>
+  OutputIt find_batch(RandomIt first, RandomIt last, OutputIt out) {
+    return tree_.find_batch(first, last, out);
+  };
+
+  // same for const set
+  template <typename RandomIt, typename OutputIt>
+  OutputIt find_batch(RandomIt first, RandomIt last, OutputIt out) const {
+    return tree_.find_batch(first, last, out);
+  };
+
+  // writes whether the set contains every key of [first, last) to out
+  template <typename RandomIt, typename OutputIt>
+  OutputIt contains_batch(RandomIt first, RandomIt last, OutputIt out) const {
+    return tree_.contains_batch(first, last, out);
+  };
+
+  // returns an iterator to the first element not less than the given key
+  iterator lower_bound(const_reference key) { return tree_.lower_bound(key); };
+
+  // same for const set
+  const_iterator lower_bound(const_reference key) const {
+    return tree_.lower_bound(key);
+  };
+
+  // returns an iterator to the first element greater than the given key
+  iterator upper_bound(const_reference key) { return tree_.upper_bound(key); };
+
+  // same for const set
+  const_iterator upper_bound(const_reference key) const {
+    return tree_.upper_bound(key);
+  };
+
+  // returns range of elements matching a specific key
+  std::pair<iterator, iterator> equal_range(const_reference key) {
+    return tree_.equal_range(key);
+  };
+
+  // same for const set
+  std::pair<const_iterator, const_iterator> equal_range(
+      const_reference key) const {
+    return tree_.equal_range(key);
+  };
+
+  // order statistics. every node knows the size of its subtree, so these
+  // take O(log n)
+
+  // returns iterator to the element at position k in sorted order (counting
+  // from 0), end() if there is no such element
+  iterator nth(size_type k) { return tree_.nth(k); };
+
+  // same for const set
+  const_iterator nth(size_type k) const { return tree_.nth(k); };
+
+  // returns number of elements less than key
+  size_type rank(const_reference key) const { return tree_.rank(key); };
+
+  // returns number of increments needed to get from first to last
+  difference_type distance(const_iterator first, const_iterator last) const {
+    return tree_.distance(first, last);
+  };
+
+  // heterogeneous lookup: the overloads below take any key type comparable
+  // with key_type and are available only for transparent comparators
+
+  // finds an element with a key equivalent to key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  iterator find(const K& key) {
+    return tree_.find(key);
+  };
+
+  // same for const set
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  const_iterator find(const K& key) const {
+    return tree_.find(key);
+  };
+
+  // checks if the container contains an element equivalent to key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  bool contains(const K& key) const {
+    return tree_.contains(key);
+  };
+
+  // returns the number of elements equivalent to key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  size_type count(const K& key) const {
+    return tree_.count(key);
+  };
+
+  // returns an iterator to the first element not less than key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  iterator lower_bound(const K& key) {
+    return tree_.lower_bound(key);
+  };
+
+  // same for const set
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  const_iterator lower_bound(const K& key) const {
+    return tree_.lower_bound(key);
+  };
+
+  // returns an iterator to the first element greater than key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  iterator upper_bound(const K& key) {
+    return tree_.upper_bound(key);
+  };
+
+  // same for const set
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  const_iterator upper_bound(const K& key) const {
+    return tree_.upper_bound(key);
+  };
+
+  // returns range of elements equivalent to key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  std::pair<iterator, iterator> equal_range(const K& key) {
+    return tree_.equal_range(key);
+  };
+
+  // same for const set
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const K& key) const {
+    return tree_.equal_range(key);
+  };
+
+  // returns number of elements less than key
+  template <typename K, typename C = Compare, typename = if_transparent<C>>
+  size_type rank(const K& key) const {
+    return tree_.rank(key);
+  };
+
   // returns an iterator to the beginning
   iterator begin() noexcept { return tree_.begin(); };
 
@@ -109,16 +506,42 @@ class set {
   // returns an iterator to the end for const set
   const_iterator end() const noexcept { return tree_.end(); };
 
-  // inserts new elements into the container
+  // constructs an element from args in place and inserts it if there is no
+  // equivalent one. returns the element with its key and whether the
+  // insertion took place
   template <typename... Args>
-  std::vector<std::pair<iterator, bool>> emplace(Args&&... args) {
+  std::pair<iterator, bool> emplace(Args&&... args) {
     return tree_.emplace(std::forward<Args>(args)...);
   };
 
+  // inserts new elements into the container, one per argument
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    return tree_.insert_many(std::forward<Args>(args)...);
+  };
+
  private:
   // red black tree variable
   tree tree_;
 };
+
+// erases all the elements of c pred returns true for, returns their number
+template <typename Key, typename Compare, typename Allocator, bool Threaded,
+          typename Predicate>
+std::size_t erase_if(set<Key, Compare, Allocator, Threaded>& c,
+                     Predicate pred) {
+  return c.erase_if(pred);
+}
+
+// set whose iterators follow successor links instead of climbing the tree
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+using threaded_set = set<Key, Compare, Allocator, true>;
+
+namespace pmr {
+template <typename Key, typename Compare = std::less<Key>>
+using set = s21::set<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // SRC_S21_SET_H_
\ No newline at end of file
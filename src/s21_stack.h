@@ -8,7 +8,7 @@
 // #include <limits>
 
 namespace s21 {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class stack {
   // ------------------------------ PUBLIC ------------------------------
  public:
@@ -20,14 +20,21 @@ class stack {
       const T&;  // const T & defines the type of the constant reference
   using size_type = std::size_t;  // Size_t defines the type of the container
                                   // size (standard type is size_t)
+  using allocator_type = Allocator;  // Allocator defines the type used to get
+                                     // memory for the elements
 
   // Stack Member functions
   // Default constructor, creates empty list
   stack() : list_() {}
 
+  // Creates empty stack which gets its memory from alloc
+  explicit stack(const Allocator& alloc) : list_(alloc) {}
+
   // Initializer list constructor, creates list initizialized using
   // std::initializer_list
-  stack(std::initializer_list<value_type> const& items) : list_(items) {}
+  stack(std::initializer_list<value_type> const& items,
+        const Allocator& alloc = Allocator())
+      : list_(items, alloc) {}
 
   // Copy constructor
   stack(const stack& s) : list_(s.list_) {}
@@ -82,8 +89,13 @@ class stack {
 
   // ------------------------------ PRIVATE ------------------------------
  private:
-  s21::list<T> list_;
+  s21::list<T, Allocator> list_;
 };  // stack
+
+namespace pmr {
+template <typename T>
+using stack = s21::stack<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // SRC_S21_STACK_H
@@ -1,12 +1,24 @@
 #ifndef SRC_S21_TREE_H_
 #define SRC_S21_TREE_H_
 
+#include <algorithm>
+#include <cstdint>
+#include <exception>
 #include <initializer_list>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include "s21_parallel.h"
+#include "s21_pool.h"
+
 /* Implementation of the Red Black Tree
     A red-black tree is a binary search tree having following five additional
    properties (invariants).
@@ -20,80 +32,292 @@
    on a path can be red nodes.
     5. Every path from a root node to a NULL node has the same number of black
    nodes. (black height)
+
+    Nodes are taken from a NodePool owned by the tree, so insertions and
+   erasures do not go to the heap for every element and clear() gives the
+   memory back chunk by chunk. The end node (root_) is allocated on its own.
+
+    A sorted sequence can be linked into a balanced tree directly: the middle
+   element becomes the root and the halves are built the same way. Nodes of
+   the deepest level are red and all the others black, so every path has the
+   same number of black nodes and bulk loading takes O(n).
+
+    Nodes can be detached into node handles and linked again into a tree
+   sharing the pool without touching the value. A handle keeps the pool alive,
+   so it may outlive the tree it was extracted from.
+
+    Set algebra is built on two primitives: join(left, node, right) links two
+   trees and a node between them in O(|black height difference|), and
+   split(tree, key) cuts a tree into the parts less and greater than key in
+   O(log n). union, intersection, difference and symmetric difference split
+   both trees by the root of the smaller one and recurse into both halves.
+   Black heights are passed down with the subtrees, so no join has to walk
+   a spine to find them.
+
+    The halves of a split, of a bulk load and of a traversal are independent,
+   so they can be handed to different threads (see s21_parallel.h). Nothing
+   touches the pool while threads work: nodes are taken from it before and
+   dropped nodes are given back after.
+
+    Every node also keeps the number of nodes in its subtree (weight). It is
+   fixed up by rotations and on the path to the root after insertion and
+   deletion, and turns the tree into an order statistic tree: the k-th element,
+   the rank of a key and the distance between iterators take O(log n).
+
+    A node holds three links, the weight and the value, in this order. The
+   color takes the lowest bit of the parent link, which is always zero in a
+   node address, and the weight is 32-bit, so a node of a 4-byte value takes
+   32 bytes and one of an 8-byte value 40. A tree thus holds less than 2^32
+   elements.
+
+    A threaded tree (Threaded is true) also links every node to the next and
+   the previous one in sorted order. The links form a ring through the end
+   node, so moving an iterator is one load instead of a climb up the tree.
+   Insertion and erasure relink only the neighbours of the node, a bulk load
+   links the sorted nodes in a row. A copy and the result of set algebra are
+   relinked by one walk over the tree, so they take O(n) on threaded trees.
 */
 
 namespace s21 {
-template <typename Key>
-class RBTree {
+// key extractor for trees storing bare keys (set, multiset)
+template <typename Value>
+struct IdentityKey {
+  using key_type = Value;
+  const key_type& operator()(const Value& value) const noexcept {
+    return value;
+  };
+};
+
+// key extractor for trees storing key-value pairs (map)
+template <typename Pair>
+struct PairFirstKey {
+  using key_type = std::remove_const_t<typename Pair::first_type>;
+  const key_type& operator()(const Pair& value) const noexcept {
+    return value.first;
+  };
+};
+
+// keeps the comparator of the tree. empty comparators are stored as a base
+// class, so thanks to empty base optimization they take no space
+template <typename Compare, bool = std::is_empty<Compare>::value &&
+                                   !std::is_final<Compare>::value>
+class CompareHolder : private Compare {
+ public:
+  explicit CompareHolder(const Compare& comp) : Compare(comp){};
+  const Compare& comp() const noexcept { return *this; };
+  void swap_comp(CompareHolder&) noexcept {};
+};
+
+// stateful or final comparators are kept as a member
+template <typename Compare>
+class CompareHolder<Compare, false> {
+ public:
+  explicit CompareHolder(const Compare& comp) : comp_(comp){};
+  const Compare& comp() const noexcept { return comp_; };
+  void swap_comp(CompareHolder& other) {
+    using std::swap;
+    swap(comp_, other.comp_);
+  };
+
+ private:
+  Compare comp_;
+};
+
+// successor and predecessor links of the nodes of threaded trees
+template <typename NodePtr, bool Threaded>
+struct ThreadLinks {
+  NodePtr next_;
+  NodePtr prev_;
+};
+
+// nodes of other trees have no links, the empty base takes no space
+template <typename NodePtr>
+struct ThreadLinks<NodePtr, false> {};
+
+// enables heterogeneous lookup overloads of the containers only for
+// transparent comparators (the ones defining is_transparent)
+template <typename Compare>
+using if_transparent = typename Compare::is_transparent;
+
+// tags telling bulk constructors that the input is already sorted, without
+// duplicates (sorted_unique) or possibly with them (sorted_equivalent)
+struct sorted_unique_t {
+  explicit sorted_unique_t() = default;
+};
+inline constexpr sorted_unique_t sorted_unique{};
+
+struct sorted_equivalent_t {
+  explicit sorted_equivalent_t() = default;
+};
+inline constexpr sorted_equivalent_t sorted_equivalent{};
+
+// set algebra operations of the tree containers
+enum class SetOperation {
+  kUnion,
+  kIntersection,
+  kDifference,
+  kSymmetricDifference
+};
+
+// result of inserting a node handle into a container with unique keys. if
+// the key is already there, node keeps the handle which was passed in
+template <typename Iterator, typename NodeHandle>
+struct NodeInsertReturn {
+  Iterator position;
+  bool inserted;
+  NodeHandle node;
+};
+
+// enables range constructors of the containers only for iterators
+template <typename InputIt>
+using if_iterator = typename std::iterator_traits<InputIt>::iterator_category;
+
+// Key is the stored value type, KeyOfValue extracts the part of it the tree
+// is ordered and searched by, Compare orders the keys, Allocator provides
+// memory for the nodes, Threaded adds successor links to the nodes
+template <typename Key, typename KeyOfValue = IdentityKey<Key>,
+          typename Compare = std::less<typename KeyOfValue::key_type>,
+          typename Allocator = std::allocator<Key>, bool Threaded = false>
+class RBTree : private CompareHolder<Compare> {
+  using compare_holder = CompareHolder<Compare>;
+  using compare_holder::comp;
   class RBNode;
   class RBIterator;
   class RBConstIterator;
+  class RBNodeHandle;
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<RBNode>;
+  using node_traits = std::allocator_traits<node_allocator>;
   using reference = Key&;
   using const_reference = const Key&;
   using size_type = std::size_t;
-  using comparator = std::less<Key>;
+  using difference_type = std::ptrdiff_t;
+  using key_reference = const typename KeyOfValue::key_type&;
   using NodePtr = RBNode*;
+  using pool_type = NodePool<RBNode, node_allocator>;
 
   enum NodeColor { BLACK, RED };
 
+  // subtree sizes are 32-bit, so a node of a 4-byte value takes 32 bytes
+  using weight_type = std::uint32_t;
+  // bit of the parent link of a node which holds its color
+  static constexpr std::uintptr_t kColorBit = 1;
+  // shortest range erased by splitting the tree instead of node by node
+  static constexpr std::size_t kEraseSplitMin = 16;
+  // erase_if relinks the kept nodes if more than 1/kEraseRebuildRatio of
+  // the elements go
+  static constexpr std::size_t kEraseRebuildRatio = 8;
+  // number of searches a batched lookup runs at once
+  static constexpr std::size_t kBatchLanes = 16;
+  // number of keys whose results a batched lookup keeps before writing them
+  static constexpr std::size_t kBatchChunk = 256;
+
   //      =============== PUBLIC ===============
  public:
   using iterator = RBIterator;
   using const_iterator = RBConstIterator;
+  using node_type = RBNodeHandle;
   using value_type = Key;
+  using key_type = typename KeyOfValue::key_type;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
 
   // default constructor. creates root node
-  RBTree() : root_(new RBNode), size_(0){};
+  RBTree() : RBTree(Compare()){};
+
+  // creates empty tree ordered by comp which gets its memory from alloc
+  explicit RBTree(const Compare& comp, const Allocator& alloc = Allocator())
+      : compare_holder(comp), root_(nullptr), size_(0), alloc_(alloc) {
+    root_ = create_end_node();
+  };
+
+  // creates empty tree which gets its memory from alloc
+  explicit RBTree(const Allocator& alloc) : RBTree(Compare(), alloc){};
 
   // copy constructor
-  RBTree(const RBTree& other) : RBTree() { *this = other; };
+  RBTree(const RBTree& other)
+      : RBTree(other.comp(),
+               node_traits::select_on_container_copy_construction(
+                   other.alloc_)) {
+    copy_from(other);
+  };
+
+  // copy constructor which gets memory from alloc
+  RBTree(const RBTree& other, const Allocator& alloc)
+      : RBTree(other.comp(), alloc) {
+    copy_from(other);
+  };
 
   // move constructor
-  RBTree(RBTree&& other) : RBTree() { *this = std::move(other); };
+  RBTree(RBTree&& other) : RBTree(other.comp(), other.alloc_) {
+    swap_storage(other);
+  };
+
+  // move constructor which gets memory from alloc
+  RBTree(RBTree&& other, const Allocator& alloc)
+      : RBTree(other.comp(), alloc) {
+    move_from(other);
+  };
 
   // destructor
   ~RBTree() {
     clear();
-    delete_node(root_);
+    delete_end_node(root_);
   };
 
   // assignment copy overload
   RBTree& operator=(const RBTree& other) {
     if (this != &other) {
-      if (other.size_ == 0) {
-        clear();
-      } else {
-        if (root_->parent_) clear();
-        NodePtr root = copy(other.root_->parent_, nullptr);
-        root_->parent_ = root;
-        root_->parent_->parent_ = root;
-        root_->left_ = other.root_->left_;
-        root_->right_ = other.root_->right_;
-        size_ = other.size_;
+      if constexpr (node_traits::propagate_on_container_copy_assignment::
+                        value) {
+        if (alloc_ != other.alloc_) {
+          // nodes of the old allocator cannot be kept
+          clear();
+          pool_.reset();
+          delete_end_node(root_);
+          alloc_ = other.alloc_;
+          root_ = create_end_node();
+        }
       }
+      clear();
+      static_cast<compare_holder&>(*this) = other;
+      copy_from(other);
     }
     return *this;
   };
 
   // move overload
+  // nodes are taken over if the allocator is moved along or the allocators
+  // are equal, otherwise the values are moved one by one
   RBTree& operator=(RBTree&& other) {
     if (this != &other) {
       clear();
-      std::swap(this->root_, other.root_);
-      std::swap(this->size_, other.size_);
-    } else {
-      other.clear();
-      delete_node(other.root_);
+      if constexpr (node_traits::propagate_on_container_move_assignment::
+                        value) {
+        std::swap(this->alloc_, other.alloc_);
+        swap_contents(other);
+      } else {
+        static_cast<compare_holder&>(*this) = other;
+        move_from(other);
+      }
     }
     return *this;
   };
 
-  // returns iterator of the min element
-  iterator begin() noexcept { return iterator(root_->left_); };
+  // returns the allocator associated with the tree
+  allocator_type get_allocator() const noexcept { return alloc_; };
+
+  // returns the function object which compares the keys
+  key_compare key_comp() const { return comp(); };
+
+  // returns iterator of the min element, or end() if obj is empty
+  iterator begin() noexcept {
+    return iterator(root_->left_ ? root_->left_ : root_);
+  };
 
   // same for const obj
   const_iterator begin() const noexcept {
-    return const_iterator(root_->left_);
+    return const_iterator(root_->left_ ? root_->left_ : root_);
   };
 
   // returns iterator to root (end element)
@@ -109,25 +333,67 @@ class RBTree {
   size_type size() const noexcept { return size_; };
 
   // returns max possible number of elements
+  // it is also limited by the range of the weights
   size_type max_size() const noexcept {
-    return (std::numeric_limits<size_type>::max() / 2 - sizeof(RBNode) -
-            sizeof(RBTree)) /
-           sizeof(RBNode);
+    return std::min<size_type>(
+        (std::numeric_limits<size_type>::max() / 2 - sizeof(RBNode) -
+         sizeof(RBTree)) /
+            sizeof(RBNode),
+        std::numeric_limits<weight_type>::max());
   };
 
   // clears content of obj
+  // if no other tree shares the pool, its chunks are freed at once
   void clear() {
-    delete_all(root_->parent_);
-    root_->parent_ = nullptr;
+    if (pool_.use_count() == 1) {
+      if (!std::is_trivially_destructible<Key>::value)
+        destroy_all(root_->parent());
+      pool_->release();
+    } else {
+      delete_all(root_->parent());
+    }
+    root_->set_parent(nullptr);
     root_->left_ = nullptr;
     root_->right_ = nullptr;
+    clear_threads();
     size_ = 0;
   };
 
+  // replaces contents with the elements of [first, last) which is sorted by
+  // comp. if unique is true only the first of equivalent elements is kept
+  // the nodes are linked into a balanced tree without any search, so it
+  // takes O(n)
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last, bool unique) {
+    clear();
+    std::vector<NodePtr> nodes = create_nodes(first, last);
+    if (unique) remove_duplicates(nodes);
+    link_sorted(nodes);
+  };
+
+  // same for [first, last) in any order. the nodes are sorted before
+  // linking, equivalent elements keep their order
+  // with more than one thread the values of a random access range are
+  // constructed, sorted and linked in parallel
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last, bool unique,
+              size_type threads = 1) {
+    clear();
+    std::vector<NodePtr> nodes = create_nodes(first, last, threads);
+    parallel_stable_sort(
+        nodes.begin(), nodes.end(),
+        [this](NodePtr a, NodePtr b) {
+          return comp()(key_of(a->data_), key_of(b->data_));
+        },
+        threads);
+    if (unique) remove_duplicates(nodes);
+    link_sorted(nodes, threads);
+  };
+
   // inserts new element to obj
   // only unique elements are inserted
   std::pair<iterator, bool> insert(const value_type& value) {
-    NodePtr new_node = new RBNode(value);
+    NodePtr new_node = create_node(value);
     std::pair<iterator, bool> res = insert_node(new_node, true);
     if (!res.second) delete_node(new_node);
     return res;
@@ -136,46 +402,172 @@ class RBTree {
   // inserts new element to obj
   // dduplicates can be inserted too
   iterator insert_duplicate(const value_type& value) {
-    NodePtr new_node = new RBNode(value);
+    NodePtr new_node = create_node(value);
     return insert_node(new_node, false).first;
   };
 
+  // inserts new element as close as possible to the position just before
+  // hint. takes no search if the element belongs there
+  std::pair<iterator, bool> insert(const_iterator hint,
+                                   const value_type& value) {
+    return emplace_hint(hint, value);
+  };
+
+  // same for obj with duplicates
+  iterator insert_duplicate(const_iterator hint, const value_type& value) {
+    return emplace_hint_duplicate(hint, value);
+  };
+
+  // constructs new element from args and inserts it as close as possible to
+  // the position just before hint. only unique elements are inserted
+  template <typename... Args>
+  std::pair<iterator, bool> emplace_hint(const_iterator hint,
+                                         Args&&... args) {
+    NodePtr new_node = create_node(std::forward<Args>(args)...);
+    std::pair<iterator, bool> res = insert_node(hint, new_node, true);
+    if (!res.second) delete_node(new_node);
+    return res;
+  };
+
+  // same for obj with duplicates
+  template <typename... Args>
+  iterator emplace_hint_duplicate(const_iterator hint, Args&&... args) {
+    NodePtr new_node = create_node(std::forward<Args>(args)...);
+    return insert_node(hint, new_node, false).first;
+  };
+
   // erases element at pos
   void erase(iterator pos) { delete_node(pos); };
 
+  // erases elements of [first, last) and returns iterator to last
+  // a short range is erased element by element. a longer one is cut out of
+  // the tree by two splits by rank and the rest is joined back, so erasing
+  // k elements takes O(k + log n)
+  iterator erase(const_iterator first, const_iterator last) {
+    NodePtr stop = last.node_;
+    if (first == last) return iterator(stop);
+    size_type begin = index_of(first.node_);
+    size_type count = index_of(stop) - begin;
+    if (count == size_) {
+      clear();
+      return end();
+    }
+    if (count < kEraseSplitMin) {
+      while (first != last) delete_node(iterator((first++).node_));
+      return iterator(stop);
+    }
+    if constexpr (Threaded) {
+      NodePtr prev = first.node_->prev_;
+      prev->next_ = stop;
+      stop->prev_ = prev;
+    }
+    NodePtr root = root_->parent();
+    SplitPosition head = split_at({root, black_height(root)}, begin);
+    SplitPosition tail = split_at(head.second, count);
+    set_root(join(head.first, tail.second).root);
+    size_ -= count;
+    delete_all(tail.first.root);
+    return iterator(stop);
+  };
+
+  // erases all the elements equivalent to key and returns their number
+  template <typename K>
+  size_type erase_key(const K& key) {
+    std::pair<iterator, iterator> range = equal_range(key);
+    size_type before = size_;
+    erase(const_iterator(range.first), const_iterator(range.second));
+    return before - size_;
+  };
+
+  // erases all the elements pred returns true for and returns their number
+  // pred sees every element before anything is erased. if many elements
+  // go, the kept nodes are relinked into a balanced tree in O(n)
+  template <typename Predicate>
+  size_type erase_if(Predicate& pred) {
+    std::vector<NodePtr> kept, erased;
+    kept.reserve(size_);
+    for (NodePtr node = root_->left_; size_ > 0 && node != root_;
+         node = node->next()) {
+      const value_type& value = node->data_;
+      (pred(value) ? erased : kept).push_back(node);
+    }
+    if (erased.size() < size_ / kEraseRebuildRatio) {
+      for (NodePtr node : erased) delete_node(iterator(node));
+      return erased.size();
+    }
+    root_->set_parent(nullptr);
+    root_->left_ = root_->right_ = nullptr;
+    clear_threads();
+    size_ = 0;
+    for (NodePtr node : erased) delete_node(node);
+    link_sorted(kept);
+    return erased.size();
+  };
+
   // swaps the contents
   void swap(RBTree& other) {
-    using std::swap;
-    swap(root_, other.root_);
-    swap(size_, other.size_);
+    if constexpr (node_traits::propagate_on_container_swap::value)
+      std::swap(alloc_, other.alloc_);
+    swap_contents(other);
   };
 
+  // lookups are templates on the key type. containers pass key_type, or any
+  // type comparable with it if their comparator is transparent
+
   // returns iterator to element with key value
-  iterator find(const_reference key) noexcept {
-    iterator res = iterator(find_node(key));
-    if (res == end() || comparator{}(*res, key)) return end();
-    return res;
+  template <typename K>
+  iterator find(const K& key) noexcept {
+    return iterator(find_node(key));
   };
 
   // same for const obj
-  const_iterator find(const_reference key) const noexcept {
-    const_iterator res = lower_bound(key);
-    if (res == end() || comparator{}(*res, key)) return end();
-    return res;
+  template <typename K>
+  const_iterator find(const K& key) const noexcept {
+    return const_iterator(find_node(key));
   };
 
   // checks if obj contains such element
-  bool contains(const_reference key) const noexcept {
+  template <typename K>
+  bool contains(const K& key) const noexcept {
     NodePtr node = find_node(key);
     return (node != root_);
   };
 
+  // batched lookups. keys of [first, last) are searched in lockstep and
+  // the results are written to out in the order of the keys
+
+  // writes iterator to the element with every key, end() if there is none
+  template <typename RandomIt, typename OutputIt>
+  OutputIt find_batch(RandomIt first, RandomIt last, OutputIt out) {
+    auto write = [&out](NodePtr node) { *out++ = iterator(node); };
+    find_batch_nodes(first, last, write);
+    return out;
+  };
+
+  // same for const obj
+  template <typename RandomIt, typename OutputIt>
+  OutputIt find_batch(RandomIt first, RandomIt last, OutputIt out) const {
+    auto write = [&out](NodePtr node) { *out++ = const_iterator(node); };
+    find_batch_nodes(first, last, write);
+    return out;
+  };
+
+  // writes whether there is an element with every key
+  template <typename RandomIt, typename OutputIt>
+  OutputIt contains_batch(RandomIt first, RandomIt last,
+                          OutputIt out) const {
+    auto write = [this, &out](NodePtr node) { *out++ = node != root_; };
+    find_batch_nodes(first, last, write);
+    return out;
+  };
+
   // returns iterator to the greater element
-  iterator upper_bound(const_reference value) noexcept {
+  template <typename K>
+  iterator upper_bound(const K& value) noexcept {
     iterator result = end();
-    NodePtr begin = root_->parent_;
+    NodePtr begin = root_->parent();
     while (begin != nullptr) {
-      if (comparator{}(value, begin->data_)) {
+      if (comp()(value, key_of(begin->data_))) {
         result = iterator(begin);
         begin = begin->left_;
       } else
@@ -185,11 +577,12 @@ class RBTree {
   };
 
   // same for const obj
-  const_iterator upper_bound(const_reference value) const noexcept {
+  template <typename K>
+  const_iterator upper_bound(const K& value) const noexcept {
     const_iterator result = end();
-    NodePtr begin = root_->parent_;
+    NodePtr begin = root_->parent();
     while (begin != nullptr) {
-      if (comparator{}(value, begin->data_)) {
+      if (comp()(value, key_of(begin->data_))) {
         result = const_iterator(begin);
         begin = begin->left_;
       } else
@@ -200,11 +593,12 @@ class RBTree {
 
   // returns an iterator pointing to the first element in the range [first,last)
   // which does not compare less than key
-  iterator lower_bound(const_reference value) noexcept {
+  template <typename K>
+  iterator lower_bound(const K& value) noexcept {
     iterator result = end();
-    NodePtr begin = root_->parent_;
+    NodePtr begin = root_->parent();
     while (begin != nullptr) {
-      if (comparator{}(begin->data_, value)) {
+      if (comp()(key_of(begin->data_), value)) {
         begin = begin->right_;
       } else {
         result = iterator(begin);
@@ -215,11 +609,12 @@ class RBTree {
   };
 
   // same for const obj
-  const_iterator lower_bound(const_reference value) const noexcept {
+  template <typename K>
+  const_iterator lower_bound(const K& value) const noexcept {
     const_iterator result = end();
-    NodePtr begin = root_->parent_;
+    NodePtr begin = root_->parent();
     while (begin != nullptr) {
-      if (comparator{}(begin->data_, value)) {
+      if (comp()(key_of(begin->data_), value)) {
         begin = begin->right_;
       } else {
         result = const_iterator(begin);
@@ -230,104 +625,257 @@ class RBTree {
   };
 
   // returns number of elements which equal to key
-  size_type count(const_reference key) const noexcept {
-    const_iterator it = begin();
-    size_type c = 0;
-    for (size_type i = 0; i < size(); i++) {
-      if (*it == key) c++;
-      it++;
-    }
-    return c;
+  // it is the difference of the positions of the bounds, so takes O(log n)
+  template <typename K>
+  size_type count(const K& key) const noexcept {
+    std::pair<NodePtr, NodePtr> range = equal_range_nodes(key);
+    return index_of(range.second) - index_of(range.first);
   };
 
   // pair object whose member pair::first is an iterator to the lower bound of
   // the subrange of equivalent values and pair::second its upper bound
-  std::pair<iterator, iterator> equal_range(const_reference key) noexcept {
-    iterator start = lower_bound(key), end = upper_bound(key);
-    return {start, end};
+  template <typename K>
+  std::pair<iterator, iterator> equal_range(const K& key) noexcept {
+    std::pair<NodePtr, NodePtr> range = equal_range_nodes(key);
+    return {iterator(range.first), iterator(range.second)};
   };
 
   // same for const obj
+  template <typename K>
   std::pair<const_iterator, const_iterator> equal_range(
-      const_reference key) const noexcept {
-    const_iterator start = lower_bound(key), end = upper_bound(key);
-    return {start, end};
+      const K& key) const noexcept {
+    std::pair<NodePtr, NodePtr> range = equal_range_nodes(key);
+    return {const_iterator(range.first), const_iterator(range.second)};
+  };
+
+  // returns iterator to the element at position k in sorted order (counting
+  // from 0), end() if k is not less than size
+  iterator nth(size_type k) noexcept { return iterator(nth_node(k)); };
+
+  // same for const obj
+  const_iterator nth(size_type k) const noexcept {
+    return const_iterator(nth_node(k));
+  };
+
+  // returns number of elements less than key
+  template <typename K>
+  size_type rank(const K& key) const noexcept {
+    size_type result = 0;
+    NodePtr node = root_->parent();
+    while (node != nullptr) {
+      if (comp()(key_of(node->data_), key)) {
+        result += weight(node->left_) + 1;
+        node = node->right_;
+      } else {
+        node = node->left_;
+      }
+    }
+    return result;
+  };
+
+  // returns number of increments needed to get from first to last
+  difference_type distance(const_iterator first,
+                           const_iterator last) const noexcept {
+    return static_cast<difference_type>(index_of(last.node_)) -
+           static_cast<difference_type>(index_of(first.node_));
   };
 
   // move content of one obj to another
-  void merge_duplicates(RBTree& other) noexcept {
+  void merge_duplicates(RBTree& other) {
     if (this != &other) {
-      iterator it = other.begin();
-      while (other.size_ > 0) {
-        NodePtr node = it.node_;
-        it++;
-        if (node->parent_->left_ == node) node->parent_->left_ = nullptr;
-        if (node->parent_->right_ == node) node->parent_->right_ = nullptr;
-        if (node->right_) node->right_->parent_ = node->parent_;
-        if (node->left_) node->left_->parent_ = node->parent_;
-        node->left_ = nullptr;
-        node->right_ = nullptr;
-        node->parent_ = nullptr;
-        node->color_ = RED;
-        insert_node(node, false);
-        other.size_--;
-      }
-    }
-    other.root_->parent_ = nullptr;
-    other.size_ = 0;
+      while (other.size_ > 0)
+        insert_node(adopt_node(other, other.begin().node_), false);
+    }
+  };
+
+  // unlinks element at pos and gives it away in a node handle
+  node_type extract(const_iterator pos) {
+    if (pos == end()) return node_type();
+    return node_type(merge_node(pos.node_), pool_);
+  };
+
+  // same for an element equivalent to key, empty handle if there is none
+  template <typename K>
+  node_type extract_key(const K& key) {
+    return extract(const_iterator(find_node(key)));
+  };
+
+  // inserts the node owned by handle as close as possible to the position
+  // just before hint. a node of this tree's pool is linked as it is,
+  // otherwise its value is moved to a new node. if unique is true and there
+  // is an equivalent element the handle keeps the node
+  std::pair<iterator, bool> insert(const_iterator hint, node_type&& handle,
+                                   bool unique) {
+    if (handle.empty()) return {end(), false};
+    NodePtr node = handle.node_;
+    bool own = pool_ && handle.pool_ == pool_;
+    if (!own) {
+      if (unique) {
+        NodePtr found = find_node(key_of(node->data_));
+        if (found != root_) return {iterator(found), false};
+      }
+      node = create_node(std::move(node->data_));
+      handle.reset();
+    }
+    std::pair<iterator, bool> res = insert_node(hint, node, unique);
+    if (own && res.second) handle.release();
+    return res;
+  };
+
+  // makes empty tree take its nodes from the pool of other, so node handles
+  // move between the two without moving the values. returns false if the
+  // tree is not empty or the allocators differ
+  // the trees must not be modified concurrently afterwards
+  bool share_pool(RBTree& other) {
+    if (size_ != 0 || alloc_ != other.alloc_) return false;
+    if (this == &other) return true;
+    if (!other.pool_)
+      other.pool_ = std::allocate_shared<pool_type>(alloc_, alloc_);
+    pool_ = other.pool_;
+    return true;
   };
 
   // move contents of one obj to another
   // with no duplicates
   // all the duplicates stay in the other tree
-  void merge(RBTree& other) noexcept {
+  void merge(RBTree& other) {
     if (this != &other) {
       iterator it = other.begin();
       while (it != other.end()) {
-        if (find(it.node_->data_) == end()) {
+        if (find(key_of(it.node_->data_)) == end()) {
           NodePtr node = it.node_;
           it++;
-          node = other.merge_node(node);
-          insert_node(node, true);
+          insert_node(adopt_node(other, node), true);
         } else
           it++;
       }
     }
   };
 
-  // inserts new elements into the container
+  // replaces contents with the result of op over this tree and other. nodes
+  // of both trees are reused and other is left empty. if other takes its
+  // nodes from another pool, a unique tree on one thread moves only the
+  // values which get into the result to this pool, otherwise all the values
+  // of other are moved to this pool first
+  // with unique false equivalent elements are counted as std::set_union and
+  // others do for sorted ranges
+  // subtrees are combined on up to threads threads
+  void set_operation(RBTree& other, SetOperation op, bool unique,
+                     size_type threads = 1) {
+    if (this == &other) {
+      if (op == SetOperation::kDifference ||
+          op == SetOperation::kSymmetricDifference)
+        clear();
+      return;
+    }
+    if (other.size_ > 0 && (!pool_ || pool_ != other.pool_)) {
+      if (unique && threads < 2) {
+        combine_foreign<true>(other, op);
+        other.clear();
+        return;
+      }
+      RBTree own(comp(), alloc_);
+      own.share_pool(*this);
+      own.assign_sorted(std::make_move_iterator(other.begin()),
+                        std::make_move_iterator(other.end()), false);
+      other.clear();
+      set_operation(own, op, unique, threads);
+      return;
+    }
+    NodePtr root = root_->parent(), other_root = other.root_->parent();
+    Dropped dropped;
+    NodePtr result = combine({root, black_height(root)},
+                             {other_root, black_height(other_root)}, op,
+                             unique, dropped, threads)
+                         .root;
+    other.root_->set_parent(nullptr);
+    other.root_->left_ = other.root_->right_ = nullptr;
+    other.clear_threads();
+    other.size_ = 0;
+    finish_operation(result, dropped);
+  };
+
+  // same as set_operation but other stays intact. a unique tree on one
+  // thread copies only the elements of other which get into the result,
+  // otherwise other is copied first on this thread
+  void set_operation(const RBTree& other, SetOperation op, bool unique,
+                     size_type threads = 1) {
+    if (unique && threads < 2 && this != &other) {
+      combine_foreign<false>(other, op);
+      return;
+    }
+    RBTree copy(comp(), alloc_);
+    copy.share_pool(*this);
+    copy.copy_from(other);
+    set_operation(copy, op, unique, threads);
+  };
+
+  // calls func for every element in order. with more than one thread the
+  // elements are split into runs of consecutive ranks, each run is walked
+  // by one thread and func is called concurrently
+  template <typename Function>
+  void for_each(Function& func, size_type threads = 1) const {
+    auto walk = [this, &func](size_type first, size_type last) {
+      NodePtr node = nth_node(first);
+      for (size_type i = first; i < last; i++, node = node->next())
+        func(node->data_);
+    };
+    parallel_for(0, size_, threads, walk);
+  };
+
+  // constructs new element from args right in its node and inserts it
+  // only unique elements are inserted
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    NodePtr new_node = create_node(std::forward<Args>(args)...);
+    std::pair<iterator, bool> res = insert_node(new_node, true);
+    if (!res.second) delete_node(new_node);
+    return res;
+  };
+
+  // same for obj with duplicates
   template <typename... Args>
-  std::vector<std::pair<iterator, bool>> emplace(Args&&... args) {
+  iterator emplace_duplicate(Args&&... args) {
+    NodePtr new_node = create_node(std::forward<Args>(args)...);
+    return insert_node(new_node, false).first;
+  };
+
+  // constructs new element from args only if there is no element
+  // equivalent to key. the lower bound found by the search is the hint
+  // the new node is linked at
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+    iterator pos = lower_bound(key);
+    if (pos != end() && !comp()(key, key_of(*pos))) return {pos, false};
+    NodePtr new_node = create_node(std::forward<Args>(args)...);
+    return insert_node(const_iterator(pos), new_node, true);
+  };
+
+  // inserts new elements into the container, each constructed in its node
+  // from one of args
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
     std::vector<std::pair<iterator, bool>> vect;
     vect.reserve(sizeof...(args));
-    for (auto element : {std::forward<Args>(args)...}) {
-      NodePtr new_node = new RBNode(std::move(element));
-      std::pair<iterator, bool> result = insert_node(new_node, true);
-      if (result.second == false) {
-        delete new_node;
-      }
-      vect.push_back(result);
-    }
+    (vect.push_back(emplace(std::forward<Args>(args))), ...);
     return vect;
-  }
+  };
 
   // inserts new elements into the container with duplicates
   template <typename... Args>
-  std::vector<std::pair<iterator, bool>> emplace_duplicate(Args&&... args) {
+  std::vector<std::pair<iterator, bool>> insert_many_duplicate(
+      Args&&... args) {
     std::vector<std::pair<iterator, bool>> vect;
     vect.reserve(sizeof...(args));
-    for (auto element : {std::forward<Args>(args)...}) {
-      NodePtr new_node = new RBNode(std::move(element));
-      vect.push_back(insert_node(new_node, false));
-    }
+    (vect.push_back({emplace_duplicate(std::forward<Args>(args)), true}), ...);
     return vect;
-  }
+  };
 
   //      =============== PRINT FUNCS ===============
 
   void print() noexcept {
-    if (root_->parent_ != nullptr) {
-      print(root_->parent_, "", true);
+    if (root_->parent() != nullptr) {
+      print(root_->parent(), "", true);
     }
   };
 
@@ -346,7 +894,7 @@ class RBTree {
         std::cout << "L----";
         indent += "|    ";
       }
-      std::string color = (node->color_ == RED) ? "RED" : "BLACK";
+      std::string color = (node->color() == RED) ? "RED" : "BLACK";
       std::cout << node->data_ << "(" << color << ")" << std::endl;
       print(node->left_, indent, false);
       print(node->right_, indent, true);
@@ -355,18 +903,74 @@ class RBTree {
 
   //      =============== TREE FUNCS ===============
 
+  // copies contents of other into empty tree
+  // all the nodes are taken from one block of the pool
+  void copy_from(const RBTree& other) {
+    if (other.size_ == 0) return;
+    pool().reserve(other.size_);
+    NodePtr root = copy(other.root_->parent(), root_);
+    root_->set_parent(root);
+    root_->left_ = search_left(root);
+    root_->right_ = search_right(root);
+    size_ = other.size_;
+    thread_all();
+  };
+
+  // takes nodes of other if they come from the same allocator, otherwise
+  // moves the values one by one into empty tree. the comparator is kept
+  void move_from(RBTree& other) {
+    if (alloc_ == other.alloc_) {
+      swap_storage(other);
+    } else {
+      for (iterator it = other.begin(); it != other.end(); ++it)
+        insert_node(create_node(std::move(*it)), false);
+      other.clear();
+    }
+  };
+
+  // swaps comparators, nodes, sizes and pools but not the allocators
+  void swap_contents(RBTree& other) noexcept {
+    compare_holder::swap_comp(other);
+    swap_storage(other);
+  };
+
+  // swaps nodes, sizes and pools only
+  void swap_storage(RBTree& other) noexcept {
+    using std::swap;
+    swap(root_, other.root_);
+    swap(size_, other.size_);
+    swap(pool_, other.pool_);
+  };
+
+  // returns the part of the value the tree is ordered by
+  static key_reference key_of(const_reference value) noexcept {
+    return KeyOfValue{}(value);
+  };
+
   // inserts node in Red Black Tree
   // if unique is true, elements with no duplicates are inserted
   // else: duplicates can be iserted too
   std::pair<iterator, bool> insert_node(NodePtr new_node, bool unique) {
+    key_reference key = key_of(new_node->data_);
+    // keys coming in ascending or descending order go next to the cached max
+    // or min element without a descent
+    if (size_ > 0) {
+      if (unique ? comp()(key_of(root_->right_->data_), key)
+                 : !comp()(key, key_of(root_->right_->data_)))
+        return {link_node(new_node, root_->right_, false), true};
+      if (comp()(key, key_of(root_->left_->data_)))
+        return {link_node(new_node, root_->left_, true), true};
+    }
     // searching place to insert the node
-    NodePtr node = root_->parent_;
+    NodePtr node = root_->parent();
     NodePtr parent = nullptr;
+    bool left = false;
     while (node != nullptr) {
       parent = node;
-      if (comparator{}(new_node->data_, node->data_))
+      left = comp()(key, key_of(node->data_));
+      if (left)
         node = node->left_;
-      else if (comparator{}(node->data_, new_node->data_))
+      else if (comp()(key_of(node->data_), key))
         node = node->right_;
       else if (unique == false)
         node = node->right_;  // case when none-unique element can be inserted
@@ -375,17 +979,54 @@ class RBTree {
             iterator(node),
             false};  // return element if our tree does not contain duplicates
     }
+    return {link_node(new_node, parent, left), true};
+  };
+
+  // inserts node as close as possible to the position just before hint
+  // if the node belongs there, it is linked without a descent
+  std::pair<iterator, bool> insert_node(const_iterator hint, NodePtr new_node,
+                                        bool unique) {
+    NodePtr pos = hint.node_;
+    key_reference key = key_of(new_node->data_);
+    if (size_ == 0 || pos == root_) return insert_node(new_node, unique);
+    if (unique ? comp()(key, key_of(pos->data_))
+               : !comp()(key_of(pos->data_), key)) {
+      // the node goes before pos; it fits if it also goes after the
+      // previous node
+      if (pos == root_->left_)
+        return {link_node(new_node, pos, true), true};
+      NodePtr prev = pos->prev();
+      if (unique ? comp()(key_of(prev->data_), key)
+                 : !comp()(key, key_of(prev->data_))) {
+        // either pos has no left child or prev is the max of it and has no
+        // right child
+        if (pos->left_ == nullptr)
+          return {link_node(new_node, pos, true), true};
+        return {link_node(new_node, prev, false), true};
+      }
+    } else if (unique && !comp()(key_of(pos->data_), key)) {
+      return {iterator(pos), false};
+    }
+    // wrong hint
+    return insert_node(new_node, unique);
+  };
+
+  // links new node as a child of parent (as root if parent is nullptr) and
+  // balances the tree
+  iterator link_node(NodePtr new_node, NodePtr parent, bool left) noexcept {
     // since insertion is happening size is increasing
     size_++;
+    new_node->weight_ = 1;
+    for (NodePtr up = parent; up != nullptr && up != root_; up = up->parent())
+      up->weight_++;
     // insertion
     if (parent == nullptr) {  // case when inserting 1st element (root)
-      new_node->parent_ = root_;
-      root_->parent_ = new_node;
-      new_node->color_ = BLACK;
+      new_node->set_parent(root_);
+      root_->set_parent(new_node);
+      new_node->set_color(BLACK);
     } else {
-      new_node->parent_ = parent;
-      comparator{}(new_node->data_, parent->data_) ? parent->left_ = new_node
-                                                   : parent->right_ = new_node;
+      new_node->set_parent(parent);
+      left ? parent->left_ = new_node : parent->right_ = new_node;
     }
     // put ptr of the max element to root node
     if (!root_->right_ || root_->right_->right_) {
@@ -395,22 +1036,211 @@ class RBTree {
     }
     // put ptr of the min element to root node
     if (!root_->left_ || root_->left_->left_) root_->left_ = new_node;
+    if constexpr (Threaded) {
+      // a left child goes right before its parent, a right one right after
+      NodePtr next = parent == nullptr ? root_
+                     : left            ? parent
+                                       : parent->next_;
+      new_node->next_ = next;
+      new_node->prev_ = next->prev_;
+      next->prev_->next_ = new_node;
+      next->prev_ = new_node;
+    }
     // balancing after insertion
     balance_insert(new_node);
-    return {iterator(new_node), true};
+    return iterator(new_node);
+  };
+
+  // creates nodes for the elements of [first, last) in the same order
+  template <typename InputIt>
+  std::vector<NodePtr> create_nodes(InputIt first, InputIt last,
+                                    size_type threads = 1) {
+    std::vector<NodePtr> nodes;
+    if constexpr (std::is_base_of<std::random_access_iterator_tag,
+                                  if_iterator<InputIt>>::value) {
+      if (threads > 1) return create_nodes_parallel(first, last, threads);
+    }
+    if constexpr (std::is_base_of<std::forward_iterator_tag,
+                                  typename std::iterator_traits<
+                                      InputIt>::iterator_category>::value) {
+      size_type count = std::distance(first, last);
+      nodes.reserve(count);
+      pool().reserve(count);
+    }
+    try {
+      for (; first != last; ++first) {
+        nodes.push_back(nullptr);
+        nodes.back() = create_node(*first);
+      }
+    } catch (...) {
+      for (NodePtr node : nodes) delete_node(node);
+      throw;
+    }
+    return nodes;
   };
 
-  // frees node and nulls all the ptrs
+  // same for random access range on threads threads. the storage is taken
+  // from the pool here, the values are constructed in parallel
+  template <typename RandomIt>
+  std::vector<NodePtr> create_nodes_parallel(RandomIt first, RandomIt last,
+                                             size_type threads) {
+    size_type count = last - first;
+    std::vector<NodePtr> nodes(count);
+    std::vector<unsigned char> built(count, 0);
+    pool().reserve(count);
+    for (NodePtr& node : nodes) node = pool_->allocate();
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto build = [&](size_type begin, size_type end) {
+      try {
+        for (size_type i = begin; i < end; i++) {
+          ::new (static_cast<void*>(nodes[i])) RBNode;
+          node_traits::construct(alloc_, std::addressof(nodes[i]->data_),
+                                 first[i]);
+          built[i] = 1;
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) error = std::current_exception();
+      }
+    };
+    parallel_for(0, count, threads, build);
+    if (error) {
+      for (size_type i = 0; i < count; i++) {
+        if (built[i])
+          delete_node(nodes[i]);
+        else
+          pool_->deallocate(nodes[i]);
+      }
+      std::rethrow_exception(error);
+    }
+    return nodes;
+  };
+
+  // deletes every node equivalent to the one kept before it
+  void remove_duplicates(std::vector<NodePtr>& nodes) {
+    size_type kept = 0;
+    for (NodePtr node : nodes) {
+      if (kept > 0 &&
+          !comp()(key_of(nodes[kept - 1]->data_), key_of(node->data_)))
+        delete_node(node);
+      else
+        nodes[kept++] = node;
+    }
+    nodes.resize(kept);
+  };
+
+  // links sorted nodes into empty tree
+  void link_sorted(const std::vector<NodePtr>& nodes,
+                   size_type threads = 1) noexcept {
+    if (nodes.empty()) return;
+    size_type depth = 0;  // depth of the deepest level
+    for (size_type n = nodes.size(); n > 1; n /= 2) depth++;
+    NodePtr root =
+        link_range(nodes, 0, nodes.size(), 0, depth, root_, threads);
+    root->set_color(BLACK);
+    root_->set_parent(root);
+    root_->left_ = nodes.front();
+    root_->right_ = nodes.back();
+    size_ = nodes.size();
+    if constexpr (Threaded) {
+      auto thread = [this, &nodes](size_type begin, size_type end) {
+        for (size_type i = begin; i < end; i++) {
+          nodes[i]->prev_ = i > 0 ? nodes[i - 1] : root_;
+          nodes[i]->next_ = i + 1 < nodes.size() ? nodes[i + 1] : root_;
+        }
+      };
+      parallel_for(0, nodes.size(), threads, thread);
+      root_->next_ = nodes.front();
+      root_->prev_ = nodes.back();
+    }
+  };
+
+  // makes the middle of nodes [begin, end) root of a subtree and links the
+  // halves under it. nodes of the deepest level are red, others are black
+  // big halves are linked on different threads if there are threads
+  NodePtr link_range(const std::vector<NodePtr>& nodes, size_type begin,
+                     size_type end, size_type depth, size_type max_depth,
+                     NodePtr parent, size_type threads = 1) noexcept {
+    if (begin == end) return nullptr;
+    size_type middle = begin + (end - begin) / 2;
+    NodePtr node = nodes[middle];
+    node->set_parent(parent);
+    if (threads < 2 || end - begin < 2 * kParallelGrain) threads = 1;
+    fork_join(
+        threads,
+        [&](size_type part) {
+          node->left_ = link_range(nodes, begin, middle, depth + 1,
+                                   max_depth, node, part);
+        },
+        [&](size_type part) {
+          node->right_ = link_range(nodes, middle + 1, end, depth + 1,
+                                    max_depth, node, part);
+        });
+    node->set_color((depth == max_depth && depth > 0) ? RED : BLACK);
+    node->weight_ = static_cast<weight_type>(end - begin);
+    return node;
+  };
+
+  // allocates node in the pool and constructs its value from args
+  template <typename... Args>
+  NodePtr create_node(Args&&... args) {
+    NodePtr node = pool().allocate();
+    ::new (static_cast<void*>(node)) RBNode;
+    try {
+      node_traits::construct(alloc_, std::addressof(node->data_),
+                             std::forward<Args>(args)...);
+    } catch (...) {
+      pool_->deallocate(node);
+      throw;
+    }
+    return node;
+  };
+
+  // returns the pool of the tree, creating it on first use
+  pool_type& pool() {
+    if (!pool_) pool_ = std::allocate_shared<pool_type>(alloc_, alloc_);
+    return *pool_;
+  };
+
+  // destroys node and gives its memory back to the pool
   void delete_node(NodePtr node) {
     if (node != nullptr) {
-      node->left_ = nullptr;
-      node->right_ = nullptr;
-      node->parent_ = nullptr;
-      delete node;
-      node = nullptr;
+      node_traits::destroy(alloc_, std::addressof(node->data_));
+      pool_->deallocate(node);
     }
   };
 
+  // allocates end node outside of the pool. it holds default value
+  NodePtr create_end_node() {
+    NodePtr node = node_traits::allocate(alloc_, 1);
+    ::new (static_cast<void*>(node)) RBNode;
+    try {
+      node_traits::construct(alloc_, std::addressof(node->data_));
+    } catch (...) {
+      node_traits::deallocate(alloc_, node, 1);
+      throw;
+    }
+    if constexpr (Threaded) node->next_ = node->prev_ = node;
+    return node;
+  };
+
+  // destroys end node
+  void delete_end_node(NodePtr node) noexcept {
+    node_traits::destroy(alloc_, std::addressof(node->data_));
+    node_traits::deallocate(alloc_, node, 1);
+  };
+
+  // takes node out of other tree. nodes of a foreign pool cannot be linked
+  // in, so the value is moved to a node of this tree's pool first: if that
+  // throws, the node is still in other
+  NodePtr adopt_node(RBTree& other, NodePtr node) {
+    if (pool_ && pool_ == other.pool_) return other.merge_node(node);
+    NodePtr own = create_node(std::move(node->data_));
+    other.delete_node(other.merge_node(node));
+    return own;
+  };
+
   // left rotations for red black tree balancing
   void left_rotate(NodePtr node) noexcept {
     NodePtr help_node = node->right_;
@@ -418,23 +1248,26 @@ class RBTree {
     node->right_ = help_node->left_;
     // if not empty change its parent ptr
     if (help_node->left_ != nullptr) {
-      help_node->left_->parent_ = node;
+      help_node->left_->set_parent(node);
     }
     // change help_node parent to node parent
-    help_node->parent_ = node->parent_;
+    help_node->set_parent(node->parent());
     // change node parent's child
     // 1st case if node is the 1st element
-    if (node->parent_ == root_) {
-      root_->parent_ = help_node;
+    if (node->parent() == root_) {
+      root_->set_parent(help_node);
       // if node is a left child
-    } else if (node == node->parent_->left_) {
-      node->parent_->left_ = help_node;
+    } else if (node == node->parent()->left_) {
+      node->parent()->left_ = help_node;
       // if node is a right child
     } else {
-      node->parent_->right_ = help_node;
+      node->parent()->right_ = help_node;
     }
     help_node->left_ = node;
-    node->parent_ = help_node;
+    node->set_parent(help_node);
+    // help_node takes the place and so the whole subtree of node
+    help_node->weight_ = node->weight_;
+    update_weight(node);
   };
 
   // right rotations for red black tree balancing
@@ -442,18 +1275,20 @@ class RBTree {
     NodePtr help_node = node->left_;
     node->left_ = help_node->right_;
     if (help_node->right_ != nullptr) {
-      help_node->right_->parent_ = node;
+      help_node->right_->set_parent(node);
     }
-    help_node->parent_ = node->parent_;
-    if (root_->parent_ == node) {
-      root_->parent_ = help_node;
-    } else if (node == node->parent_->right_) {
-      node->parent_->right_ = help_node;
-    } else if (node == node->parent_->left_) {
-      node->parent_->left_ = help_node;
+    help_node->set_parent(node->parent());
+    if (root_->parent() == node) {
+      root_->set_parent(help_node);
+    } else if (node == node->parent()->right_) {
+      node->parent()->right_ = help_node;
+    } else if (node == node->parent()->left_) {
+      node->parent()->left_ = help_node;
     }
     help_node->right_ = node;
-    node->parent_ = help_node;
+    node->set_parent(help_node);
+    help_node->weight_ = node->weight_;
+    update_weight(node);
   };
 
   /*
@@ -479,46 +1314,46 @@ class RBTree {
   */
   void balance_insert(NodePtr node) noexcept {
     NodePtr u;
-    while (node->parent_->color_ == RED && node != root_->parent_) {
-      if (node->parent_ == node->parent_->parent_->right_) {
-        u = node->parent_->parent_->left_;
+    while (node->parent()->color() == RED && node != root_->parent()) {
+      if (node->parent() == node->parent()->parent()->right_) {
+        u = node->parent()->parent()->left_;
         // if uncle color is red too, then colorflip
-        if (u != nullptr && u->color_ == RED) {  // case 3.1
-          u->color_ = BLACK;
-          node->parent_->color_ = BLACK;
-          node->parent_->parent_->color_ = RED;
+        if (u != nullptr && u->color() == RED) {  // case 3.1
+          u->set_color(BLACK);
+          node->parent()->set_color(BLACK);
+          node->parent()->parent()->set_color(RED);
           // change ptr for the next cycle
-          node = node->parent_->parent_;
+          node = node->parent()->parent();
           // if uncle is black and p is g's right child
         } else {
-          if (node == node->parent_->left_) {  // 3.2.2
-            node = node->parent_;
+          if (node == node->parent()->left_) {  // 3.2.2
+            node = node->parent();
             right_rotate(node);
           }
-          node->parent_->color_ = BLACK;  // case 3.2.1
-          node->parent_->parent_->color_ = RED;
-          left_rotate(node->parent_->parent_);
+          node->parent()->set_color(BLACK);  // case 3.2.1
+          node->parent()->parent()->set_color(RED);
+          left_rotate(node->parent()->parent());
         }
       } else {
-        u = node->parent_->parent_->right_;
-        if (u != nullptr && u->color_ == RED) {  // case 3.1
-          u->color_ = BLACK;
-          node->parent_->color_ = BLACK;
-          node->parent_->parent_->color_ = RED;
+        u = node->parent()->parent()->right_;
+        if (u != nullptr && u->color() == RED) {  // case 3.1
+          u->set_color(BLACK);
+          node->parent()->set_color(BLACK);
+          node->parent()->parent()->set_color(RED);
           // change ptr for the next cycle
-          node = node->parent_->parent_;
+          node = node->parent()->parent();
         } else {
-          if (node == node->parent_->right_) {  // case 3.2.4
-            node = node->parent_;
+          if (node == node->parent()->right_) {  // case 3.2.4
+            node = node->parent();
             left_rotate(node);
           }
-          node->parent_->color_ = BLACK;  // case 3.2.3
-          node->parent_->parent_->color_ = RED;
-          right_rotate(node->parent_->parent_);
+          node->parent()->set_color(BLACK);  // case 3.2.3
+          node->parent()->parent()->set_color(RED);
+          right_rotate(node->parent()->parent());
         }
       }
     }
-    root_->parent_->color_ = BLACK;  // make sure root node stays black
+    root_->parent()->set_color(BLACK);  // make sure root node stays black
   };
 
   // returns min node of tree
@@ -539,47 +1374,239 @@ class RBTree {
 
   // swaps nodes
   void swap_nodes(NodePtr one, NodePtr two) noexcept {
-    two == two->parent_->left_ ? two->parent_->left_ = one
-                               : two->parent_->right_ = one;
-    if (one == root_->parent_)
-      root_->parent_ = two;
+    two == two->parent()->left_ ? two->parent()->left_ = one
+                               : two->parent()->right_ = one;
+    if (one == root_->parent())
+      root_->set_parent(two);
     else
-      one == one->parent_->left_ ? one->parent_->left_ = two
-                                 : one->parent_->right_ = two;
+      one == one->parent()->left_ ? one->parent()->left_ = two
+                                 : one->parent()->right_ = two;
     std::swap(one->left_, two->left_);
     std::swap(one->right_, two->right_);
-    std::swap(one->parent_, two->parent_);
-    // swapping colors too because pointers are being swapped not values
-    // we swap pointers for the iterators to stay valid
-    std::swap(one->color_, two->color_);
-    if (one->left_) one->left_->parent_ = one;
-    if (one->right_) one->right_->parent_ = one;
-    if (two->left_) two->left_->parent_ = two;
-    if (two->right_) two->right_->parent_ = two;
-  };
-
-  // finds node with key value
-  NodePtr find_node(const_reference key) const noexcept {
-    NodePtr ptr = root_->parent_;
+    // swapping colors too (they share the word with the parent) because
+    // pointers are being swapped not values. we swap pointers for the
+    // iterators to stay valid
+    std::swap(one->parent_color_, two->parent_color_);
+    std::swap(one->weight_, two->weight_);
+    if (one->left_) one->left_->set_parent(one);
+    if (one->right_) one->right_->set_parent(one);
+    if (two->left_) two->left_->set_parent(two);
+    if (two->right_) two->right_->set_parent(two);
+  };
+
+  // returns number of nodes in subtree of node
+  static size_type weight(NodePtr node) noexcept {
+    return node ? node->weight_ : 0;
+  };
+
+  // recomputes weight of node from its children
+  static void update_weight(NodePtr node) noexcept {
+    node->weight_ = static_cast<weight_type>(weight(node->left_) +
+                                             weight(node->right_) + 1);
+  };
+
+  // decrements weights of all the ancestors of node before it is unlinked
+  void decrease_weights(NodePtr node) noexcept {
+    for (NodePtr up = node->parent(); up != root_; up = up->parent())
+      up->weight_--;
+  };
+
+  // links neighbours of node to each other before node is unlinked
+  static void unthread(NodePtr node) noexcept {
+    if constexpr (Threaded) {
+      node->prev_->next_ = node->next_;
+      node->next_->prev_ = node->prev_;
+    }
+  };
+
+  // links all the nodes in sorted order by a walk over the tree
+  void thread_all() noexcept {
+    if constexpr (Threaded) {
+      NodePtr prev = root_;
+      for (NodePtr node = root_->left_; size_ > 0 && node != root_;
+           node = node->successor()) {
+        prev->next_ = node;
+        node->prev_ = prev;
+        prev = node;
+      }
+      prev->next_ = root_;
+      root_->prev_ = prev;
+    }
+  };
+
+  // closes the ring of links of empty tree on the end node
+  void clear_threads() noexcept {
+    if constexpr (Threaded) root_->next_ = root_->prev_ = root_;
+  };
+
+  // returns node at position k in sorted order, root_ if k is out of range
+  NodePtr nth_node(size_type k) const noexcept {
+    if (k >= size_) return root_;
+    NodePtr node = root_->parent();
+    while (true) {
+      size_type left = weight(node->left_);
+      if (k < left) {
+        node = node->left_;
+      } else if (k == left) {
+        return node;
+      } else {
+        k -= left + 1;
+        node = node->right_;
+      }
+    }
+  };
+
+  // returns position of node in sorted order, size for the end node
+  size_type index_of(NodePtr node) const noexcept {
+    if (node == root_) return size_;
+    size_type result = weight(node->left_);
+    for (; node->parent() != root_; node = node->parent())
+      if (node == node->parent()->right_)
+        result += weight(node->parent()->left_) + 1;
+    return result;
+  };
+
+  // finds node with key value, root_ if there is no such node
+  // descends like lower_bound with one comparison per level, the found node
+  // is equivalent to key if key is not less than it
+  template <typename K>
+  NodePtr find_node(const K& key) const noexcept {
+    NodePtr ptr = root_->parent();
+    NodePtr result = root_;
     while (ptr) {
-      if (ptr->data_ == key) return ptr;
-      if (comparator{}(ptr->data_, key))
+      if (comp()(key_of(ptr->data_), key)) {
         ptr = ptr->right_;
-      else
+      } else {
+        result = ptr;
         ptr = ptr->left_;
+      }
     }
-    return root_;
+    if (result != root_ && comp()(key, key_of(result->data_))) return root_;
+    return result;
   };
 
-  NodePtr find_node(iterator pos) const noexcept {
-    NodePtr res = find_node(*pos);
-    return res;
+  // a search is a chain of dependent cache misses, one per level. the
+  // searches of a batch are interleaved instead: each of kBatchLanes lanes
+  // takes one step down in turn and prefetches the child it goes to, and a
+  // lane whose search is over takes the next key. so while a lane waits for
+  // its node the others work and up to kBatchLanes misses are in flight
+
+  // passes find_node of every key of [first, last) to write in order. keys
+  // are taken in chunks of kBatchChunk, the results of a chunk are kept
+  // here until all of its searches are over
+  template <typename RandomIt, typename Write>
+  void find_batch_nodes(RandomIt first, RandomIt last, Write& write) const {
+    NodePtr nodes[kBatchChunk];
+    while (first != last) {
+      size_type count =
+          std::min<size_type>(static_cast<size_type>(last - first),
+                              kBatchChunk);
+      find_chunk(first, count, nodes);
+      for (size_type i = 0; i < count; i++) write(nodes[i]);
+      first += count;
+    }
+  };
+
+  // stores find_node of keys[i] to nodes[i] for i below count
+  template <typename RandomIt>
+  void find_chunk(RandomIt keys, size_type count,
+                  NodePtr* nodes) const noexcept {
+    // search state of one key: the node to compare with next and the last
+    // node not less than the key
+    struct Lane {
+      NodePtr node;
+      NodePtr result;
+      size_type index;
+    };
+    NodePtr root = root_->parent();
+    if (root == nullptr) {
+      std::fill(nodes, nodes + count, root_);
+      return;
+    }
+    Lane lanes[kBatchLanes];
+    size_type active = 0, next = 0;
+    for (; active < kBatchLanes && next < count; active++, next++)
+      lanes[active] = {root, root_, next};
+    while (active > 0) {
+      for (size_type i = 0; i < active;) {
+        Lane& lane = lanes[i];
+        const auto& key = keys[lane.index];
+        if (comp()(key_of(lane.node->data_), key)) {
+          lane.node = lane.node->right_;
+        } else {
+          lane.result = lane.node;
+          lane.node = lane.node->left_;
+        }
+        if (lane.node != nullptr) {
+          prefetch(lane.node);
+          i++;
+          continue;
+        }
+        NodePtr result = lane.result;
+        if (result != root_ && comp()(key, key_of(result->data_)))
+          result = root_;
+        nodes[lane.index] = result;
+        // the root is in the cache, so the new search starts right away
+        if (next < count)
+          lane = {root, root_, next++};
+        else
+          lane = lanes[--active];
+      }
+    }
+  };
+
+  // asks the processor to bring node into the cache before it is used
+  static void prefetch(NodePtr node) noexcept {
+#if defined(__GNUC__)
+    __builtin_prefetch(node);
+    __builtin_prefetch(std::addressof(node->data_));
+#else
+    (void)node;
+#endif
+  };
+
+  // returns the first node not less than key and the first node greater than
+  // key (root_ if there is none). both bounds share the descent down to the
+  // first node equivalent to key and then are searched in its two subtrees
+  template <typename K>
+  std::pair<NodePtr, NodePtr> equal_range_nodes(const K& key) const noexcept {
+    NodePtr ptr = root_->parent();
+    NodePtr upper = root_;
+    while (ptr) {
+      if (comp()(key_of(ptr->data_), key)) {
+        ptr = ptr->right_;
+      } else if (comp()(key, key_of(ptr->data_))) {
+        upper = ptr;
+        ptr = ptr->left_;
+      } else {
+        NodePtr lower = ptr;
+        for (NodePtr left = ptr->left_; left;) {
+          if (comp()(key_of(left->data_), key)) {
+            left = left->right_;
+          } else {
+            lower = left;
+            left = left->left_;
+          }
+        }
+        for (NodePtr right = ptr->right_; right;) {
+          if (comp()(key, key_of(right->data_))) {
+            upper = right;
+            right = right->left_;
+          } else {
+            right = right->right_;
+          }
+        }
+        return {lower, upper};
+      }
+    }
+    return {upper, upper};
   };
 
   // deletion of the node
   void delete_node(iterator pos) {
     if (pos == end()) return;  // cannot delete root
     NodePtr node = pos.node_;
+    unthread(node);
     if (node->left_ &&
         node->right_) {  // case when node has two children. we just swap it
                          // with the max element in its left subtree
@@ -600,22 +1627,24 @@ class RBTree {
     // after swapping and prepairing for the delete operation
     // we need to check if the node is black
     // if so, we should balance the tree so black height will not be violated
-    if (node->color_ == BLACK && (!node->left_ && !node->right_)) {
+    if (node->color() == BLACK && (!node->left_ && !node->right_)) {
       balance_delete(node);
     }
+    // the node is a leaf now, its ancestors lose one node in their subtrees
+    decrease_weights(node);
     // if node is the first element
-    if (root_->parent_ == node) {
-      root_->parent_ = nullptr;
+    if (root_->parent() == node) {
+      root_->set_parent(nullptr);
       root_->right_ = nullptr;
       root_->left_ = nullptr;
     } else {
       // else we remove pointer to the node in its parent
-      node->parent_->left_ == node ? node->parent_->left_ = nullptr
-                                   : node->parent_->right_ = nullptr;
+      node->parent()->left_ == node ? node->parent()->left_ = nullptr
+                                   : node->parent()->right_ = nullptr;
       // if node is min element in tree we change it to another element
-      if (root_->left_ == node) root_->left_ = search_left(root_->parent_);
+      if (root_->left_ == node) root_->left_ = search_left(root_->parent());
       // same for case when it is the max element
-      if (root_->right_ == node) root_->right_ = search_right(root_->parent_);
+      if (root_->right_ == node) root_->right_ = search_right(root_->parent());
     }
     // deletion
     delete_node(node);
@@ -627,26 +1656,34 @@ class RBTree {
   // the process is similar to deletion but it does not delete the node
   NodePtr merge_node(NodePtr node) {
     if (node != root_) {  // cannot extract root
+      unthread(node);
       if (node->right_ && node->left_) {
         NodePtr swap = search_right(node->left_);
         swap_nodes(node, swap);
       }
       if (node->right_ && !node->left_) swap_nodes(node, node->right_);
       if (node->left_ && !node->right_) swap_nodes(node, node->left_);
-      if (node->color_ == BLACK && (!node->right_ && !node->left_))
+      if (node->color() == BLACK && (!node->right_ && !node->left_))
         balance_delete(node);
-      if (root_->left_ == node) root_->left_ = node->successor();
-      if (root_->right_ == node) root_->right_ = node->predecessor();
-      if (root_->parent_ == node)
-        root_->parent_ = nullptr;
-      else
-        node->parent_->left_ == node ? node->parent_->left_ = nullptr
-                                     : node->parent_->right_ = nullptr;
+      decrease_weights(node);
+      if (root_->parent() == node) {
+        root_->set_parent(nullptr);
+        root_->left_ = nullptr;
+        root_->right_ = nullptr;
+      } else {
+        node->parent()->left_ == node ? node->parent()->left_ = nullptr
+                                     : node->parent()->right_ = nullptr;
+        // the node was swapped down, so its neighbours are not the ones of
+        // the extracted value anymore
+        if (root_->left_ == node) root_->left_ = search_left(root_->parent());
+        if (root_->right_ == node)
+          root_->right_ = search_right(root_->parent());
+      }
       size_--;
       node->left_ = nullptr;
       node->right_ = nullptr;
-      node->parent_ = nullptr;
-      node->color_ = RED;
+      node->set_parent(nullptr);
+      node->set_color(RED);
       return node;
     }
     return nullptr;
@@ -669,136 +1706,623 @@ class RBTree {
   */
   void balance_delete(NodePtr node) {
     NodePtr s = nullptr;  // sibling
-    while (node != root_->parent_ && node->color_ == BLACK) {
-      if (node == node->parent_->left_) {
-        s = node->parent_->right_;
-        if (s->color_ == RED) {  // case 1
-          std::swap(s->color_, node->parent_->color_);
-          left_rotate(node->parent_);
-          s = node->parent_->right_;  // change sibling for next cycle
+    while (node != root_->parent() && node->color() == BLACK) {
+      if (node == node->parent()->left_) {
+        s = node->parent()->right_;
+        if (s->color() == RED) {  // case 1
+          NodeColor color = s->color();
+          s->set_color(node->parent()->color());
+          node->parent()->set_color(color);
+          left_rotate(node->parent());
+          s = node->parent()->right_;  // change sibling for next cycle
         }
-        if (s->color_ == BLACK && (!s->left_ || s->left_->color_ == BLACK) &&
-            (!s->right_ || s->right_->color_ == BLACK)) {
-          s->color_ = RED;  // case 2
-          if (node->parent_->color_ == RED) {
-            node->parent_->color_ = BLACK;
+        if (s->color() == BLACK && (!s->left_ || s->left_->color() == BLACK) &&
+            (!s->right_ || s->right_->color() == BLACK)) {
+          s->set_color(RED);  // case 2
+          if (node->parent()->color() == RED) {
+            node->parent()->set_color(BLACK);
             break;
           }
-          node = node->parent_;
+          node = node->parent();
         } else {  // if sibling is black and has two children
           if (!s->right_ ||
-              s->right_->color_ == BLACK) {  // case when right child is black
+              s->right_->color() == BLACK) {  // case when right child is black
                                              // (we need to make it red)
-            s->color_ = RED;                 // case 3
-            s->left_->color_ = BLACK;
+            s->set_color(RED);  // case 3
+            s->left_->set_color(BLACK);
             right_rotate(s);
-            s = node->parent_->right_;
+            s = node->parent()->right_;
           }  // case 4
-          s->color_ = node->parent_->color_;
-          s->right_->color_ = BLACK;
-          node->parent_->color_ = BLACK;
-          left_rotate(node->parent_);
+          s->set_color(node->parent()->color());
+          s->right_->set_color(BLACK);
+          node->parent()->set_color(BLACK);
+          left_rotate(node->parent());
           break;
         }
       } else {
-        s = node->parent_->left_;
-        if (s->color_ == RED) {  // case 1
-          std::swap(s->color_, node->parent_->color_);
-          right_rotate(node->parent_);
-          s = node->parent_->left_;
+        s = node->parent()->left_;
+        if (s->color() == RED) {  // case 1
+          NodeColor color = s->color();
+          s->set_color(node->parent()->color());
+          node->parent()->set_color(color);
+          right_rotate(node->parent());
+          s = node->parent()->left_;
         }
-        if (s->color_ == BLACK && (!s->left_ || s->left_->color_ == BLACK) &&
-            (!s->right_ || s->right_->color_ == BLACK)) {
-          s->color_ = RED;  // case 2
-          if (node->parent_->color_ == RED) {
-            node->parent_->color_ = BLACK;
+        if (s->color() == BLACK && (!s->left_ || s->left_->color() == BLACK) &&
+            (!s->right_ || s->right_->color() == BLACK)) {
+          s->set_color(RED);  // case 2
+          if (node->parent()->color() == RED) {
+            node->parent()->set_color(BLACK);
             break;
           }
-          node = node->parent_;
+          node = node->parent();
         } else {
-          if (!s->left_ || s->left_->color_ == BLACK) {
-            s->color_ = RED;  // case 3
-            s->right_->color_ = BLACK;
+          if (!s->left_ || s->left_->color() == BLACK) {
+            s->set_color(RED);  // case 3
+            s->right_->set_color(BLACK);
             left_rotate(s);
-            s = node->parent_->left_;
+            s = node->parent()->left_;
           }
-          s->color_ = node->parent_->color_;  // case 4
-          s->left_->color_ = BLACK;
-          node->parent_->color_ = BLACK;
-          right_rotate(node->parent_);
+          s->set_color(node->parent()->color());  // case 4
+          s->left_->set_color(BLACK);
+          node->parent()->set_color(BLACK);
+          right_rotate(node->parent());
           break;
         }
       }
     }
-    root_->parent_->color_ = BLACK;
+    root_->parent()->set_color(BLACK);
   };
 
-  // recursive deletion of tree contents
+  // deletion of tree contents
   void delete_all(NodePtr node) {
-    if (node == nullptr) return;
-    delete_all(node->left_);
-    delete_all(node->right_);
-    delete_node(node);
+    drop_all(node, [this](NodePtr dropped) { delete_node(dropped); });
   };
 
-  // recursive copy of tree contents
+  // destruction of values. memory is left to the pool
+  void destroy_all(NodePtr node) noexcept {
+    drop_all(node, [this](NodePtr dropped) {
+      node_traits::destroy(alloc_, std::addressof(dropped->data_));
+    });
+  };
+
+  // calls drop for every node of subtree without recursion: while the node
+  // has a left child it is rotated up, so the node to drop never has one
+  // and the walk goes on with its right child. links of the subtree are
+  // spoiled, it is dropped entirely anyway
+  template <typename Drop>
+  static void drop_all(NodePtr node, Drop drop) {
+    while (node != nullptr) {
+      NodePtr left = node->left_;
+      if (left != nullptr) {
+        node->left_ = left->right_;
+        left->right_ = node;
+        node = left;
+      } else {
+        NodePtr right = node->right_;
+        drop(node);
+        node = right;
+      }
+    }
+  };
+
+  // copy of tree contents without recursion. the source is walked in
+  // preorder by parent links: a child is copied when the copy has none yet,
+  // otherwise both walks go up. with Move the values are moved
+  template <bool Move = false>
   NodePtr copy(NodePtr copy_node, NodePtr parent) {
-    NodePtr new_node = new RBNode(copy_node);
-    if (copy_node->left_) new_node->left_ = copy(copy_node->left_, new_node);
-    if (copy_node->right_) new_node->right_ = copy(copy_node->right_, new_node);
-    new_node->parent_ = parent;
+    NodePtr root = clone_node<Move>(copy_node, parent);
+    NodePtr new_node = root;
+    try {
+      while (new_node != parent) {
+        if (copy_node->left_ && !new_node->left_) {
+          new_node->left_ = clone_node<Move>(copy_node->left_, new_node);
+          copy_node = copy_node->left_;
+          new_node = new_node->left_;
+        } else if (copy_node->right_ && !new_node->right_) {
+          new_node->right_ = clone_node<Move>(copy_node->right_, new_node);
+          copy_node = copy_node->right_;
+          new_node = new_node->right_;
+        } else {
+          copy_node = copy_node->parent();
+          new_node = new_node->parent();
+        }
+      }
+    } catch (...) {
+      delete_all(root);
+      throw;
+    }
+    return root;
+  };
+
+  // creates unlinked copy of node under parent
+  template <bool Move = false>
+  NodePtr clone_node(NodePtr node, NodePtr parent) {
+    NodePtr new_node = take_value<Move>(node);
+    new_node->set_color(node->color());
+    new_node->weight_ = node->weight_;
+    new_node->set_parent(parent);
     return new_node;
   };
 
+  //      =============== SET ALGEBRA ===============
+
+  // the functions below work on detached subtrees: the root may be red and
+  // its parent link is not used. all the nodes belong to the pool of the tree
+
+  // subtrees dropped by a set operation. they are deleted after it is done,
+  // so that threads combining different subtrees do not share the pool
+  // the roots are chained by their parent links
+  struct Dropped {
+    NodePtr first = nullptr;
+    NodePtr last = nullptr;
+
+    // adds subtree to the list
+    void add(NodePtr subtree) noexcept {
+      if (subtree == nullptr) return;
+      subtree->set_parent(nullptr);
+      if (last != nullptr)
+        last->set_parent(subtree);
+      else
+        first = subtree;
+      last = subtree;
+    };
+
+    // moves all the subtrees of other to the end of the list
+    void splice(Dropped& other) noexcept {
+      if (other.first == nullptr) return;
+      if (last != nullptr)
+        last->set_parent(other.first);
+      else
+        first = other.first;
+      last = other.last;
+      other.first = other.last = nullptr;
+    };
+  };
+
+  // detached subtree together with its black height
+  struct Subtree {
+    NodePtr root;
+    size_type height;  // number of black nodes on a path from root to a leaf
+  };
+
+  // parts of a subtree split by a key
+  struct SplitResult {
+    Subtree less;     // elements less than the key
+    Subtree equal;    // elements equivalent to the key
+    Subtree greater;  // elements greater than the key
+  };
+
+  // checks if node is red. leaves are black
+  static bool is_red(NodePtr node) noexcept {
+    return node != nullptr && node->color() == RED;
+  };
+
+  // returns number of black nodes on the path from node down to a leaf
+  static size_type black_height(NodePtr node) noexcept {
+    size_type height = 0;
+    for (; node != nullptr; node = node->left_)
+      if (node->color() == BLACK) height++;
+    return height;
+  };
+
+  // returns black height of both children of a subtree
+  static size_type child_height(Subtree tree) noexcept {
+    return tree.root->color() == BLACK ? tree.height - 1 : tree.height;
+  };
+
+  // makes node root of subtree with children left and right
+  static NodePtr make_node(NodePtr left, NodePtr node, NodePtr right,
+                           NodeColor color) noexcept {
+    node->left_ = left;
+    node->right_ = right;
+    node->set_color(color);
+    if (left != nullptr) left->set_parent(node);
+    if (right != nullptr) right->set_parent(node);
+    update_weight(node);
+    return node;
+  };
+
+  // left rotation of subtree, returns its new root
+  static NodePtr rotate_left(NodePtr node) noexcept {
+    NodePtr top = node->right_;
+    node->right_ = top->left_;
+    if (node->right_ != nullptr) node->right_->set_parent(node);
+    top->left_ = node;
+    node->set_parent(top);
+    top->weight_ = node->weight_;
+    update_weight(node);
+    return top;
+  };
+
+  // right rotation of subtree, returns its new root
+  static NodePtr rotate_right(NodePtr node) noexcept {
+    NodePtr top = node->left_;
+    node->left_ = top->right_;
+    if (node->left_ != nullptr) node->left_->set_parent(node);
+    top->right_ = node;
+    node->set_parent(top);
+    top->weight_ = node->weight_;
+    update_weight(node);
+    return top;
+  };
+
+  // links left, node and right into one subtree. nothing in left may be
+  // greater and nothing in right less than node
+  // roots are made black, then the lower tree hangs in place of a black
+  // node of the same black height on the inner spine of the higher one
+  static Subtree join(Subtree left, NodePtr node, Subtree right) noexcept {
+    if (is_red(left.root)) {
+      left.root->set_color(BLACK);
+      left.height++;
+    }
+    if (is_red(right.root)) {
+      right.root->set_color(BLACK);
+      right.height++;
+    }
+    if (left.height == right.height)
+      return {make_node(left.root, node, right.root, RED), left.height};
+    Subtree top = left.height > right.height
+                      ? Subtree{join_right(left, node, right), left.height}
+                      : Subtree{join_left(left, node, right), right.height};
+    if (is_red(top.root) && (is_red(top.root->left_) ||
+                             is_red(top.root->right_))) {
+      top.root->set_color(BLACK);
+      top.height++;
+    }
+    return top;
+  };
+
+  // join for higher left subtree: goes down its right spine
+  // a red node made on the way may get a red right child, it is fixed by a
+  // rotation at the black node above
+  static NodePtr join_right(Subtree left, NodePtr node,
+                            Subtree right) noexcept {
+    if (!is_red(left.root) && left.height == right.height)
+      return make_node(left.root, node, right.root, RED);
+    NodePtr child = join_right({left.root->right_, child_height(left)}, node,
+                               right);
+    left.root->right_ = child;
+    child->set_parent(left.root);
+    update_weight(left.root);
+    if (!is_red(left.root) && is_red(child) && is_red(child->right_)) {
+      child->right_->set_color(BLACK);
+      return rotate_left(left.root);
+    }
+    return left.root;
+  };
+
+  // same for higher right subtree
+  static NodePtr join_left(Subtree left, NodePtr node,
+                           Subtree right) noexcept {
+    if (!is_red(right.root) && right.height == left.height)
+      return make_node(left.root, node, right.root, RED);
+    NodePtr child = join_left(left, node,
+                              {right.root->left_, child_height(right)});
+    right.root->left_ = child;
+    child->set_parent(right.root);
+    update_weight(right.root);
+    if (!is_red(right.root) && is_red(child) && is_red(child->left_)) {
+      child->left_->set_color(BLACK);
+      return rotate_right(right.root);
+    }
+    return right.root;
+  };
+
+  // cuts off the max node of subtree and returns the rest
+  static Subtree split_last(Subtree tree, NodePtr& last) noexcept {
+    NodePtr node = tree.root;
+    Subtree left = {node->left_, child_height(tree)};
+    if (node->right_ == nullptr) {
+      last = node;
+      node->left_ = nullptr;
+      return left;
+    }
+    Subtree rest = split_last({node->right_, left.height}, last);
+    return join(left, node, rest);
+  };
+
+  // links two subtrees, nothing in right may be less than in left
+  static Subtree join(Subtree left, Subtree right) noexcept {
+    if (left.root == nullptr) return right;
+    if (right.root == nullptr) return left;
+    NodePtr last = nullptr;
+    Subtree rest = split_last(left, last);
+    return join(rest, last, right);
+  };
+
+  // splits subtree by key. the equivalent element of a unique tree is the
+  // one found on the way down, otherwise both subtrees below it are split
+  // further to collect all the equivalent elements
+  template <typename K>
+  SplitResult split(Subtree tree, const K& key, bool unique) const noexcept {
+    if (tree.root == nullptr) return {};
+    NodePtr node = tree.root;
+    Subtree left = {node->left_, child_height(tree)};
+    Subtree right = {node->right_, left.height};
+    if (comp()(key, key_of(node->data_))) {
+      SplitResult parts = split(left, key, unique);
+      parts.greater = join(parts.greater, node, right);
+      return parts;
+    }
+    if (comp()(key_of(node->data_), key)) {
+      SplitResult parts = split(right, key, unique);
+      parts.less = join(left, node, parts.less);
+      return parts;
+    }
+    if (unique) {
+      make_node(nullptr, node, nullptr, BLACK);
+      return {left, {node, 1}, right};
+    }
+    SplitResult lower = split(left, key, false);
+    SplitResult upper = split(right, key, false);
+    return {lower.less, join(lower.equal, node, upper.equal), upper.greater};
+  };
+
+  // parts of a subtree split by a position
+  using SplitPosition = std::pair<Subtree, Subtree>;
+
+  // splits subtree into its first k elements and the rest
+  static SplitPosition split_at(Subtree tree, size_type k) noexcept {
+    if (tree.root == nullptr) return {};
+    NodePtr node = tree.root;
+    Subtree left = {node->left_, child_height(tree)};
+    Subtree right = {node->right_, left.height};
+    size_type left_size = weight(node->left_);
+    if (k <= left_size) {
+      SplitPosition parts = split_at(left, k);
+      parts.second = join(parts.second, node, right);
+      return parts;
+    }
+    SplitPosition parts = split_at(right, k - left_size - 1);
+    parts.first = join(left, node, parts.first);
+    return parts;
+  };
+
+  // makes detached subtree the whole tree. threads are left as they are
+  void set_root(NodePtr root) noexcept {
+    root_->set_parent(root);
+    if (root != nullptr) {
+      root->set_parent(root_);
+      root->set_color(BLACK);
+      root_->left_ = search_left(root);
+      root_->right_ = search_right(root);
+    } else {
+      root_->left_ = root_->right_ = nullptr;
+    }
+  };
+
+  // creates unlinked node with the value of node of another tree, moved
+  // with Move and copied otherwise
+  template <bool Move>
+  NodePtr take_value(NodePtr node) {
+    if constexpr (Move)
+      return create_node(std::move(node->data_));
+    else
+      return create_node(node->data_);
+  };
+
+  // deletes the subtrees dropped by a set operation and makes result the
+  // whole tree
+  void finish_operation(NodePtr result, Dropped& dropped) {
+    for (NodePtr next; dropped.first != nullptr; dropped.first = next) {
+      next = dropped.first->parent();
+      delete_all(dropped.first);
+    }
+    set_root(result);
+    size_ = weight(result);
+    thread_all();
+  };
+
+  // replaces contents of unique tree with the result of op over it and
+  // other, which takes its nodes from another pool. only the values of
+  // other which get into the result are taken, moved with Move. other is
+  // left as it is
+  // if taking a value throws, the rest of other is left out and the
+  // exception is rethrown once the tree is whole again
+  template <bool Move, typename Tree>
+  void combine_foreign(Tree& other, SetOperation op) {
+    NodePtr root = root_->parent();
+    Dropped dropped;
+    std::exception_ptr error;
+    NodePtr result = combine_with<Move>({root, black_height(root)},
+                                        other.root_->parent(), op, dropped,
+                                        error)
+                         .root;
+    finish_operation(result, dropped);
+    if (error) std::rethrow_exception(error);
+  };
+
+  // returns subtree with the result of op over subtree a of this tree and
+  // subtree b of another tree, which stays as it is. a is split by the
+  // root of b and the parts are combined with its children, so only the
+  // part of b next to elements of a is visited. nodes of a left out go to
+  // dropped, the first exception of taking a value goes to error
+  template <bool Move>
+  Subtree combine_with(Subtree a, NodePtr b, SetOperation op,
+                       Dropped& dropped, std::exception_ptr& error) {
+    bool keep_b = op == SetOperation::kUnion ||
+                  op == SetOperation::kSymmetricDifference;
+    if (b == nullptr) {
+      if (op != SetOperation::kIntersection) return a;
+      dropped.add(a.root);
+      return {};
+    }
+    if (a.root == nullptr) {
+      if (!keep_b || error) return {};
+      try {
+        NodePtr copied = copy<Move>(b, nullptr);
+        return {copied, black_height(copied)};
+      } catch (...) {
+        error = std::current_exception();
+        return {};
+      }
+    }
+    SplitResult parts = split(a, key_of(b->data_), true);
+    Subtree less = combine_with<Move>(parts.less, b->left_, op, dropped, error);
+    Subtree greater =
+        combine_with<Move>(parts.greater, b->right_, op, dropped, error);
+    NodePtr node = parts.equal.root;
+    if (node != nullptr) {
+      // of equivalent elements the one of a is kept
+      if (op == SetOperation::kDifference ||
+          op == SetOperation::kSymmetricDifference) {
+        dropped.add(node);
+        node = nullptr;
+      }
+    } else if (keep_b && !error) {
+      try {
+        node = take_value<Move>(b);
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+    return node == nullptr ? join(less, greater) : join(less, node, greater);
+  };
+
+  // returns subtree with the result of op over subtrees a and b. nodes left
+  // out go to dropped. the parts below big subtrees are combined on
+  // different threads if there are threads
+  Subtree combine(Subtree a, Subtree b, SetOperation op, bool unique,
+                  Dropped& dropped, size_type threads) {
+    if (a.root == nullptr || b.root == nullptr) {
+      bool keep_a = op != SetOperation::kIntersection;
+      bool keep_b = op == SetOperation::kUnion ||
+                    op == SetOperation::kSymmetricDifference;
+      if (!keep_a) dropped.add(a.root);
+      if (!keep_b) dropped.add(b.root);
+      if (keep_a && a.root != nullptr) return a;
+      return keep_b ? b : Subtree{};
+    }
+    // the pivot comes from the smaller subtree, so there are at most as many
+    // splits of the bigger one as it has elements
+    const key_type& pivot =
+        key_of((weight(a.root) <= weight(b.root) ? a : b).root->data_);
+    SplitResult parts_a = split(a, pivot, unique);
+    SplitResult parts_b = split(b, pivot, unique);
+    Subtree less, greater;
+    Dropped dropped_less;
+    if (threads < 2 || weight(a.root) + weight(b.root) < 2 * kParallelGrain)
+      threads = 1;
+    fork_join(
+        threads,
+        [&](size_type part) {
+          less = combine(parts_a.less, parts_b.less, op, unique, dropped_less,
+                         part);
+        },
+        [&](size_type part) {
+          greater = combine(parts_a.greater, parts_b.greater, op, unique,
+                            dropped, part);
+        });
+    dropped.splice(dropped_less);
+    NodePtr equal = combine_equal(parts_a.equal.root, parts_b.equal.root, op,
+                                  unique, dropped);
+    if (equal == nullptr) return join(less, greater);
+    NodePtr last = nullptr;
+    Subtree rest = split_last({equal, black_height(equal)}, last);
+    return join(join(less, rest), last, greater);
+  };
+
+  // returns subtree of equivalent elements left by op from runs a and b
+  // like in std algorithms on sorted ranges, union keeps a and the last
+  // elements of b it lacks, intersection keeps the first elements of a, and
+  // differences keep the last elements of the longer run
+  NodePtr combine_equal(NodePtr a, NodePtr b, SetOperation op, bool unique,
+                        Dropped& dropped) {
+    if (unique) {
+      bool both = a != nullptr && b != nullptr;
+      bool keep_a = op == SetOperation::kUnion ||
+                    (op == SetOperation::kIntersection ? both : !both);
+      bool keep_b = !both && (op == SetOperation::kUnion ||
+                              op == SetOperation::kSymmetricDifference);
+      NodePtr kept = keep_a && a != nullptr ? a : (keep_b ? b : nullptr);
+      if (a != kept) dropped.add(a);
+      if (b != kept) dropped.add(b);
+      return kept;
+    }
+    std::vector<NodePtr> run_a, run_b, kept;
+    drop_all(a, [&run_a](NodePtr node) { run_a.push_back(node); });
+    drop_all(b, [&run_b](NodePtr node) { run_b.push_back(node); });
+    size_type count_a = run_a.size(), count_b = run_b.size();
+    // keeps first n nodes of run or the last n if from_end is true
+    auto keep = [&kept, &dropped](std::vector<NodePtr>& run, size_type n,
+                                  bool from_end) {
+      size_type first = from_end ? run.size() - n : 0;
+      for (size_type i = 0; i < run.size(); i++) {
+        if (i >= first && i < first + n)
+          kept.push_back(run[i]);
+        else
+          dropped.add(make_node(nullptr, run[i], nullptr, BLACK));
+      }
+    };
+    if (op == SetOperation::kUnion) {
+      keep(run_a, count_a, false);
+      keep(run_b, count_b > count_a ? count_b - count_a : 0, true);
+    } else if (op == SetOperation::kIntersection) {
+      keep(run_a, std::min(count_a, count_b), false);
+      keep(run_b, 0, false);
+    } else if (op == SetOperation::kDifference || count_a >= count_b) {
+      keep(run_a, count_a > count_b ? count_a - count_b : 0, true);
+      keep(run_b, 0, false);
+    } else {
+      keep(run_a, 0, false);
+      keep(run_b, count_b - count_a, true);
+    }
+    if (kept.empty()) return nullptr;
+    size_type depth = 0;
+    for (size_type n = kept.size(); n > 1; n /= 2) depth++;
+    return link_range(kept, 0, kept.size(), 0, depth, nullptr);
+  };
+
   //      =============== NODE CLASS ===============
 
   // Node class
-  class RBNode {
+  // the value is constructed and destroyed by the tree through its allocator
+  class RBNode : public ThreadLinks<NodePtr, Threaded> {
    public:
-    // default constructor
+    // default constructor. creates unlinked red node
     RBNode()
-        : data_(Key{}),
-          color_(RED),
-          parent_(nullptr),
-          left_(nullptr),
-          right_(nullptr){};
-
-    // constructor with value
-    RBNode(const Key& value)
-        : data_(value),
-          color_(RED),
-          parent_(nullptr),
-          left_(nullptr),
-          right_(nullptr){};
-
-    // move contructor
-    RBNode(const Key&& value)
-        : data_(std::move(value)),
-          color_(RED),
-          parent_(nullptr),
-          left_(nullptr),
-          right_(nullptr){};
-
-    // copies node
-    RBNode(RBNode* node)
-        : data_(node->data_),
-          color_(node->color_),
-          parent_(nullptr),
-          left_(nullptr),
-          right_(nullptr){};
-
-    Key data_;
-    NodeColor color_;
-    NodePtr parent_;
+        : parent_color_(RED), left_(nullptr), right_(nullptr), weight_(1){};
+
+    ~RBNode(){};
+
+    // the value goes after the links, so a small one fills the space left
+    // by the 32-bit weight
+    std::uintptr_t parent_color_;  // parent pointer, color in the lowest bit
     NodePtr left_;
     NodePtr right_;
+    weight_type weight_;  // number of nodes in the subtree of this node
+    union {
+      Key data_;
+    };
+
+    // returns the parent node
+    NodePtr parent() const noexcept {
+      return reinterpret_cast<NodePtr>(parent_color_ & ~kColorBit);
+    };
+
+    // links node to parent keeping its color
+    void set_parent(NodePtr parent) noexcept {
+      parent_color_ = reinterpret_cast<std::uintptr_t>(parent) |
+                      (parent_color_ & kColorBit);
+    };
+
+    // returns the color of the node
+    NodeColor color() const noexcept {
+      return static_cast<NodeColor>(parent_color_ & kColorBit);
+    };
+
+    // changes the color of the node keeping its parent
+    void set_color(NodeColor color) noexcept {
+      parent_color_ = (parent_color_ & ~kColorBit) | color;
+    };
 
     // Returns ptr to the next node
     NodePtr successor() noexcept {
       NodePtr node = this;
       // if node is root
-      if (node->color_ == RED &&
-          (node->parent_ == nullptr || node->parent_->parent_ == node)) {
+      if (node->color() == RED &&
+          (node->parent() == nullptr || node->parent()->parent() == node)) {
         return node->right_;  // i move ptr to the max element because std
                               // library does the same
       }
@@ -808,11 +2332,11 @@ class RBTree {
         while (node->left_ != nullptr) node = node->left_;
         // if node has no right child
       } else {
-        NodePtr parent = node->parent_;
+        NodePtr parent = node->parent();
         while (node == parent->right_) {  // we move pointer until we find next
                                           // left child of parent
           node = parent;
-          parent = parent->parent_;
+          parent = parent->parent();
         }
         // if node is root
         if (node->right_ != parent) node = parent;
@@ -823,22 +2347,38 @@ class RBTree {
     // returns ptr to previous element
     NodePtr predecessor() noexcept {
       NodePtr node = this;
-      if (node->color_ == RED &&
-          (node->parent_ == nullptr || node->parent_->parent_ == node))
+      if (node->color() == RED &&
+          (node->parent() == nullptr || node->parent()->parent() == node))
         return node->right_;
       else if (node->left_ != nullptr) {
         node = node->left_;
         while (node->right_ != nullptr) node = node->right_;
       } else {
-        NodePtr parent = node->parent_;
+        NodePtr parent = node->parent();
         while (node == parent->left_) {
           node = parent;
-          parent = parent->parent_;
+          parent = parent->parent();
         }
         if (node->left_ != parent) node = parent;
       }
       return node;
     };
+
+    // returns ptr to the next node, by the link in a threaded tree
+    NodePtr next() noexcept {
+      if constexpr (Threaded)
+        return this->next_;
+      else
+        return successor();
+    };
+
+    // returns ptr to the previous node, by the link in a threaded tree
+    NodePtr prev() noexcept {
+      if constexpr (Threaded)
+        return this->prev_;
+      else
+        return predecessor();
+    };
   };
 
   //      =============== ITERATOR CLASS ===============
@@ -847,6 +2387,12 @@ class RBTree {
     friend RBTree;
 
    public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Key*;
+    using reference = Key&;
+
     // default constructor
     RBIterator() : node_(nullptr){};
 
@@ -854,7 +2400,7 @@ class RBTree {
     RBIterator(NodePtr node) : node_(node){};
 
     // * overload returns data
-    reference operator*() noexcept { return node_->data_; };
+    reference operator*() const noexcept { return node_->data_; };
 
     // overload; checks if nodes are the same
     bool operator==(const iterator& other) noexcept {
@@ -868,7 +2414,7 @@ class RBTree {
 
     // moves iterator to the next value
     iterator& operator++() noexcept {
-      node_ = node_->successor();
+      node_ = node_->next();
       return *this;
     };
 
@@ -881,7 +2427,7 @@ class RBTree {
 
     // moves to the previous value
     iterator& operator--() noexcept {
-      node_ = node_->predecessor();
+      node_ = node_->prev();
       return *this;
     };
 
@@ -902,6 +2448,12 @@ class RBTree {
     friend RBTree;
 
    public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key*;
+    using reference = const Key&;
+
     // default constr
     RBConstIterator() : node_(nullptr){};
 
@@ -910,7 +2462,7 @@ class RBTree {
     const_reference operator*() const noexcept { return node_->data_; };
 
     const_iterator operator++() noexcept {
-      node_ = node_->successor();
+      node_ = node_->next();
       return *this;
     };
 
@@ -921,7 +2473,7 @@ class RBTree {
     };
 
     const_iterator operator--() noexcept {
-      node_ = node_->predecessor();
+      node_ = node_->prev();
       return *this;
     }
 
@@ -944,9 +2496,107 @@ class RBTree {
     };
   };
 
+  //      =============== NODE HANDLE CLASS ===============
+
+  // Owner of a node detached from the tree
+  // destroys the value and gives the node back to its pool if it is not
+  // inserted anywhere
+  class RBNodeHandle {
+    friend RBTree;
+
+   public:
+    using value_type = Key;
+    using key_type = typename KeyOfValue::key_type;
+    using allocator_type = Allocator;
+
+    // default constructor. creates empty handle
+    RBNodeHandle() noexcept : node_(nullptr){};
+
+    RBNodeHandle(const RBNodeHandle&) = delete;
+    RBNodeHandle& operator=(const RBNodeHandle&) = delete;
+
+    // move constructor. other becomes empty
+    RBNodeHandle(RBNodeHandle&& other) noexcept
+        : node_(other.node_), pool_(std::move(other.pool_)) {
+      other.node_ = nullptr;
+    };
+
+    // move assignment. the node owned before is destroyed
+    RBNodeHandle& operator=(RBNodeHandle&& other) noexcept {
+      if (this != &other) {
+        reset();
+        swap(other);
+      }
+      return *this;
+    };
+
+    // destructor
+    ~RBNodeHandle() { reset(); };
+
+    // checks if the handle owns no node
+    bool empty() const noexcept { return node_ == nullptr; };
+
+    // checks if the handle owns a node
+    explicit operator bool() const noexcept { return node_ != nullptr; };
+
+    // returns allocator of the node
+    allocator_type get_allocator() const {
+      return allocator_type(pool_->get_allocator());
+    };
+
+    // returns the stored value
+    value_type& value() const noexcept { return node_->data_; };
+
+    // returns the key of a map element. unlike in the map it can be changed
+    // before the node is inserted again
+    template <typename V = Key>
+    key_type& key() const noexcept {
+      return const_cast<key_type&>(KeyOfValue{}(node_->data_));
+    };
+
+    // returns the mapped value of a map element
+    template <typename V = Key>
+    typename V::second_type& mapped() const noexcept {
+      return node_->data_.second;
+    };
+
+    // swaps owned nodes
+    void swap(RBNodeHandle& other) noexcept {
+      std::swap(node_, other.node_);
+      pool_.swap(other.pool_);
+    };
+
+   private:
+    // takes node of pool
+    RBNodeHandle(NodePtr node, const std::shared_ptr<pool_type>& pool)
+        : node_(node), pool_(pool){};
+
+    // destroys the owned node
+    void reset() noexcept {
+      if (node_ != nullptr) {
+        node_allocator alloc(pool_->get_allocator());
+        node_traits::destroy(alloc, std::addressof(node_->data_));
+        pool_->deallocate(node_);
+        node_ = nullptr;
+      }
+      pool_.reset();
+    };
+
+    // gives up the node which is linked into a tree now
+    void release() noexcept {
+      node_ = nullptr;
+      pool_.reset();
+    };
+
+    NodePtr node_;                     // owned node
+    std::shared_ptr<pool_type> pool_;  // pool the node belongs to
+  };
+
   //      =============== TREE VARIABLES ===============
-  NodePtr root_;    // end element
-  size_type size_;  // number of elements
+  NodePtr root_;                     // end element
+  size_type size_;                   // number of elements
+  std::shared_ptr<pool_type> pool_;  // storage of the nodes
+  node_allocator alloc_;             // allocator of the nodes and values
 };
 }  // namespace s21
 
@@ -0,0 +1,336 @@
+#ifndef SRC_S21_UNORDERED_MAP_H_
+#define SRC_S21_UNORDERED_MAP_H_
+
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "s21_hash_table.h"
+
+/*
+    Implementation of unordered_map
+    unordered_map keeps key-value pairs with unique keys in a hash table
+   (see HashTable), so a lookup, an insert and an erase take O(1) on
+   average instead of O(log n) of map, but the elements come in no
+   particular order. Its interface follows map where order does not matter.
+
+    Unlike std::unordered_map the elements are stored in the table itself,
+   so an insert which makes the table grow invalidates all the iterators
+   and references to the elements. reserve makes room in advance.
+*/
+
+namespace s21 {
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class unordered_map {
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using table = HashTable<value_type, PairFirstKey<value_type>, Hash,
+                          KeyEqual, Allocator>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  // enables heterogeneous lookup when both Hash and KeyEqual allow it
+  template <typename H, typename E>
+  using if_transparent_hash =
+      std::pair<if_transparent<H>, if_transparent<E>>;
+
+ public:
+  using iterator = typename table::iterator;
+  using const_iterator = typename table::const_iterator;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  // default constructor, creates an empty map
+  unordered_map() : table_(){};
+
+  // creates an empty map with room for count elements
+  explicit unordered_map(size_type count, const Hash& hash = Hash(),
+                         const KeyEqual& equal = KeyEqual(),
+                         const Allocator& alloc = Allocator())
+      : table_(hash, equal, alloc) {
+    table_.reserve(count);
+  };
+
+  // initializer list constructor. of equivalent keys the first one is kept
+  unordered_map(std::initializer_list<value_type> const& items,
+                const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(),
+                const Allocator& alloc = Allocator())
+      : unordered_map(items.begin(), items.end(), hash, equal, alloc){};
+
+  // range constructor, creates the map from [first, last)
+  template <typename InputIt, typename = if_iterator<InputIt>>
+  unordered_map(InputIt first, InputIt last, const Hash& hash = Hash(),
+                const KeyEqual& equal = KeyEqual(),
+                const Allocator& alloc = Allocator())
+      : table_(hash, equal, alloc) {
+    insert(first, last);
+  };
+
+  // copy constructor
+  unordered_map(const unordered_map& m) : table_(m.table_){};
+
+  // move constructor
+  unordered_map(unordered_map&& m) noexcept : table_(std::move(m.table_)){};
+
+  // destructor
+  ~unordered_map() = default;
+
+  // assignment operator overload for copying an object
+  unordered_map& operator=(const unordered_map& m) {
+    table_ = m.table_;
+    return *this;
+  };
+
+  // assignment operator overload for moving an object
+  unordered_map& operator=(unordered_map&& m) {
+    table_ = std::move(m.table_);
+    return *this;
+  };
+
+  // access a specified element with bounds checking
+  T& at(const Key& key) {
+    iterator it = table_.find(key);
+    if (it == table_.end()) throw std::out_of_range("unordered_map::at");
+    return it->second;
+  };
+
+  // access a specified element with bounds checking for const map
+  const T& at(const Key& key) const {
+    const_iterator it = table_.find(key);
+    if (it == table_.end()) throw std::out_of_range("unordered_map::at");
+    return it->second;
+  };
+
+  // access or insert specified element. the mapped value is default
+  // constructed only if the key is missing
+  T& operator[](const Key& key) { return try_emplace(key).first->second; };
+
+  // same for key which is moved into the new element
+  T& operator[](Key&& key) {
+    return try_emplace(std::move(key)).first->second;
+  };
+
+  // returns an iterator to the beginning
+  iterator begin() noexcept { return table_.begin(); };
+
+  // returns an iterator to the end
+  iterator end() noexcept { return table_.end(); };
+
+  // returns an iterator to the beginning for const map
+  const_iterator begin() const noexcept { return table_.begin(); };
+
+  // returns an iterator to the end for const map
+  const_iterator end() const noexcept { return table_.end(); };
+
+  // checks whether the container is empty
+  bool empty() const noexcept { return table_.empty(); };
+
+  // returns the number of elements
+  size_type size() const noexcept { return table_.size(); };
+
+  // returns the maximum possible number of elements
+  size_type max_size() const noexcept { return table_.max_size(); };
+
+  // clears the contents, keeps the memory
+  void clear() noexcept { table_.clear(); };
+
+  // inserts value if there is no element with its key. returns an iterator
+  // to the element with the key and whether the insertion took place
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return table_.emplace_key(value.first, value);
+  };
+
+  // inserts value by key if there is no element with key
+  std::pair<iterator, bool> insert(const Key& key, const T& obj) {
+    return try_emplace(key, obj);
+  };
+
+  // inserts the elements of [first, last) which keys are not there yet
+  template <typename InputIt, typename = if_iterator<InputIt>>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) table_.emplace(*first);
+  };
+
+  // inserts an element or assigns to the current element if the key
+  // already exists
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+    std::pair<iterator, bool> res = try_emplace(key, std::forward<M>(obj));
+    // try_emplace leaves obj untouched if the key is there
+    if (!res.second) res.first->second = std::forward<M>(obj);
+    return res;
+  };
+
+  // same for key which is moved into the new element
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj) {
+    std::pair<iterator, bool> res =
+        try_emplace(std::move(key), std::forward<M>(obj));
+    if (!res.second) res.first->second = std::forward<M>(obj);
+    return res;
+  };
+
+  // constructs an element from args and inserts it if there is no element
+  // with its key
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return table_.emplace(std::forward<Args>(args)...);
+  };
+
+  // inserts an element with key and the mapped value constructed from args
+  // if there is no element with key. otherwise nothing is constructed and
+  // args are left untouched
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    return table_.emplace_key(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  };
+
+  // same for key which is moved into the new element
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+    return table_.emplace_key(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  };
+
+  // inserts new elements into the container, one per argument. room for all
+  // of them is made first, so the returned iterators stay valid
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    table_.reserve(size() + sizeof...(args));
+    return {insert(std::forward<Args>(args))...};
+  };
+
+  // erases an element at pos
+  void erase(const_iterator pos) { table_.erase(pos); };
+
+  // erases the element with key and returns the number of erased elements
+  size_type erase(const Key& key) { return table_.erase_key(key); };
+
+  // erases all the elements pred returns true for and returns their number
+  template <typename Predicate>
+  size_type erase_if(Predicate pred) {
+    return table_.erase_if(pred);
+  };
+
+  // swaps the contents
+  void swap(unordered_map& other) noexcept { table_.swap(other.table_); };
+
+  // moves the elements of other which keys are not here into this map
+  void merge(unordered_map& other) {
+    for (iterator it = other.begin(); it != other.end(); ++it) {
+      if (!contains(it->first)) {
+        table_.emplace_key(it->first, std::move(*it));
+        other.erase(it);
+      }
+    }
+  };
+
+  // checks if there is an element with key equivalent to key in the container
+  bool contains(const Key& key) const { return table_.contains(key); };
+
+  // finds an element with a specific key
+  iterator find(const Key& key) { return table_.find(key); };
+
+  // same for const map
+  const_iterator find(const Key& key) const { return table_.find(key); };
+
+  // returns the number of elements with a specific key
+  size_type count(const Key& key) const {
+    return table_.contains(key) ? 1 : 0;
+  };
+
+  // heterogeneous lookup: the overloads below take any key type hashable
+  // and comparable with Key and are available only if both Hash and
+  // KeyEqual are transparent
+
+  // finds an element with a key equivalent to key
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = if_transparent_hash<H, E>>
+  iterator find(const K& key) {
+    return table_.find(key);
+  };
+
+  // same for const map
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = if_transparent_hash<H, E>>
+  const_iterator find(const K& key) const {
+    return table_.find(key);
+  };
+
+  // checks if the container contains an element equivalent to key
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = if_transparent_hash<H, E>>
+  bool contains(const K& key) const {
+    return table_.contains(key);
+  };
+
+  // returns the number of elements equivalent to key
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = if_transparent_hash<H, E>>
+  size_type count(const K& key) const {
+    return table_.contains(key) ? 1 : 0;
+  };
+
+  // hash policy
+
+  // returns the number of slots
+  size_type bucket_count() const noexcept { return table_.bucket_count(); };
+
+  // returns the share of the slots taken by the elements
+  float load_factor() const noexcept { return table_.load_factor(); };
+
+  // returns the share of the slots at which the table grows
+  float max_load_factor() const noexcept { return table_.max_load_factor(); };
+
+  // sets the share of the slots at which the table grows, from 1/8 to 7/8
+  void max_load_factor(float load) { table_.max_load_factor(load); };
+
+  // rebuilds the table with at least count slots
+  void rehash(size_type count) { table_.rehash(count); };
+
+  // makes room for count elements without growing the table
+  void reserve(size_type count) { table_.reserve(count); };
+
+  // returns the function which hashes the keys
+  hasher hash_function() const { return table_.hash_function(); };
+
+  // returns the function which compares the keys
+  key_equal key_eq() const { return table_.key_eq(); };
+
+  // returns the allocator associated with the container
+  allocator_type get_allocator() const noexcept {
+    return table_.get_allocator();
+  };
+
+ private:
+  table table_;
+};
+
+// erases all the elements of c pred returns true for, returns their number
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator, typename Predicate>
+std::size_t erase_if(unordered_map<Key, T, Hash, KeyEqual, Allocator>& c,
+                     Predicate pred) {
+  return c.erase_if(pred);
+}
+
+namespace pmr {
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+using unordered_map = s21::unordered_map<
+    Key, T, Hash, KeyEqual,
+    std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_UNORDERED_MAP_H_
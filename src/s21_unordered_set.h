@@ -0,0 +1,258 @@
+#ifndef SRC_S21_UNORDERED_SET_H_
+#define SRC_S21_UNORDERED_SET_H_
+
+#include <utility>
+#include <vector>
+
+#include "s21_hash_table.h"
+
+/*
+    Implementation of unordered_set
+    unordered_set keeps unique keys in a hash table (see HashTable), so a
+   lookup, an insert and an erase take O(1) on average instead of O(log n)
+   of set, but the elements come in no particular order. Its interface
+   follows set where order does not matter.
+
+    Unlike std::unordered_set the elements are stored in the table itself,
+   so an insert which makes the table grow invalidates all the iterators
+   and references to the elements. reserve makes room in advance.
+*/
+
+namespace s21 {
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key>>
+class unordered_set {
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using table =
+      HashTable<value_type, IdentityKey<value_type>, Hash, KeyEqual, Allocator>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  // enables heterogeneous lookup when both Hash and KeyEqual allow it
+  template <typename H, typename E>
+  using if_transparent_hash =
+      std::pair<if_transparent<H>, if_transparent<E>>;
+
+ public:
+  // the elements are keys, so they cannot be changed through iterators
+  using iterator = typename table::const_iterator;
+  using const_iterator = typename table::const_iterator;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  // default constructor, creates an empty set
+  unordered_set() : table_(){};
+
+  // creates an empty set with room for count elements
+  explicit unordered_set(size_type count, const Hash& hash = Hash(),
+                         const KeyEqual& equal = KeyEqual(),
+                         const Allocator& alloc = Allocator())
+      : table_(hash, equal, alloc) {
+    table_.reserve(count);
+  };
+
+  // initializer list constructor
+  unordered_set(std::initializer_list<value_type> const& items,
+                const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(),
+                const Allocator& alloc = Allocator())
+      : unordered_set(items.begin(), items.end(), hash, equal, alloc){};
+
+  // range constructor, creates the set from [first, last)
+  template <typename InputIt, typename = if_iterator<InputIt>>
+  unordered_set(InputIt first, InputIt last, const Hash& hash = Hash(),
+                const KeyEqual& equal = KeyEqual(),
+                const Allocator& alloc = Allocator())
+      : table_(hash, equal, alloc) {
+    insert(first, last);
+  };
+
+  // copy constructor
+  unordered_set(const unordered_set& s) : table_(s.table_){};
+
+  // move constructor
+  unordered_set(unordered_set&& s) noexcept : table_(std::move(s.table_)){};
+
+  // destructor
+  ~unordered_set() = default;
+
+  // assignment operator overload for copying an object
+  unordered_set& operator=(const unordered_set& s) {
+    table_ = s.table_;
+    return *this;
+  };
+
+  // assignment operator overload for moving an object
+  unordered_set& operator=(unordered_set&& s) {
+    table_ = std::move(s.table_);
+    return *this;
+  };
+
+  // returns an iterator to the beginning
+  const_iterator begin() const noexcept { return table_.begin(); };
+
+  // returns an iterator to the end
+  const_iterator end() const noexcept { return table_.end(); };
+
+  // checks whether the container is empty
+  bool empty() const noexcept { return table_.empty(); };
+
+  // returns the number of elements
+  size_type size() const noexcept { return table_.size(); };
+
+  // returns the maximum possible number of elements
+  size_type max_size() const noexcept { return table_.max_size(); };
+
+  // clears the contents, keeps the memory
+  void clear() noexcept { table_.clear(); };
+
+  // inserts key if it is not there yet. returns an iterator to the element
+  // and whether the insertion took place
+  std::pair<iterator, bool> insert(const_reference key) {
+    return table_.emplace_key(key, key);
+  };
+
+  // same for key which is moved into the new element
+  std::pair<iterator, bool> insert(value_type&& key) {
+    return table_.emplace_key(key, std::move(key));
+  };
+
+  // inserts the elements of [first, last) which are not there yet
+  template <typename InputIt, typename = if_iterator<InputIt>>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) table_.emplace(*first);
+  };
+
+  // constructs an element from args and inserts it if it is not there yet
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return table_.emplace(std::forward<Args>(args)...);
+  };
+
+  // inserts new elements into the container, one per argument. room for all
+  // of them is made first, so the returned iterators stay valid
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    table_.reserve(size() + sizeof...(args));
+    return {insert(std::forward<Args>(args))...};
+  };
+
+  // erases an element at pos
+  void erase(const_iterator pos) { table_.erase(pos); };
+
+  // erases the element equal to key and returns the number of erased
+  // elements
+  size_type erase(const_reference key) { return table_.erase_key(key); };
+
+  // erases all the elements pred returns true for and returns their number
+  template <typename Predicate>
+  size_type erase_if(Predicate pred) {
+    return table_.erase_if(pred);
+  };
+
+  // swaps the contents
+  void swap(unordered_set& other) noexcept { table_.swap(other.table_); };
+
+  // moves the elements of other which are not here into this set
+  void merge(unordered_set& other) {
+    for (const_iterator it = other.begin(); it != other.end(); ++it) {
+      if (!contains(*it)) {
+        table_.emplace_key(*it, std::move(const_cast<reference>(*it)));
+        other.erase(it);
+      }
+    }
+  };
+
+  // checks if the container contains key
+  bool contains(const_reference key) const { return table_.contains(key); };
+
+  // finds an element equal to key
+  const_iterator find(const_reference key) const { return table_.find(key); };
+
+  // returns the number of elements equal to key
+  size_type count(const_reference key) const {
+    return table_.contains(key) ? 1 : 0;
+  };
+
+  // heterogeneous lookup: the overloads below take any key type hashable
+  // and comparable with Key and are available only if both Hash and
+  // KeyEqual are transparent
+
+  // finds an element equivalent to key
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = if_transparent_hash<H, E>>
+  const_iterator find(const K& key) const {
+    return table_.find(key);
+  };
+
+  // checks if the container contains an element equivalent to key
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = if_transparent_hash<H, E>>
+  bool contains(const K& key) const {
+    return table_.contains(key);
+  };
+
+  // returns the number of elements equivalent to key
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = if_transparent_hash<H, E>>
+  size_type count(const K& key) const {
+    return table_.contains(key) ? 1 : 0;
+  };
+
+  // hash policy
+
+  // returns the number of slots
+  size_type bucket_count() const noexcept { return table_.bucket_count(); };
+
+  // returns the share of the slots taken by the elements
+  float load_factor() const noexcept { return table_.load_factor(); };
+
+  // returns the share of the slots at which the table grows
+  float max_load_factor() const noexcept { return table_.max_load_factor(); };
+
+  // sets the share of the slots at which the table grows, from 1/8 to 7/8
+  void max_load_factor(float load) { table_.max_load_factor(load); };
+
+  // rebuilds the table with at least count slots
+  void rehash(size_type count) { table_.rehash(count); };
+
+  // makes room for count elements without growing the table
+  void reserve(size_type count) { table_.reserve(count); };
+
+  // returns the function which hashes the keys
+  hasher hash_function() const { return table_.hash_function(); };
+
+  // returns the function which compares the keys
+  key_equal key_eq() const { return table_.key_eq(); };
+
+  // returns the allocator associated with the container
+  allocator_type get_allocator() const noexcept {
+    return table_.get_allocator();
+  };
+
+ private:
+  table table_;
+};
+
+// erases all the elements of c pred returns true for, returns their number
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator,
+          typename Predicate>
+std::size_t erase_if(unordered_set<Key, Hash, KeyEqual, Allocator>& c,
+                     Predicate pred) {
+  return c.erase_if(pred);
+}
+
+namespace pmr {
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+using unordered_set =
+    s21::unordered_set<Key, Hash, KeyEqual,
+                       std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_UNORDERED_SET_H_
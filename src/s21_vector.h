@@ -4,10 +4,14 @@
 #include <initializer_list>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <memory_resource>
 
 namespace s21 {
-template <class T>
+template <class T, class Allocator = std::allocator<T>>
 class vector {
+  using alloc_traits = std::allocator_traits<Allocator>;
+
   // public attribures
  public:
   // -------------Vector Member type-----------------------------------------
@@ -23,53 +27,81 @@ class vector {
                   // the constant type for iterating through the container
   using size_type = std::size_t;  // size_t defines the type of the container
                                   // size (standard type is size_t)
+  using allocator_type = Allocator;  // Allocator defines the type used to get
+                                     // memory for the elements
   // ---------------Vector Member functions----------------------------------
   // default constructor, creates empty vector
-  vector() : m_size(0), m_capacity(0), arr(nullptr) {}
+  vector() : vector(Allocator()) {}
+  // creates empty vector which gets its memory from alloc
+  explicit vector(const Allocator &alloc)
+      : m_size(0), m_capacity(0), arr(nullptr), m_alloc(alloc) {}
   // parameterized constructor, creates the vector of size n
-  explicit vector(size_type n) : vector() {
+  explicit vector(size_type n, const Allocator &alloc = Allocator())
+      : vector(alloc) {
     size_type zero = 0;
-    m_size = m_capacity = n;
     if (n > zero) {
-      arr = new value_type[m_capacity];
+      arr = allocate(n);
+      m_capacity = n;
+      for (; m_size < n; m_size++)
+        alloc_traits::construct(m_alloc, arr + m_size);
     }
   }
   // initializer list constructor, creates vector initizialized using
   // std::initializer_list
-  vector(std::initializer_list<value_type> const &items)
-      : vector(items.size()) {
-    size_type i = 0;
-    for (auto it = items.begin(); it != items.end(); it++) {
-      arr[i] = *it;
-      i++;
-    }
+  vector(std::initializer_list<value_type> const &items,
+         const Allocator &alloc = Allocator())
+      : vector(alloc) {
+    assign_copy(items.begin(), items.size());
   }
   // copy constructor
   vector(const vector &v)
-      : m_size(v.m_size),
-        m_capacity(v.m_capacity),
-        arr(new value_type[m_capacity]) {
-    for (size_type i = 0; i < m_size; i++) {
-      arr[i] = v.arr[i];
-    }
+      : vector(alloc_traits::select_on_container_copy_construction(v.m_alloc)) {
+    assign_copy(v.arr, v.m_size);
+  }
+  // copy constructor which gets memory from alloc
+  vector(const vector &v, const Allocator &alloc) : vector(alloc) {
+    assign_copy(v.arr, v.m_size);
   }
   // move constructor
-  vector(vector &&v) : vector() { operator=(std::move(v)); }
+  vector(vector &&v) noexcept : vector(std::move(v.m_alloc)) { steal(v); }
+  // move constructor which gets memory from alloc
+  vector(vector &&v, const Allocator &alloc) : vector(alloc) { move_from(v); }
   // destructor
-  ~vector() { delete[] arr; }
+  ~vector() { free_storage(); }
+  // assignment operator overload for copying object
+  vector &operator=(const vector &v) {
+    if (this != &v) {
+      clear();
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                        value) {
+        if (m_alloc != v.m_alloc) {
+          free_storage();
+          m_alloc = v.m_alloc;
+        }
+      }
+      assign_copy(v.arr, v.m_size);
+    }
+    return *this;
+  }
   // assignment operator overload for moving object
+  // elements are moved one by one only if the allocators differ and the
+  // allocator is not moved along with the storage
   vector &operator=(vector &&v) {
     if (this != &v) {
-      delete[] arr;
-      m_size = v.m_size;
-      m_capacity = v.m_capacity;
-      arr = v.arr;
-      v.m_size = 0;
-      v.m_capacity = 0;
-      v.arr = nullptr;
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                        value) {
+        free_storage();
+        m_alloc = std::move(v.m_alloc);
+        steal(v);
+      } else {
+        free_storage();
+        move_from(v);
+      }
     }
     return *this;
   }
+  // returns the allocator associated with the container
+  allocator_type get_allocator() const noexcept { return m_alloc; }
   // ---------------Vector Element access----------------------------------
   // access specified element with bounds checking
   reference at(size_type pos) {
@@ -163,7 +195,10 @@ class vector {
   // ------------Vector Modifiers---------------------------------------------
 
   // clears the contents
-  void clear() noexcept { m_size = 0; }
+  void clear() noexcept {
+    for (; m_size > 0; m_size--)
+      alloc_traits::destroy(m_alloc, arr + m_size - 1);
+  }
   // inserts elements into concrete pos and returns the iterator that points to
   // the new element
   iterator insert(iterator pos, const_reference value) {
@@ -173,14 +208,21 @@ class vector {
       throw std::out_of_range("The specified position is outside the vector");
     }
     if (m_size + 1 > m_capacity) {
-      reserve(m_capacity * 2);
+      // value may live in the storage being freed
+      value_type copy = value;
+      reserve(m_capacity ? m_capacity * 2 : 1);
+      return insert(arr + shift, std::move(copy));
     }
-    value_type buf = arr[shift];
-    m_size++;
-    arr[shift] = value;
-    for (size_type i = shift + 1; i < m_size; i++) {
-      std::swap(buf, arr[i]);
+    if (shift == m_size) {
+      alloc_traits::construct(m_alloc, arr + m_size, value);
+    } else {
+      value_type copy = value;
+      alloc_traits::construct(m_alloc, arr + m_size,
+                              std::move(arr[m_size - 1]));
+      std::move_backward(arr + shift, arr + m_size - 1, arr + m_size);
+      arr[shift] = std::move(copy);
     }
+    m_size++;
     return arr + shift;
   }
   // erases element at pos
@@ -190,8 +232,8 @@ class vector {
     if (shift < zero || shift > m_size) {
       throw std::out_of_range("The specified position is outside the vector");
     }
-    std::copy(const_cast<iterator>(pos) + 1, end(), arr + shift);
-    m_size--;
+    std::move(const_cast<iterator>(pos) + 1, end(), arr + shift);
+    alloc_traits::destroy(m_alloc, arr + --m_size);
   }
   // adds an element to the end
   void push_back(const_reference value) { insert(end(), value); }
@@ -200,10 +242,12 @@ class vector {
     if (empty()) {
       throw std::logic_error("vector is empty, can't delete last element");
     }
-    m_size--;
+    alloc_traits::destroy(m_alloc, arr + --m_size);
   }
   // swaps the contents
   void swap(vector &other) {
+    if constexpr (alloc_traits::propagate_on_container_swap::value)
+      std::swap(m_alloc, other.m_alloc);
     std::swap(arr, other.arr);
     std::swap(m_size, other.m_size);
     std::swap(m_capacity, other.m_capacity);
@@ -231,17 +275,64 @@ class vector {
   size_type m_size;
   size_type m_capacity;
   T *arr;
+  Allocator m_alloc;
   // allocated memory
   void access_to_vector_capacity(size_type size) {
-    iterator buff = new value_type[size];
+    iterator buff = allocate(size);
     for (size_type i = 0; i < m_size; ++i) {
-      buff[i] = std::move(arr[i]);
+      alloc_traits::construct(m_alloc, buff + i,
+                              std::move_if_noexcept(arr[i]));
+      alloc_traits::destroy(m_alloc, arr + i);
     }
-    delete[] arr;
+    if (arr) alloc_traits::deallocate(m_alloc, arr, m_capacity);
     arr = buff;
     m_capacity = size;
   }
+  // returns storage for size elements, nullptr for zero size
+  T *allocate(size_type size) {
+    return size ? alloc_traits::allocate(m_alloc, size) : nullptr;
+  }
+  // destroys the elements and frees the storage
+  void free_storage() noexcept {
+    clear();
+    if (arr) alloc_traits::deallocate(m_alloc, arr, m_capacity);
+    arr = nullptr;
+    m_capacity = 0;
+  }
+  // takes storage of v leaving it empty
+  void steal(vector &v) noexcept {
+    m_size = v.m_size;
+    m_capacity = v.m_capacity;
+    arr = v.arr;
+    v.m_size = 0;
+    v.m_capacity = 0;
+    v.arr = nullptr;
+  }
+  // takes storage of v if it comes from the same allocator, otherwise moves
+  // the elements one by one into empty vector
+  void move_from(vector &v) {
+    if (m_alloc == v.m_alloc) {
+      steal(v);
+    } else {
+      reserve(v.m_size);
+      for (; m_size < v.m_size; m_size++)
+        alloc_traits::construct(m_alloc, arr + m_size,
+                                std::move(v.arr[m_size]));
+      v.clear();
+    }
+  }
+  // copies count elements from items into empty vector
+  void assign_copy(const T *items, size_type count) {
+    reserve(count);
+    for (; m_size < count; m_size++)
+      alloc_traits::construct(m_alloc, arr + m_size, items[m_size]);
+  }
 };
+
+namespace pmr {
+template <class T>
+using vector = s21::vector<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // SRC_S21_VECTOR_H_
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "../s21_containersplus.h"
+
+TEST(btree_map_test, element_access) {
+  s21::btree_map<int, std::string> map = {{1, "one"}, {2, "two"}};
+  EXPECT_EQ(map.at(1), "one");
+  EXPECT_THROW(map.at(3), std::out_of_range);
+  map[3] = "three";
+  EXPECT_EQ(map.size(), 3U);
+  map[1] += "!";
+  EXPECT_EQ(map.at(1), "one!");
+  const s21::btree_map<int, std::string> copy = map;
+  EXPECT_EQ(copy.at(3), "three");
+  EXPECT_THROW(copy.at(0), std::out_of_range);
+}
+
+TEST(btree_map_test, insert_variants) {
+  s21::btree_map<std::string, int> map;
+  EXPECT_TRUE(map.insert({"a", 1}).second);
+  EXPECT_TRUE(map.insert("b", 2).second);
+  auto res = map.insert("a", 10);
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(res.first->second, 1);
+  res = map.insert_or_assign("a", 10);
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(map.at("a"), 10);
+  res = map.insert_or_assign("c", 3);
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(map.size(), 3U);
+}
+
+TEST(btree_map_test, lookups) {
+  s21::btree_map<int, int> map;
+  for (int i = 0; i < 1000; i++) map.insert(i * 10, i);
+  EXPECT_TRUE(map.contains(500));
+  EXPECT_FALSE(map.contains(505));
+  EXPECT_EQ(map.count(990), 1U);
+  EXPECT_EQ(map.find(7), map.end());
+  EXPECT_EQ(map.lower_bound(15)->first, 20);
+  EXPECT_EQ(map.upper_bound(20)->first, 30);
+  auto range = map.equal_range(40);
+  EXPECT_EQ(range.first->second, 4);
+  EXPECT_EQ(range.second->first, 50);
+  const auto& const_map = map;
+  EXPECT_EQ(const_map.find(30)->second, 3);
+  EXPECT_EQ(const_map.lower_bound(31)->first, 40);
+  EXPECT_EQ(const_map.upper_bound(9990), const_map.end());
+  EXPECT_EQ(const_map.equal_range(0).first, const_map.begin());
+}
+
+TEST(btree_map_test, random_against_std) {
+  std::mt19937 gen(3);
+  s21::btree_map<int, int> map;
+  std::map<int, int> std_map;
+  for (int i = 0; i < 100000; i++) {
+    int key = static_cast<int>(gen() % 10000);
+    if (gen() % 4 != 0) {
+      map[key] += i;
+      std_map[key] += i;
+    } else {
+      auto it = map.find(key);
+      auto std_it = std_map.find(key);
+      ASSERT_EQ(it == map.end(), std_it == std_map.end());
+      if (it != map.end()) {
+        map.erase(it);
+        std_map.erase(std_it);
+      }
+    }
+  }
+  EXPECT_EQ(map.size(), std_map.size());
+  auto std_it = std_map.begin();
+  for (const auto& item : map) {
+    EXPECT_EQ(item.first, std_it->first);
+    EXPECT_EQ(item.second, std_it->second);
+    ++std_it;
+  }
+}
+
+TEST(btree_map_test, merge_and_swap) {
+  s21::btree_map<int, std::string> map1 = {{1, "a"}, {2, "b"}};
+  s21::btree_map<int, std::string> map2 = {{2, "x"}, {3, "c"}};
+  map1.merge(map2);
+  EXPECT_EQ(map1.size(), 3U);
+  EXPECT_EQ(map1.at(2), "b");
+  EXPECT_EQ(map2.size(), 1U);
+  EXPECT_EQ(map2.at(2), "x");
+  map1.swap(map2);
+  EXPECT_EQ(map1.size(), 1U);
+  map2.clear();
+  EXPECT_TRUE(map2.empty());
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+
+#include "../s21_containersplus.h"
+
+namespace {
+// orders pairs by the first member only, so the second one tells equal
+// elements apart
+struct FirstLess {
+  bool operator()(const std::pair<int, int>& a,
+                  const std::pair<int, int>& b) const {
+    return a.first < b.first;
+  }
+};
+}  // namespace
+
+TEST(btree_multiset_test, insert_and_count) {
+  s21::btree_multiset<int> multiset = {3, 1, 3, 2, 3};
+  EXPECT_EQ(multiset.size(), 5U);
+  EXPECT_EQ(multiset.count(3), 3U);
+  EXPECT_EQ(multiset.count(4), 0U);
+  auto it = multiset.insert(1);
+  EXPECT_EQ(*it, 1);
+  EXPECT_EQ(multiset.count(1), 2U);
+  auto range = multiset.equal_range(3);
+  EXPECT_EQ(std::distance(range.first, range.second), 3);
+  EXPECT_EQ(*multiset.find(2), 2);
+}
+
+TEST(btree_multiset_test, equal_elements_keep_insertion_order) {
+  s21::btree_multiset<std::pair<int, int>, FirstLess> multiset;
+  for (int i = 0; i < 2000; i++) multiset.insert({i % 5, i});
+  int previous_first = -1, previous_second = -1;
+  for (const auto& item : multiset) {
+    if (item.first == previous_first) {
+      EXPECT_GT(item.second, previous_second);
+    }
+    previous_first = item.first;
+    previous_second = item.second;
+  }
+  EXPECT_EQ(multiset.count({2, 0}), 400U);
+}
+
+TEST(btree_multiset_test, random_against_std) {
+  std::mt19937 gen(11);
+  s21::btree_multiset<int> multiset;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 50000; i++) {
+    int key = static_cast<int>(gen() % 500);
+    if (gen() % 2 == 0) {
+      multiset.insert(key);
+      std_multiset.insert(key);
+    } else {
+      auto it = multiset.lower_bound(key);
+      auto std_it = std_multiset.lower_bound(key);
+      ASSERT_EQ(it == multiset.end(), std_it == std_multiset.end());
+      if (it == multiset.end()) continue;
+      it = multiset.erase(it);
+      std_it = std_multiset.erase(std_it);
+      ASSERT_EQ(it == multiset.end(), std_it == std_multiset.end());
+      if (it != multiset.end()) {
+        EXPECT_EQ(*it, *std_it);
+      }
+    }
+  }
+  EXPECT_EQ(multiset.size(), std_multiset.size());
+  EXPECT_TRUE(std::equal(multiset.begin(), multiset.end(),
+                         std_multiset.begin(), std_multiset.end()));
+  for (int key = 0; key < 500; key++)
+    EXPECT_EQ(multiset.count(key), std_multiset.count(key));
+}
+
+TEST(btree_multiset_test, merge_takes_everything) {
+  s21::btree_multiset<int> multiset1 = {1, 2, 2};
+  s21::btree_multiset<int> multiset2 = {2, 3};
+  multiset1.merge(multiset2);
+  EXPECT_EQ(multiset1.size(), 5U);
+  EXPECT_TRUE(multiset2.empty());
+  EXPECT_EQ(multiset1.count(2), 3U);
+}
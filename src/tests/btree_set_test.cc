@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+namespace {
+// int-sized value whose copy throws once copies run out
+struct LimitedCopies {
+  static int copies_left;
+  int value;
+  LimitedCopies(int v = 0) : value(v){};
+  LimitedCopies(const LimitedCopies& other) : value(other.value) {
+    if (copies_left-- == 0) throw std::runtime_error("no copies left");
+  };
+  LimitedCopies(LimitedCopies&& other) noexcept = default;
+  bool operator<(const LimitedCopies& other) const {
+    return value < other.value;
+  };
+};
+int LimitedCopies::copies_left = -1;
+
+// allocator counting the memory it holds, which goes along with the
+// containers on assignment
+template <typename T>
+struct PropagatingAllocator {
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  explicit PropagatingAllocator(long* bytes) : bytes_(bytes) {}
+  template <typename U>
+  PropagatingAllocator(const PropagatingAllocator<U>& other)
+      : bytes_(other.bytes_) {}
+  T* allocate(std::size_t n) {
+    *bytes_ += n * sizeof(T);
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) {
+    *bytes_ -= n * sizeof(T);
+    std::allocator<T>().deallocate(p, n);
+  }
+  template <typename U>
+  bool operator==(const PropagatingAllocator<U>& other) const {
+    return bytes_ == other.bytes_;
+  }
+  template <typename U>
+  bool operator!=(const PropagatingAllocator<U>& other) const {
+    return bytes_ != other.bytes_;
+  }
+  long* bytes_;
+};
+
+// checks that set holds the values from first on with step 2 in order
+void expect_values(const s21::btree_set<LimitedCopies>& set, int first,
+                   std::size_t count) {
+  ASSERT_EQ(set.size(), count);
+  int expected = first;
+  for (const LimitedCopies& item : set) {
+    EXPECT_EQ(item.value, expected);
+    expected += 2;
+  }
+  EXPECT_EQ(expected, first + 2 * static_cast<int>(count));
+}
+}  // namespace
+
+TEST(btree_set_test, constructors) {
+  s21::btree_set<int> set1;
+  EXPECT_TRUE(set1.empty());
+  s21::btree_set<int> set2 = {5, 1, 3, 1};
+  EXPECT_EQ(set2.size(), 3U);
+  s21::btree_set<int> set3 = set2;
+  s21::btree_set<int> set4 = std::move(set3);
+  EXPECT_TRUE(set3.empty());
+  EXPECT_TRUE(std::equal(set2.begin(), set2.end(), set4.begin(), set4.end()));
+  std::vector<int> items = {9, 7, 8, 7};
+  s21::btree_set<int> set5(items.begin(), items.end());
+  EXPECT_EQ(*set5.begin(), 7);
+  set1 = set5;
+  set4 = std::move(set5);
+  EXPECT_EQ(set1.size(), 3U);
+  EXPECT_EQ(set4.size(), 3U);
+  EXPECT_GT(set1.max_size(), 0U);
+}
+
+TEST(btree_set_test, insert_find_erase) {
+  s21::btree_set<std::string> set;
+  EXPECT_TRUE(set.insert("b").second);
+  EXPECT_TRUE(set.insert("a").second);
+  auto res = set.insert("b");
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(*res.first, "b");
+  EXPECT_TRUE(set.contains("a"));
+  EXPECT_EQ(set.count("c"), 0U);
+  EXPECT_EQ(set.find("c"), set.end());
+  auto next = set.erase(set.find("a"));
+  EXPECT_EQ(*next, "b");
+  // like every iterator, end() is invalidated by an erase
+  next = set.erase(next);
+  EXPECT_EQ(next, set.end());
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(btree_set_test, bounds) {
+  s21::btree_set<int> set;
+  for (int i = 0; i < 1000; i += 2) set.insert(i);
+  EXPECT_EQ(*set.lower_bound(10), 10);
+  EXPECT_EQ(*set.lower_bound(11), 12);
+  EXPECT_EQ(*set.upper_bound(10), 12);
+  EXPECT_EQ(set.lower_bound(999), set.end());
+  auto range = set.equal_range(500);
+  EXPECT_EQ(*range.first, 500);
+  EXPECT_EQ(*range.second, 502);
+  range = set.equal_range(501);
+  EXPECT_EQ(range.first, range.second);
+}
+
+TEST(btree_set_test, random_against_std) {
+  std::mt19937 gen(7);
+  s21::btree_set<int> set;
+  std::set<int> std_set;
+  for (int i = 0; i < 100000; i++) {
+    int key = static_cast<int>(gen() % 20000);
+    if (gen() % 3 != 0) {
+      EXPECT_EQ(set.insert(key).second, std_set.insert(key).second);
+    } else {
+      auto it = set.find(key);
+      auto std_it = std_set.find(key);
+      ASSERT_EQ(it == set.end(), std_it == std_set.end());
+      if (it == set.end()) continue;
+      it = set.erase(it);
+      std_it = std_set.erase(std_it);
+      ASSERT_EQ(it == set.end(), std_it == std_set.end());
+      if (it != set.end()) {
+        EXPECT_EQ(*it, *std_it);
+      }
+    }
+  }
+  EXPECT_EQ(set.size(), std_set.size());
+  EXPECT_TRUE(
+      std::equal(set.begin(), set.end(), std_set.begin(), std_set.end()));
+  EXPECT_TRUE(std::equal(std::make_reverse_iterator(set.end()),
+                         std::make_reverse_iterator(set.begin()),
+                         std_set.rbegin(), std_set.rend()));
+}
+
+TEST(btree_set_test, sorted_input) {
+  s21::btree_set<int> ascending, descending;
+  for (int i = 0; i < 50000; i++) ascending.insert(i);
+  for (int i = 50000; i > 0; i--) descending.insert(i);
+  EXPECT_EQ(ascending.size(), 50000U);
+  EXPECT_EQ(*ascending.begin(), 0);
+  EXPECT_EQ(*std::prev(descending.end()), 50000);
+  int expected = 0;
+  for (int key : ascending) EXPECT_EQ(key, expected++);
+  // erasing everything from the front merges the nodes back
+  auto it = ascending.begin();
+  while (it != ascending.end()) it = ascending.erase(it);
+  EXPECT_TRUE(ascending.empty());
+  EXPECT_EQ(ascending.begin(), ascending.end());
+}
+
+TEST(btree_set_test, merge_swap_clear) {
+  s21::btree_set<int> set1 = {1, 2, 3};
+  s21::btree_set<int> set2 = {3, 4, 5};
+  set1.merge(set2);
+  EXPECT_EQ(set1.size(), 5U);
+  EXPECT_EQ(set2.size(), 1U);
+  EXPECT_EQ(*set2.begin(), 3);
+  set1.swap(set2);
+  EXPECT_EQ(set1.size(), 1U);
+  EXPECT_EQ(set2.size(), 5U);
+  set2.clear();
+  EXPECT_TRUE(set2.empty());
+  set2.insert(1);
+  EXPECT_EQ(*set2.begin(), 1);
+}
+
+TEST(btree_set_test, custom_compare) {
+  s21::btree_set<int, std::greater<int>> set = {1, 3, 2};
+  EXPECT_EQ(*set.begin(), 3);
+  EXPECT_TRUE(set.key_comp()(3, 1));
+  EXPECT_TRUE(set.value_comp()(2, 1));
+  EXPECT_EQ(*set.lower_bound(2), 2);
+  EXPECT_EQ(*set.upper_bound(2), 1);
+}
+
+TEST(btree_set_test, throwing_copy_into_full_leaf) {
+  // a leaf holds 60 int-sized values
+  for (std::size_t count : {60U, 2000U}) {
+    s21::btree_set<LimitedCopies> set;
+    for (std::size_t i = 0; i < count; i++)
+      set.insert(LimitedCopies(2 * static_cast<int>(i)));
+    int last = 2 * static_cast<int>(count);
+    // before the first, after the last and inside a full leaf
+    for (int value : {-1, last, 61, 59}) {
+      LimitedCopies::copies_left = 0;
+      const LimitedCopies copied(value);
+      EXPECT_THROW(set.insert(copied), std::runtime_error);
+      LimitedCopies::copies_left = -1;
+      expect_values(set, 0, count);
+    }
+    set.insert(LimitedCopies(last));
+    expect_values(set, 0, count + 1);
+  }
+}
+
+TEST(btree_set_test, propagating_allocator_assignment) {
+  using Set = s21::btree_set<int, std::less<int>, PropagatingAllocator<int>>;
+  long first_bytes = 0, second_bytes = 0;
+  {
+    Set first{PropagatingAllocator<int>(&first_bytes)};
+    Set second{PropagatingAllocator<int>(&second_bytes)};
+    for (int i = 0; i < 1000; i++) first.insert(i);
+    second.insert(-1);
+    // the copy is made with the allocator of first
+    second = first;
+    EXPECT_TRUE(second.get_allocator() == first.get_allocator());
+    EXPECT_EQ(second_bytes, 0L);
+    EXPECT_EQ(second.size(), 1000U);
+    // the nodes of first are taken over along with its allocator
+    Set third{PropagatingAllocator<int>(&second_bytes)};
+    third.insert(-1);
+    const int* smallest = &*first.begin();
+    third = std::move(first);
+    EXPECT_EQ(&*third.begin(), smallest);
+    EXPECT_EQ(third.size(), 1000U);
+    EXPECT_TRUE(first.empty());
+    EXPECT_EQ(second_bytes, 0L);
+    first.insert(1);
+    EXPECT_GT(second_bytes, 0L);
+  }
+  EXPECT_EQ(first_bytes, 0L);
+  EXPECT_EQ(second_bytes, 0L);
+}
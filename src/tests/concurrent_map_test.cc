@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+TEST(concurrent_map_test, element_access) {
+  s21::concurrent_map<int, std::string> map = {{1, "one"}, {2, "two"}};
+  using int_map = s21::concurrent_map<int, int>;
+  EXPECT_EQ(map.shard_count(), int_map::kDefaultShards);
+  EXPECT_FALSE(map.insert({1, "x"}));
+  EXPECT_TRUE(map.insert(3, "three"));
+  EXPECT_FALSE(map.try_emplace(3, "x"));
+  EXPECT_FALSE(map.insert_or_assign(2, "second"));
+  EXPECT_TRUE(map.insert_or_assign(4, "four"));
+  EXPECT_EQ(map.size(), 4U);
+  EXPECT_EQ(map.at(2), "second");
+  EXPECT_THROW(map.at(5), std::out_of_range);
+  EXPECT_FALSE(map.get(5).has_value());
+  EXPECT_EQ(map.count(1), 1U);
+  EXPECT_TRUE(map.visit(1, [](auto& item) { item.second += "!"; }));
+  EXPECT_FALSE(map.visit(5, [](auto& item) { item.second += "!"; }));
+  std::string seen;
+  auto read = [&seen](const auto& item) { seen = item.second; };
+  EXPECT_TRUE(map.cvisit(1, read));
+  EXPECT_EQ(seen, "one!");
+  EXPECT_EQ(map.erase(1), 1U);
+  EXPECT_EQ(map.erase(1), 0U);
+  EXPECT_FALSE(map.contains(1));
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(int_map(5).shard_count(), 8U);
+  EXPECT_EQ(int_map(1).shard_count(), 1U);
+}
+
+TEST(concurrent_map_test, batches_against_std) {
+  std::mt19937 gen(37);
+  s21::concurrent_map<int, int> map(16);
+  std::map<int, int> std_map;
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 5000; i++)
+    items.emplace_back(static_cast<int>(gen() % 10000), i);
+  std::size_t inserted = 0;
+  for (const auto& item : items) inserted += std_map.insert(item).second;
+  EXPECT_EQ(map.insert_batch(items.begin(), items.end()), inserted);
+
+  std::vector<int> keys;
+  for (int i = 0; i < 3000; i++)
+    keys.push_back(static_cast<int>(gen() % 12000));
+  std::vector<std::optional<int>> values;
+  map.find_batch(keys.begin(), keys.end(), std::back_inserter(values));
+  std::vector<bool> present;
+  map.contains_batch(keys.begin(), keys.end(), std::back_inserter(present));
+  ASSERT_EQ(values.size(), keys.size());
+  ASSERT_EQ(present.size(), keys.size());
+  for (std::size_t i = 0; i < keys.size(); i++) {
+    auto it = std_map.find(keys[i]);
+    ASSERT_EQ(values[i].has_value(), it != std_map.end());
+    EXPECT_EQ(present[i], it != std_map.end());
+    if (it != std_map.end()) {
+      EXPECT_EQ(*values[i], it->second);
+    }
+  }
+
+  std::size_t erased = 0;
+  for (int key : keys) erased += std_map.erase(key);
+  EXPECT_EQ(map.erase_batch(keys.begin(), keys.end()), erased);
+  EXPECT_EQ(map.size(), std_map.size());
+  auto sorted = map.to_map();
+  EXPECT_TRUE(std::equal(sorted.begin(), sorted.end(), std_map.begin(),
+                         std_map.end()));
+}
+
+TEST(concurrent_map_test, threads_update_one_map) {
+  const int kThreads = 4;
+  const int kKeys = 2000;
+  s21::concurrent_map<int, int> map(8);
+  for (int key = 0; key < 10; key++) map.insert(key, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&map, t]() {
+      for (int i = 0; i < kKeys; i++) {
+        map.insert_or_assign(1000 + t * kKeys + i, t);
+        map.visit(i % 10, [](auto& item) { item.second++; });
+        if (i % 2) map.erase(1000 + t * kKeys + i);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(map.size(), 10U + kThreads * kKeys / 2);
+  int total = 0;
+  map.for_each([&total](const auto& item) {
+    if (item.first < 10) total += item.second;
+  });
+  EXPECT_EQ(total, kThreads * kKeys);
+}
+
+TEST(concurrent_map_test, consistent_for_each_sees_one_moment) {
+  // keys are inserted in order, so the map always holds 0..n-1 for some n
+  const int kKeys = 20000;
+  s21::concurrent_map<int, int> map(64);
+  std::atomic<bool> done(false);
+  std::atomic<int> failures(0);
+  std::thread reader([&]() {
+    while (!done.load()) {
+      std::size_t count = 0;
+      int max = -1;
+      map.for_each(s21::consistent, [&](const auto& item) {
+        count++;
+        max = std::max(max, item.first);
+      });
+      if (count != static_cast<std::size_t>(max + 1)) failures++;
+      std::size_t size = map.size(s21::consistent);
+      if (size < count) failures++;
+    }
+  });
+  for (int key = 0; key < kKeys; key++) map.insert(key, key);
+  done = true;
+  reader.join();
+  EXPECT_EQ(failures.load(), 0);
+  EXPECT_EQ(map.size(), static_cast<std::size_t>(kKeys));
+}
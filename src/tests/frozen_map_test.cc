@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+TEST(frozen_map_test, element_access) {
+  s21::frozen_map<int, std::string> map = {{2, "two"}, {1, "one"}, {2, "x"}};
+  EXPECT_EQ(map.size(), 2U);
+  // of equivalent keys the first one is kept
+  EXPECT_EQ(map.at(2), "two");
+  EXPECT_EQ(map.begin()->second, "one");
+  EXPECT_THROW(map.at(3), std::out_of_range);
+  EXPECT_TRUE(map.contains(1));
+  EXPECT_EQ(map.count(3), 0U);
+  EXPECT_EQ(map.find(3), map.end());
+}
+
+TEST(frozen_map_test, random_against_std) {
+  std::mt19937 gen(41);
+  s21::map<int, int> s21_map;
+  std::map<int, int> std_map;
+  for (int i = 0; i < 5000; i++) {
+    int key = static_cast<int>(gen() % 20000);
+    s21_map.insert(key, i);
+    std_map.insert({key, i});
+  }
+  s21::frozen_map<int, int> frozen(s21_map);
+  ASSERT_EQ(frozen.size(), std_map.size());
+  EXPECT_TRUE(std::equal(frozen.begin(), frozen.end(), std_map.begin(),
+                         std_map.end()));
+  for (int key = -1; key < 20001; key += 7) {
+    auto lower = frozen.lower_bound(key);
+    auto std_lower = std_map.lower_bound(key);
+    ASSERT_EQ(lower == frozen.end(), std_lower == std_map.end());
+    if (std_lower != std_map.end()) {
+      EXPECT_EQ(*lower, *std_lower);
+    }
+    auto range = frozen.equal_range(key);
+    auto std_range = std_map.equal_range(key);
+    EXPECT_EQ(std::distance(range.first, range.second),
+              std::distance(std_range.first, std_range.second));
+    auto found = frozen.find(key);
+    if (std_map.count(key)) {
+      EXPECT_EQ(found->second, std_map.at(key));
+    } else {
+      EXPECT_EQ(found, frozen.end());
+    }
+  }
+  // back to a map which can be changed
+  s21::map<int, int> thawed = frozen.to_map();
+  thawed[-5] = 5;
+  EXPECT_EQ(thawed.size(), std_map.size() + 1);
+  EXPECT_FALSE(frozen.contains(-5));
+  std::vector<std::pair<int, int>> sorted(std_map.begin(), std_map.end());
+  s21::frozen_map<int, int> from_sorted(s21::sorted_unique, sorted.begin(),
+                                        sorted.end());
+  EXPECT_TRUE(std::equal(from_sorted.begin(), from_sorted.end(),
+                         std_map.begin(), std_map.end()));
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+namespace {
+// counts the bytes it has handed out and not got back
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  std::size_t in_use = 0;
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    in_use += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+    // a free through the wrong resource would wrap the count around
+    EXPECT_GE(in_use, bytes);
+    in_use -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+}  // namespace
+
+TEST(frozen_set_test, constructors) {
+  s21::frozen_set<int> set1;
+  EXPECT_TRUE(set1.empty());
+  EXPECT_EQ(set1.begin(), set1.end());
+  s21::frozen_set<int> set2 = {5, 1, 3, 1};
+  EXPECT_EQ(set2.size(), 3U);
+  s21::frozen_set<int> set3 = set2;
+  s21::frozen_set<int> set4 = std::move(set3);
+  EXPECT_TRUE(set3.empty());
+  EXPECT_TRUE(std::equal(set2.begin(), set2.end(), set4.begin(), set4.end()));
+  std::vector<int> items = {7, 8, 9};
+  s21::frozen_set<int> set5(s21::sorted_unique, items.begin(), items.end());
+  EXPECT_EQ(*set5.begin(), 7);
+  set1 = set5;
+  set4 = std::move(set5);
+  EXPECT_EQ(set1.size(), 3U);
+  EXPECT_EQ(set4.size(), 3U);
+  EXPECT_GT(set1.max_size(), 0U);
+  set4.swap(set2);
+  EXPECT_EQ(*set4.begin(), 1);
+  set4.clear();
+  EXPECT_TRUE(set4.empty());
+}
+
+TEST(frozen_set_test, every_shape_against_std) {
+  // all the sizes up to a few full levels, so every shape of the last level
+  // is walked and searched
+  for (int n = 0; n < 300; n++) {
+    std::vector<int> items;
+    for (int i = 0; i < n; i++) items.push_back(2 * i);
+    s21::frozen_set<int> frozen(s21::sorted_unique, items.begin(),
+                                items.end());
+    std::set<int> std_set(items.begin(), items.end());
+    ASSERT_TRUE(std::equal(frozen.begin(), frozen.end(), std_set.begin(),
+                           std_set.end()));
+    auto it = frozen.end();
+    for (auto std_it = std_set.rbegin(); std_it != std_set.rend(); ++std_it)
+      ASSERT_EQ(*--it, *std_it);
+    ASSERT_EQ(it, frozen.begin());
+    for (int key = -1; key <= 2 * n; key++) {
+      auto lower = frozen.lower_bound(key);
+      auto upper = frozen.upper_bound(key);
+      auto std_lower = std_set.lower_bound(key);
+      auto std_upper = std_set.upper_bound(key);
+      ASSERT_EQ(lower == frozen.end(), std_lower == std_set.end());
+      if (std_lower != std_set.end()) {
+        ASSERT_EQ(*lower, *std_lower);
+      }
+      ASSERT_EQ(upper == frozen.end(), std_upper == std_set.end());
+      if (std_upper != std_set.end()) {
+        ASSERT_EQ(*upper, *std_upper);
+      }
+      ASSERT_EQ(frozen.contains(key), std_set.count(key) == 1);
+      ASSERT_EQ(frozen.count(key), std_set.count(key));
+      ASSERT_EQ(frozen.find(key) == frozen.end(), std_set.count(key) == 0);
+      auto range = frozen.equal_range(key);
+      ASSERT_EQ(std::distance(range.first, range.second),
+                static_cast<std::ptrdiff_t>(std_set.count(key)));
+    }
+  }
+}
+
+TEST(frozen_set_test, unsorted_input_and_conversions) {
+  std::mt19937 gen(37);
+  std::vector<std::string> items;
+  for (int i = 0; i < 2000; i++) items.push_back(std::to_string(gen() % 1500));
+  s21::frozen_set<std::string> frozen(items.begin(), items.end());
+  std::set<std::string> std_set(items.begin(), items.end());
+  EXPECT_TRUE(std::equal(frozen.begin(), frozen.end(), std_set.begin(),
+                         std_set.end()));
+  // to and from s21::set
+  s21::set<std::string> thawed = frozen.to_set();
+  EXPECT_TRUE(std::equal(thawed.begin(), thawed.end(), std_set.begin(),
+                         std_set.end()));
+  thawed.insert("new");
+  s21::frozen_set<std::string> refrozen(thawed);
+  EXPECT_EQ(refrozen.size(), std_set.size() + 1);
+  EXPECT_TRUE(refrozen.contains("new"));
+  EXPECT_FALSE(frozen.contains("new"));
+  s21::threaded_set<std::string> threaded(items.begin(), items.end());
+  s21::frozen_set<std::string> from_threaded(threaded);
+  EXPECT_EQ(from_threaded.size(), std_set.size());
+}
+
+TEST(frozen_set_test, custom_compare) {
+  s21::frozen_set<int, std::greater<int>> frozen = {1, 5, 3, 9, 7};
+  std::vector<int> expected = {9, 7, 5, 3, 1};
+  EXPECT_TRUE(std::equal(frozen.begin(), frozen.end(), expected.begin(),
+                         expected.end()));
+  EXPECT_EQ(*frozen.lower_bound(6), 5);
+  EXPECT_EQ(*frozen.upper_bound(7), 5);
+  EXPECT_EQ(frozen.upper_bound(1), frozen.end());
+}
+
+TEST(frozen_set_test, pmr_assignment_across_resources) {
+  using Set = s21::frozen_set<int, std::less<int>,
+                              std::pmr::polymorphic_allocator<int>>;
+  CountingResource first, second;
+  {
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+    Set set(values.begin(), values.end(), std::less<int>(), &first);
+    Set other({-1, -2}, std::less<int>(), &second);
+    std::size_t first_in_use = first.in_use;
+    // the copy is made in the memory of other, which keeps its resource
+    other = set;
+    EXPECT_EQ(other.get_allocator().resource(), &second);
+    EXPECT_EQ(first.in_use, first_in_use);
+    EXPECT_EQ(other.size(), 1000U);
+    EXPECT_TRUE(other.contains(999));
+    EXPECT_FALSE(other.contains(-1));
+    set = std::move(other);
+    EXPECT_EQ(set.get_allocator().resource(), &first);
+    EXPECT_EQ(set.size(), 1000U);
+  }
+  EXPECT_EQ(first.in_use, 0U);
+  EXPECT_EQ(second.in_use, 0U);
+}
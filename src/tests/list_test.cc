@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
 #include <list>
+#include <memory>
+#include <memory_resource>
 #include <random>
 
 #include "../s21_containers.h"
@@ -810,3 +812,35 @@ TEST(list_test, operator_copy_0) {
   b = a;
   EXPECT_EQ(b.size(), 4);
 }
+
+TEST(list_test, pmr_list_uses_resource) {
+  std::pmr::monotonic_buffer_resource resource;
+  s21::pmr::list<std::pmr::string> a(&resource);
+  a.push_back(std::pmr::string(40, 'x'));
+  a.push_front(std::pmr::string(40, 'y'));
+  EXPECT_EQ(a.get_allocator().resource(), &resource);
+  EXPECT_EQ(a.front().get_allocator().resource(), &resource);
+  s21::pmr::list<std::pmr::string> b(std::move(a));
+  EXPECT_EQ(b.size(), 2U);
+  EXPECT_EQ(b.back(), std::pmr::string(40, 'x'));
+  std::pmr::monotonic_buffer_resource other_resource;
+  s21::pmr::list<std::pmr::string> c(&other_resource);
+  c = std::move(b);
+  EXPECT_EQ(c.size(), 2U);
+  EXPECT_EQ(c.get_allocator().resource(), &other_resource);
+  EXPECT_EQ(c.front().get_allocator().resource(), &other_resource);
+}
+
+TEST(list_test, pmr_move_assignment_of_move_only_values) {
+  std::pmr::unsynchronized_pool_resource resource, other_resource;
+  s21::pmr::list<std::unique_ptr<int>> a(&resource);
+  for (int i = 0; i < 10; i++) a.push_back(std::make_unique<int>(i));
+  a.push_front(std::make_unique<int>(-1));
+  s21::pmr::list<std::unique_ptr<int>> b(&other_resource);
+  b = std::move(a);
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(b.size(), 11U);
+  EXPECT_EQ(b.get_allocator().resource(), &other_resource);
+  EXPECT_EQ(*b.front(), -1);
+  EXPECT_EQ(*b.back(), 9);
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
 #include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "../s21_containers.h"
 
@@ -1313,13 +1316,13 @@ TEST(map_test, contains_false_char) {
   }
 }
 
-TEST(map_test, emplace) {
+TEST(map_test, insert_many) {
   s21::map<int, int> s21_map = {{0, 1}, {1, 2}, {2, 3}};
   s21::map<int, int> s21_exm = {{-1, 0}, {0, 1}, {1, 2}, {2, 3},
                                 {3, 4},  {4, 5}, {5, 6}};
 
-  s21_map.emplace(std::make_pair(3, 4), std::make_pair(4, 5),
-                  std::make_pair(5, 6), std::make_pair(-1, 0));
+  s21_map.insert_many(std::make_pair(3, 4), std::make_pair(4, 5),
+                      std::make_pair(5, 6), std::make_pair(-1, 0));
 
   EXPECT_EQ(s21_map.size(), s21_exm.size());
   auto i = -1;
@@ -1329,13 +1332,14 @@ TEST(map_test, emplace) {
   }
 }
 
-TEST(map_test, emplace_2) {
+TEST(map_test, insert_many_2) {
   s21::map<char, std::string> s21_map = {
       {'c', "Cats"}, {'a', "Are"}, {'d', "The"}};
   s21::map<char, std::string> s21_exm = {
       {'a', "Are"}, {'b', "Best"}, {'c', "Cats"}, {'d', "The"}, {'e', "!"}};
 
-  s21_map.emplace(std::make_pair('b', "Best"), std::make_pair('e', "!"));
+  s21_map.insert_many(std::make_pair('b', "Best"),
+                      std::make_pair('e', "!"));
 
   EXPECT_EQ(s21_map.size(), s21_exm.size());
   auto i = 'a';
@@ -1345,7 +1349,7 @@ TEST(map_test, emplace_2) {
   }
 }
 
-TEST(map_test, emplace_3) {
+TEST(map_test, insert_many_3) {
   s21::map<std::string, double> s21_map = {
       {"Cats", 3.12}, {"Are", 1.23}, {"The", 4.12}};
   s21::map<std::string, double> s21_exm = {{"Are", 1.23},
@@ -1354,7 +1358,8 @@ TEST(map_test, emplace_3) {
                                            {"The", 4.12},
                                            {"!", 5.12}};
 
-  s21_map.emplace(std::make_pair("Best", 2.13), std::make_pair("!", 5.12));
+  s21_map.insert_many(std::make_pair("Best", 2.13),
+                      std::make_pair("!", 5.12));
 
   EXPECT_EQ(s21_map.size(), s21_exm.size());
 
@@ -1364,3 +1369,364 @@ TEST(map_test, emplace_3) {
   EXPECT_EQ(s21_map.at("The"), s21_exm.at("The"));
   EXPECT_EQ(s21_map.at("!"), s21_exm.at("!"));
 }
+
+TEST(map_test, lookup_by_key_large) {
+  s21::map<int, int> s21_map;
+  std::map<int, int> std_map;
+  for (int i = 0; i < 10000; i++) {
+    int key = (i * 7919) % 10007;
+    s21_map.insert(key, i);
+    std_map.insert({key, i});
+  }
+  EXPECT_EQ(s21_map.size(), std_map.size());
+  for (int key = -5; key < 10012; key++) {
+    EXPECT_EQ(s21_map.contains(key), std_map.count(key) == 1);
+    if (std_map.count(key)) {
+      EXPECT_EQ(s21_map.at(key), std_map.at(key));
+    }
+  }
+  const s21::map<int, int>& const_map = s21_map;
+  EXPECT_EQ(const_map.at(7919), std_map.at(7919));
+  EXPECT_THROW(const_map.at(10008), std::out_of_range);
+}
+
+TEST(map_test, insert_same_key_other_value) {
+  s21::map<int, std::string> s21_map = {{1, "one"}, {2, "two"}};
+  auto res = s21_map.insert({1, "uno"});
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ((*res.first).second, "one");
+  EXPECT_EQ(s21_map.size(), 2U);
+}
+
+TEST(map_test, merge_same_key_other_value) {
+  s21::map<int, int> s21_map = {{1, 10}, {2, 20}};
+  s21::map<int, int> other = {{2, 200}, {3, 300}};
+  s21_map.merge(other);
+  EXPECT_EQ(s21_map.size(), 3U);
+  EXPECT_EQ(s21_map.at(2), 20);
+  EXPECT_EQ(s21_map.at(3), 300);
+  EXPECT_EQ(other.size(), 1U);
+  EXPECT_EQ(other.at(2), 200);
+}
+
+TEST(map_test, pmr_map_uses_resource) {
+  std::pmr::monotonic_buffer_resource resource;
+  s21::pmr::map<std::pmr::string, s21::pmr::vector<int>> s21_map(&resource);
+  for (int i = 0; i < 50; i++) {
+    std::pmr::string key(30, 'a' + i % 26);
+    key += std::to_string(i);
+    s21_map[key].push_back(i);
+  }
+  EXPECT_EQ(s21_map.size(), 50U);
+  EXPECT_EQ(s21_map.get_allocator().resource(), &resource);
+  auto it = s21_map.begin();
+  EXPECT_EQ((*it).first.get_allocator().resource(), &resource);
+  EXPECT_EQ((*it).second.get_allocator().resource(), &resource);
+  s21::pmr::map<std::pmr::string, s21::pmr::vector<int>> copy = s21_map;
+  EXPECT_EQ(copy.size(), 50U);
+  copy.clear();
+  EXPECT_TRUE(copy.empty());
+}
+
+TEST(map_test, custom_comparator) {
+  s21::map<int, std::string, std::greater<int>> s21_map = {
+      {1, "one"}, {3, "three"}, {2, "two"}};
+  std::map<int, std::string, std::greater<int>> std_map = {
+      {1, "one"}, {3, "three"}, {2, "two"}};
+  auto std_it = std_map.begin();
+  for (auto it = s21_map.begin(); it != s21_map.end(); ++it, ++std_it)
+    EXPECT_EQ((*it).first, std_it->first);
+  EXPECT_EQ(s21_map.at(2), "two");
+  EXPECT_TRUE(s21_map.key_comp()(3, 1));
+  EXPECT_TRUE(s21_map.value_comp()(*s21_map.begin(), *(++s21_map.begin())));
+}
+
+TEST(map_test, lookup_functions) {
+  s21::map<int, char> s21_map = {{1, 'a'}, {3, 'c'}, {5, 'e'}};
+  std::map<int, char> std_map = {{1, 'a'}, {3, 'c'}, {5, 'e'}};
+  EXPECT_EQ((*s21_map.find(3)).second, 'c');
+  EXPECT_TRUE(s21_map.find(4) == s21_map.end());
+  EXPECT_EQ(s21_map.count(5), std_map.count(5));
+  EXPECT_EQ(s21_map.count(2), std_map.count(2));
+  for (int key = 0; key <= 6; key++) {
+    auto lower = s21_map.lower_bound(key);
+    auto upper = s21_map.upper_bound(key);
+    if (std_map.lower_bound(key) == std_map.end()) {
+      EXPECT_TRUE(lower == s21_map.end());
+    } else {
+      EXPECT_EQ((*lower).first, std_map.lower_bound(key)->first);
+    }
+    if (std_map.upper_bound(key) == std_map.end()) {
+      EXPECT_TRUE(upper == s21_map.end());
+    } else {
+      EXPECT_EQ((*upper).first, std_map.upper_bound(key)->first);
+    }
+  }
+  const auto& const_map = s21_map;
+  auto range = const_map.equal_range(3);
+  EXPECT_EQ((*range.first).first, 3);
+  EXPECT_EQ((*range.second).first, 5);
+}
+
+TEST(map_test, transparent_lookup) {
+  s21::map<std::string, int, std::less<>> s21_map = {
+      {"one", 1}, {"three", 3}, {"two", 2}};
+  std::string_view key = "three";
+  EXPECT_EQ((*s21_map.find(key)).second, 3);
+  EXPECT_TRUE(s21_map.contains("two"));
+  EXPECT_FALSE(s21_map.contains(std::string_view("four")));
+  EXPECT_EQ(s21_map.count("one"), 1U);
+  EXPECT_EQ((*s21_map.lower_bound("p")).first, "three");
+  EXPECT_EQ((*s21_map.upper_bound(key)).first, "two");
+  auto range = s21_map.equal_range("one");
+  EXPECT_EQ((*range.first).second, 1);
+  EXPECT_EQ((*range.second).second, 3);
+}
+
+TEST(map_test, order_statistics) {
+  s21::map<std::string, int> s21_map;
+  for (int i = 0; i < 100; i++) s21_map[std::to_string(i)] = i;
+  EXPECT_EQ((*s21_map.nth(0)).first, "0");
+  EXPECT_EQ((*s21_map.nth(1)).first, "1");
+  EXPECT_EQ((*s21_map.nth(2)).first, "10");
+  EXPECT_EQ((*s21_map.nth(99)).first, "99");
+  EXPECT_EQ(s21_map.rank("2"), 12U);
+  auto range = s21_map.equal_range("5");
+  EXPECT_EQ(s21_map.distance(range.first, range.second), 1);
+  EXPECT_EQ(s21_map.distance(s21_map.begin(), s21_map.find("50")), 46);
+}
+
+TEST(map_test, bulk_load) {
+  std::vector<std::pair<int, std::string>> sorted;
+  for (int i = 0; i < 100; i++) sorted.push_back({i, std::to_string(i)});
+  s21::map<int, std::string> s21_map(s21::sorted_unique, sorted.begin(),
+                                     sorted.end());
+  EXPECT_EQ(s21_map.size(), 100U);
+  EXPECT_EQ(s21_map.at(42), "42");
+  s21_map[100] = "100";
+  EXPECT_EQ((*s21_map.nth(100)).second, "100");
+  // the first of the equal keys is kept, as insert would do
+  std::vector<std::pair<int, std::string>> unsorted = {
+      {3, "c"}, {1, "a"}, {3, "x"}, {2, "b"}};
+  s21::map<int, std::string> other(unsorted.begin(), unsorted.end());
+  EXPECT_EQ(other.size(), 3U);
+  EXPECT_EQ(other.at(3), "c");
+  EXPECT_EQ((*other.begin()).second, "a");
+}
+
+TEST(map_test, insert_with_hint) {
+  s21::map<int, std::string> s21_map;
+  for (int i = 0; i < 50; i++)
+    s21_map.insert(s21_map.end(), {i * 2, std::to_string(i * 2)});
+  for (int i = 0; i < 50; i++)
+    s21_map.emplace_hint(s21_map.find(i * 2 + 2), i * 2 + 1, "odd");
+  auto it = s21_map.emplace_hint(s21_map.begin(), 10, "ten");
+  EXPECT_EQ((*it).second, "10");
+  EXPECT_EQ(s21_map.size(), 100U);
+  int key = 0;
+  for (auto pos = s21_map.begin(); pos != s21_map.end(); ++pos, ++key)
+    EXPECT_EQ((*pos).first, key);
+  EXPECT_EQ(s21_map.at(99), "odd");
+}
+
+TEST(map_test, node_handles_rekey) {
+  s21::map<int, std::string> s21_map = {{1, "one"}, {2, "two"}, {3, "three"}};
+  auto node = s21_map.extract(2);
+  EXPECT_EQ(node.key(), 2);
+  EXPECT_EQ(node.mapped(), "two");
+  node.key() = 20;
+  auto res = s21_map.insert(std::move(node));
+  EXPECT_TRUE(res.inserted);
+  EXPECT_EQ((*res.position).first, 20);
+  EXPECT_EQ(s21_map.at(20), "two");
+  EXPECT_FALSE(s21_map.contains(2));
+  s21::map<int, std::string> other;
+  other.insert(s21_map.extract(s21_map.begin()));
+  EXPECT_EQ(other.at(1), "one");
+  EXPECT_EQ(s21_map.size(), 2U);
+}
+
+TEST(map_test, parallel_build_and_for_each) {
+  std::vector<std::pair<int, std::string>> items;
+  for (int i = 0; i < 40000; i++)
+    items.emplace_back((i * 7919) % 20000, std::to_string(i));
+  s21::map<int, std::string> s21_map(s21::parallel(4), items.begin(),
+                                     items.end());
+  std::map<int, std::string> std_map(items.begin(), items.end());
+  EXPECT_EQ(s21_map.size(), std_map.size());
+  // the first of equivalent elements is kept, as by the std constructor
+  for (const auto& item : std_map)
+    EXPECT_EQ(s21_map.at(item.first), item.second);
+  s21_map.for_each(s21::parallel(4),
+                   [](std::pair<const int, std::string>& item) {
+                     item.second += "!";
+                   });
+  EXPECT_EQ(s21_map.at(0), "0!");
+  EXPECT_EQ(s21_map.at(19999), std_map.at(19999) + "!");
+}
+
+TEST(map_test, threaded_range_scan) {
+  s21::threaded_map<int, std::string> s21_map;
+  for (int i = 0; i < 1000; i++) s21_map.insert(i * 3, std::to_string(i));
+  for (int i = 0; i < 1000; i += 2) s21_map.erase(s21_map.find(i * 3));
+  int expected = 3;
+  for (auto it = s21_map.lower_bound(2); it != s21_map.upper_bound(300);
+       ++it, expected += 6) {
+    EXPECT_EQ((*it).first, expected);
+    EXPECT_EQ((*it).second, std::to_string(expected / 3));
+  }
+  EXPECT_EQ(expected, 303);
+  s21::threaded_map<int, std::string> moved = std::move(s21_map);
+  EXPECT_EQ((*std::prev(moved.end())).first, 2997);
+  EXPECT_TRUE(s21_map.begin() == s21_map.end());
+}
+
+TEST(map_test, emplace_and_try_emplace) {
+  s21::map<int, std::unique_ptr<int>> s21_map;
+  auto res = s21_map.emplace(1, std::make_unique<int>(10));
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(*(*res.first).second, 10);
+  res = s21_map.emplace(1, std::make_unique<int>(20));
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(*(*res.first).second, 10);
+  // nothing is moved out of the arguments if the key is there
+  auto value = std::make_unique<int>(30);
+  res = s21_map.try_emplace(1, std::move(value));
+  EXPECT_FALSE(res.second);
+  ASSERT_NE(value, nullptr);
+  res = s21_map.try_emplace(2, std::move(value));
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(value, nullptr);
+  EXPECT_EQ(*s21_map.at(2), 30);
+  s21::map<std::string, std::string> strings;
+  std::string key = "key";
+  strings.try_emplace(std::move(key), 3, 'x');
+  EXPECT_EQ(strings.at("key"), "xxx");
+  for (int i = 0; i < 100; i += 2) strings.try_emplace(std::to_string(i));
+  for (int i = 99; i > 0; i -= 2) strings.try_emplace(std::to_string(i), "o");
+  EXPECT_EQ(strings.size(), 101U);
+  EXPECT_EQ(strings.at("7"), "o");
+  EXPECT_EQ(strings.at("8"), "");
+}
+
+// counts how mapped values of a map come to be
+struct Tracked {
+  static int defaults, copies, moves;
+  Tracked() { defaults++; };
+  Tracked(const Tracked&) { copies++; };
+  Tracked(Tracked&&) noexcept { moves++; };
+  Tracked& operator=(const Tracked&) {
+    copies++;
+    return *this;
+  };
+  Tracked& operator=(Tracked&&) noexcept {
+    moves++;
+    return *this;
+  };
+};
+int Tracked::defaults = 0, Tracked::copies = 0, Tracked::moves = 0;
+
+TEST(map_test, subscript_and_insert_or_assign_construct_on_miss) {
+  s21::map<std::string, Tracked> s21_map;
+  // the end node of the tree holds a value too
+  int base = Tracked::defaults;
+  s21_map["a"];
+  EXPECT_EQ(Tracked::defaults, base + 1);
+  // a hit constructs nothing
+  s21_map["a"];
+  std::string key = "b";
+  s21_map[key];
+  s21_map[key];
+  EXPECT_EQ(Tracked::defaults, base + 2);
+  EXPECT_EQ(Tracked::copies + Tracked::moves, 0);
+  // the value goes straight to the node or is assigned to the old one
+  Tracked value;
+  auto res = s21_map.insert_or_assign(std::string("c"), std::move(value));
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(Tracked::moves, 1);
+  res = s21_map.insert_or_assign(key, value);
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(Tracked::copies, 1);
+  EXPECT_EQ(Tracked::moves, 1);
+  EXPECT_EQ(s21_map.size(), 3U);
+  // the key is moved into the node on a miss and left alone on a hit
+  s21::map<std::string, std::unique_ptr<int>> owners;
+  std::string long_key(40, 'k');
+  owners[std::move(long_key)] = std::make_unique<int>(1);
+  EXPECT_TRUE(long_key.empty());
+  std::string same(40, 'k');
+  owners.insert_or_assign(std::move(same), std::make_unique<int>(2));
+  EXPECT_EQ(same.size(), 40U);
+  EXPECT_EQ(*owners[std::string(40, 'k')], 2);
+}
+
+TEST(map_test, erase_key_range_and_if) {
+  s21::map<int, std::string> s21_map;
+  std::map<int, std::string> std_map;
+  for (int i = 0; i < 10000; i++) {
+    s21_map.insert(i, std::to_string(i));
+    std_map.insert({i, std::to_string(i)});
+  }
+  EXPECT_EQ(s21_map.erase(5), 1U);
+  EXPECT_EQ(s21_map.erase(5), 0U);
+  std_map.erase(5);
+  // expired keys sit in one contiguous range
+  auto last = s21_map.erase(s21_map.lower_bound(1000),
+                            s21_map.lower_bound(7000));
+  EXPECT_EQ((*last).first, 7000);
+  std_map.erase(std_map.lower_bound(1000), std_map.lower_bound(7000));
+  auto long_value = [](const std::pair<const int, std::string>& item) {
+    return item.second.size() > 3;
+  };
+  EXPECT_EQ(s21::erase_if(s21_map, long_value), 3000U);
+  for (auto it = std_map.begin(); it != std_map.end();)
+    it = long_value(*it) ? std_map.erase(it) : std::next(it);
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  for (const auto& item : std_map)
+    EXPECT_EQ(s21_map.at(item.first), item.second);
+  EXPECT_EQ(s21_map.rank(999), 998U);
+}
+
+TEST(map_test, time_range_scan) {
+  // samples keyed by timestamp, one every 10 ticks
+  s21::threaded_map<long long, int> samples;
+  for (int i = 0; i < 1000; i++) samples.insert(i * 10LL, i);
+  const auto& const_samples = samples;
+  // [1005, 2000) holds the samples taken at 1010 ... 1990
+  auto first = const_samples.lower_bound(1005);
+  auto last = const_samples.lower_bound(2000);
+  EXPECT_EQ((*first).first, 1010);
+  EXPECT_EQ(const_samples.distance(first, last), 99);
+  int sum = 0;
+  for (auto it = first; it != last; ++it) sum += (*it).second;
+  EXPECT_EQ(sum, (101 + 199) * 99 / 2);
+  // an exact timestamp is its own range
+  auto range = samples.equal_range(2000);
+  EXPECT_EQ((*range.first).second, 200);
+  EXPECT_EQ((*range.second).first, 2010);
+  EXPECT_EQ(samples.count(2000), 1U);
+  EXPECT_EQ(samples.count(2005), 0U);
+  EXPECT_TRUE(samples.find(2005) == samples.end());
+  EXPECT_TRUE(samples.upper_bound(2005) == samples.lower_bound(2005));
+  EXPECT_TRUE(samples.upper_bound(9990) == samples.end());
+}
+
+TEST(map_test, find_batch) {
+  s21::threaded_map<std::string, int> s21_map;
+  for (int i = 0; i < 3000; i += 3) s21_map.insert(std::to_string(i), i);
+  std::vector<std::string> keys;
+  for (int i = 0; i < 600; i++) keys.push_back(std::to_string(i * 5));
+  std::vector<s21::threaded_map<std::string, int>::iterator> found(
+      keys.size());
+  s21_map.find_batch(keys.begin(), keys.end(), found.begin());
+  bool contained[600];
+  s21_map.contains_batch(keys.begin(), keys.end(), contained);
+  for (std::size_t i = 0; i < keys.size(); i++) {
+    EXPECT_EQ(contained[i], i * 5 % 3 == 0);
+    if (contained[i]) {
+      EXPECT_EQ((*found[i]).second, static_cast<int>(i * 5));
+    } else {
+      EXPECT_TRUE(found[i] == s21_map.end());
+    }
+  }
+}
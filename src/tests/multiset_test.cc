@@ -1,7 +1,29 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+
 #include "../s21_containersplus.h"
 
+namespace {
+// throws from the move constructor once moves run out
+struct LimitedMoves {
+  static int moves_left;
+  int value;
+  LimitedMoves(int v = 0) : value(v){};
+  LimitedMoves(const LimitedMoves& other) = default;
+  LimitedMoves(LimitedMoves&& other) : value(other.value) {
+    if (moves_left-- == 0) throw std::runtime_error("no moves left");
+  };
+  bool operator<(const LimitedMoves& other) const {
+    return value < other.value;
+  };
+};
+int LimitedMoves::moves_left = -1;
+}  // namespace
+
 TEST(multiset_test, constructor_1) {
   s21::multiset<int> multiset1;
   std::multiset<int> multiset2;
@@ -481,19 +503,19 @@ TEST(multiset_test, test30) {
   EXPECT_EQ(*(res.second), 0);
 }
 
-TEST(multiset_test, emplace_4) {
+TEST(multiset_test, insert_many_4) {
   s21::multiset<double> v = {2, -3, 20, -5, 1, -6};
-  v.emplace(8, 42, 26, 1, 1, 1);
+  v.insert_many(8, 42, 26, 1, 1, 1);
   s21::multiset<double>::iterator x = v.lower_bound(8);
   --x;
   ASSERT_EQ(*x, 2);
 }
 
-TEST(multiset_test, emplace) {
+TEST(multiset_test, insert_many) {
   s21::multiset<int> s21_multiset = {2, 2, 1, 3};
   s21::multiset<int> s21_exm = {0, 1, 2, 2, 3, 4, 4};
 
-  s21_multiset.emplace(4, 4, 0);
+  s21_multiset.insert_many(4, 4, 0);
 
   EXPECT_EQ(s21_multiset.size(), s21_exm.size());
   auto exm_it = s21_exm.begin();
@@ -503,12 +525,12 @@ TEST(multiset_test, emplace) {
   }
 }
 
-TEST(multiset_test, emplace_2) {
+TEST(multiset_test, insert_many_2) {
   s21::multiset<char> s21_multiset = {'b', 'b', 'f', 'f', 'e', 'e'};
   s21::multiset<char> s21_exm = {'a', 'b', 'b', 'c', 'd',
                                  'e', 'e', 'f', 'f', 'g'};
 
-  s21_multiset.emplace('c', 'g', 'd', 'a');
+  s21_multiset.insert_many('c', 'g', 'd', 'a');
 
   EXPECT_EQ(s21_multiset.size(), s21_exm.size());
   auto exm_it = s21_exm.begin();
@@ -518,12 +540,12 @@ TEST(multiset_test, emplace_2) {
   }
 }
 
-TEST(multiset_test, emplace_3) {
+TEST(multiset_test, insert_many_3) {
   s21::multiset<std::string> s21_multiset = {"Cats", "Are"};
   s21::multiset<std::string> s21_exm = {"Are", "Best", "Best", "Cats",
                                         "The", "The",  "!",    "!"};
 
-  s21_multiset.emplace("The", "The", "Best", "Best", "!", "!");
+  s21_multiset.insert_many("The", "The", "Best", "Best", "!", "!");
 
   EXPECT_EQ(s21_multiset.size(), s21_exm.size());
   auto exm_it = s21_exm.begin();
@@ -533,12 +555,12 @@ TEST(multiset_test, emplace_3) {
   }
 }
 
-TEST(multiset_test, emplace_5) {
+TEST(multiset_test, insert_many_5) {
   s21::multiset<double> s21_multiset = {2.13, 2.13, 1.23};
   s21::multiset<double> s21_exm = {1.23, 2.13, 2.13, 3.12, 3.12,
                                    4.12, 4.12, 5.12, 5.12};
 
-  s21_multiset.emplace(5.12, 5.12, 3.12, 3.12, 4.12, 4.12);
+  s21_multiset.insert_many(5.12, 5.12, 3.12, 3.12, 4.12, 4.12);
 
   EXPECT_EQ(s21_multiset.size(), s21_exm.size());
   auto exm_it = s21_exm.begin();
@@ -547,3 +569,250 @@ TEST(multiset_test, emplace_5) {
     EXPECT_EQ(*s21_it, *exm_it);
   }
 }
+
+TEST(multiset_test, merge_strings_from_other_pool) {
+  s21::multiset<std::string> s21_multiset = {"b", "a", "c"};
+  s21::multiset<std::string> other = {"b", "d", "a"};
+  s21_multiset.merge(other);
+  std::multiset<std::string> std_multiset = {"a", "a", "b", "b", "c", "d"};
+  EXPECT_EQ(s21_multiset.size(), std_multiset.size());
+  EXPECT_TRUE(other.empty());
+  EXPECT_TRUE(other.begin() == other.end());
+  auto std_it = std_multiset.begin();
+  for (auto it = s21_multiset.begin(); it != s21_multiset.end();
+       ++it, ++std_it)
+    EXPECT_EQ(*it, *std_it);
+  other.insert("e");
+  EXPECT_EQ(*other.begin(), "e");
+}
+
+TEST(multiset_test, merge_throwing_move) {
+  s21::multiset<LimitedMoves> s21_multiset, other;
+  for (int i = 0; i < 50; i++) s21_multiset.insert(LimitedMoves(i % 10));
+  for (int i = 0; i < 50; i++) other.insert(LimitedMoves(i % 7));
+  LimitedMoves::moves_left = 20;
+  EXPECT_THROW(s21_multiset.merge(other), std::runtime_error);
+  LimitedMoves::moves_left = -1;
+  EXPECT_EQ(s21_multiset.size(), 70U);
+  EXPECT_EQ(other.size(), 30U);
+  EXPECT_TRUE(std::is_sorted(other.begin(), other.end()));
+  s21_multiset.merge(other);
+  EXPECT_EQ(s21_multiset.size(), 100U);
+  EXPECT_TRUE(other.empty());
+  EXPECT_TRUE(std::is_sorted(s21_multiset.begin(), s21_multiset.end()));
+}
+
+TEST(multiset_test, pmr_multiset) {
+  std::pmr::monotonic_buffer_resource resource;
+  s21::pmr::multiset<int> a({3, 1, 3, 2}, &resource);
+  EXPECT_EQ(a.size(), 4U);
+  EXPECT_EQ(a.count(3), 2U);
+  EXPECT_EQ(a.get_allocator().resource(), &resource);
+}
+
+TEST(multiset_test, custom_comparator_count) {
+  s21::multiset<int, std::greater<int>> s21_multiset = {1, 2, 2, 3, 3, 3};
+  EXPECT_EQ(s21_multiset.count(3), 3U);
+  EXPECT_EQ(s21_multiset.count(2), 2U);
+  EXPECT_EQ(s21_multiset.count(4), 0U);
+  EXPECT_EQ(*s21_multiset.begin(), 3);
+  EXPECT_EQ(*s21_multiset.lower_bound(2), 2);
+  EXPECT_EQ(*s21_multiset.upper_bound(2), 1);
+}
+
+TEST(multiset_test, transparent_equal_range) {
+  s21::multiset<std::string, std::less<>> s21_multiset = {"b", "a", "b", "c",
+                                                          "b"};
+  std::string_view key = "b";
+  EXPECT_EQ(s21_multiset.count(key), 3U);
+  auto range = s21_multiset.equal_range(key);
+  size_t n = 0;
+  for (auto it = range.first; it != range.second; ++it, ++n)
+    EXPECT_EQ(*it, "b");
+  EXPECT_EQ(n, 3U);
+  EXPECT_EQ(*range.second, "c");
+  EXPECT_EQ(*s21_multiset.lower_bound("b"), "b");
+  EXPECT_EQ(*s21_multiset.upper_bound("a"), "b");
+  EXPECT_TRUE(s21_multiset.contains("c"));
+  EXPECT_FALSE(s21_multiset.contains("d"));
+}
+
+TEST(multiset_test, count_many_duplicates) {
+  s21::multiset<int> s21_multiset;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 2000; i++) {
+    s21_multiset.insert(i * 7 % 13);
+    std_multiset.insert(i * 7 % 13);
+  }
+  for (int i = 0; i < 300; i++) {
+    s21_multiset.erase(s21_multiset.find(i % 13));
+    std_multiset.erase(std_multiset.find(i % 13));
+  }
+  for (int key = -1; key <= 13; key++) {
+    EXPECT_EQ(s21_multiset.count(key), std_multiset.count(key));
+    auto range = s21_multiset.equal_range(key);
+    auto std_range = std_multiset.equal_range(key);
+    if (std_range.second == std_multiset.end()) {
+      EXPECT_TRUE(range.second == s21_multiset.end());
+    } else {
+      EXPECT_EQ(*range.second, *std_range.second);
+    }
+  }
+}
+
+TEST(multiset_test, order_statistics) {
+  s21::multiset<int> s21_multiset;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 1000; i++) {
+    s21_multiset.insert(i % 17);
+    std_multiset.insert(i % 17);
+  }
+  s21::multiset<int> other = {3, 3, 20};
+  s21_multiset.merge(other);
+  std_multiset.insert({3, 3, 20});
+  size_t k = 0;
+  for (auto it = std_multiset.begin(); it != std_multiset.end(); ++it, ++k)
+    EXPECT_EQ(*s21_multiset.nth(k), *it);
+  for (int key = -1; key <= 21; key++) {
+    EXPECT_EQ(s21_multiset.rank(key),
+              static_cast<size_t>(std::distance(
+                  std_multiset.begin(), std_multiset.lower_bound(key))));
+    EXPECT_EQ(s21_multiset.count(key), std_multiset.count(key));
+  }
+}
+
+TEST(multiset_test, bulk_load) {
+  std::vector<int> sorted = {1, 1, 2, 3, 3, 3, 5};
+  s21::multiset<int> s21_multiset(s21::sorted_equivalent, sorted.begin(),
+                                  sorted.end());
+  EXPECT_EQ(s21_multiset.size(), sorted.size());
+  EXPECT_EQ(s21_multiset.count(3), 3U);
+  s21_multiset.insert(3);
+  EXPECT_EQ(s21_multiset.count(3), 4U);
+  std::vector<int> shuffled = {5, 3, 1, 3, 2, 1, 3};
+  s21_multiset.assign(shuffled.begin(), shuffled.end());
+  size_t k = 0;
+  for (auto it = s21_multiset.begin(); it != s21_multiset.end(); ++it, ++k)
+    EXPECT_EQ(*it, sorted[k]);
+}
+
+TEST(multiset_test, insert_with_hint) {
+  s21::multiset<int> s21_multiset;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 300; i++) {
+    int key = i / 3;
+    s21_multiset.insert(s21_multiset.end(), key);
+    s21_multiset.emplace_hint(s21_multiset.upper_bound(key), key);
+    s21_multiset.insert(s21_multiset.begin(), key % 10);
+    std_multiset.insert({key, key, key % 10});
+  }
+  EXPECT_EQ(s21_multiset.size(), std_multiset.size());
+  auto std_it = std_multiset.begin();
+  for (auto it = s21_multiset.begin(); it != s21_multiset.end(); ++it)
+    EXPECT_EQ(*it, *std_it++);
+  EXPECT_EQ(s21_multiset.count(5), std_multiset.count(5));
+}
+
+TEST(multiset_test, node_handles) {
+  s21::multiset<int> first = {1, 2, 2, 3};
+  s21::multiset<int> second = {2};
+  second.insert(first.extract(2));
+  second.insert(second.begin(), first.extract(first.find(2)));
+  EXPECT_EQ(first.count(2), 0U);
+  EXPECT_EQ(first.size(), 2U);
+  EXPECT_EQ(second.count(2), 3U);
+  auto node = second.extract(5);
+  EXPECT_TRUE(node.empty());
+}
+
+TEST(multiset_test, set_algebra) {
+  std::mt19937 gen(21);
+  for (int round = 0; round < 200; round++) {
+    std::multiset<int> a, b;
+    int size_a = gen() % 200, size_b = gen() % 200;
+    for (int i = 0; i < size_a; i++) a.insert(gen() % 40);
+    for (int i = 0; i < size_b; i++) b.insert(gen() % 40);
+    std::vector<std::vector<int>> expected(4);
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                   std::back_inserter(expected[0]));
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                          std::back_inserter(expected[1]));
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                        std::back_inserter(expected[2]));
+    std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(),
+                                  std::back_inserter(expected[3]));
+    for (int op = 0; op < 4; op++) {
+      s21::multiset<int> first(a.begin(), a.end()), second(b.begin(), b.end());
+      if (op == 0) first.set_union(std::move(second));
+      if (op == 1) first.set_intersection(second);
+      if (op == 2) first.set_difference(second);
+      if (op == 3) first.symmetric_difference(std::move(second));
+      EXPECT_EQ(first.size(), expected[op].size());
+      EXPECT_TRUE(std::equal(first.begin(), first.end(),
+                             expected[op].begin(), expected[op].end()));
+      EXPECT_EQ(first.count(7), static_cast<size_t>(std::count(
+                                    expected[op].begin(),
+                                    expected[op].end(), 7)));
+    }
+  }
+}
+
+TEST(multiset_test, threaded_iteration) {
+  s21::threaded_multiset<int> s21_multiset = {5, 1, 5, 3, 1};
+  std::multiset<int> std_multiset = {5, 1, 5, 3, 1};
+  s21_multiset.erase(s21_multiset.find(3));
+  std_multiset.erase(std_multiset.find(3));
+  auto node = s21_multiset.extract(5);
+  node.value() = 0;
+  s21_multiset.insert(std::move(node));
+  std_multiset.erase(std_multiset.find(5));
+  std_multiset.insert(0);
+  s21::threaded_multiset<int> other = {1, 7};
+  s21_multiset.merge(other);
+  std_multiset.insert({1, 7});
+  EXPECT_TRUE(other.empty());
+  EXPECT_TRUE(other.begin() == other.end());
+  EXPECT_TRUE(std::equal(s21_multiset.begin(), s21_multiset.end(),
+                         std_multiset.begin(), std_multiset.end()));
+  EXPECT_EQ(*std::prev(s21_multiset.end()), 7);
+}
+
+TEST(multiset_test, emplace_returns_inserted) {
+  s21::multiset<std::string> s21_multiset = {"bb"};
+  auto first = s21_multiset.emplace(2, 'b');
+  auto second = s21_multiset.emplace("bb");
+  EXPECT_EQ(*first, "bb");
+  EXPECT_EQ(s21_multiset.count("bb"), 3U);
+  // equivalent elements keep the order of insertion
+  EXPECT_TRUE(++first == second);
+  EXPECT_TRUE(++second == s21_multiset.end());
+}
+
+TEST(multiset_test, erase_key_range_and_if) {
+  std::mt19937 gen(29);
+  s21::multiset<int> s21_multiset;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 20000; i++) {
+    int key = static_cast<int>(gen() % 2000);
+    s21_multiset.insert(key);
+    std_multiset.insert(key);
+  }
+  // every copy of the key goes
+  EXPECT_EQ(s21_multiset.erase(100), std_multiset.erase(100));
+  EXPECT_EQ(s21_multiset.erase(100), 0U);
+  // runs of duplicates are split by rank, not by key
+  auto first = s21_multiset.nth(1234), last = s21_multiset.nth(9876);
+  EXPECT_TRUE(s21_multiset.erase(first, last) == last);
+  std_multiset.erase(std::next(std_multiset.begin(), 1234),
+                     std::next(std_multiset.begin(), 9876));
+  auto odd = [](int key) { return key % 2 != 0; };
+  EXPECT_EQ(s21::erase_if(s21_multiset, odd),
+            static_cast<std::size_t>(std::count_if(
+                std_multiset.begin(), std_multiset.end(), odd)));
+  for (auto it = std_multiset.begin(); it != std_multiset.end();)
+    it = odd(*it) ? std_multiset.erase(it) : std::next(it);
+  EXPECT_TRUE(std::equal(s21_multiset.begin(), s21_multiset.end(),
+                         std_multiset.begin(), std_multiset.end()));
+  EXPECT_EQ(*s21_multiset.nth(s21_multiset.size() - 1),
+            *std_multiset.rbegin());
+}
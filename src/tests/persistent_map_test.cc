@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+namespace {
+// throws from the copy constructor once copies_left reaches zero
+struct Fragile {
+  static int copies_left;
+  static int alive;
+
+  explicit Fragile(int v) : value(v) { alive++; }
+  Fragile(const Fragile& other) : value(other.value) {
+    if (copies_left == 0) throw std::runtime_error("copy");
+    if (copies_left > 0) copies_left--;
+    alive++;
+  }
+  ~Fragile() { alive--; }
+
+  int value;
+};
+
+int Fragile::copies_left = -1;
+int Fragile::alive = 0;
+
+template <typename Map, typename StdMap>
+void expect_same(const Map& map, const StdMap& std_map) {
+  ASSERT_EQ(map.size(), std_map.size());
+  auto it = map.begin();
+  for (const auto& item : std_map) {
+    ASSERT_EQ(it->first, item.first);
+    ASSERT_EQ(it->second, item.second);
+    ++it;
+  }
+  EXPECT_TRUE(it == map.end());
+}
+}  // namespace
+
+TEST(persistent_map_test, element_access) {
+  s21::persistent_map<int, std::string> map = {{2, "two"}, {1, "x"}};
+  EXPECT_FALSE(map.insert({1, "one"}));
+  EXPECT_TRUE(map.insert(3, "three"));
+  EXPECT_FALSE(map.insert_or_assign(1, "one"));
+  EXPECT_TRUE(map.insert_or_assign(4, "four"));
+  EXPECT_EQ(map.size(), 4U);
+  EXPECT_EQ(map.at(1), "one");
+  EXPECT_THROW(map.at(5), std::out_of_range);
+  EXPECT_EQ(map.count(4), 1U);
+  EXPECT_TRUE(map.find(5) == map.end());
+  EXPECT_EQ(map.lower_bound(2)->second, "two");
+  EXPECT_EQ(map.upper_bound(2)->second, "three");
+  EXPECT_EQ(map.erase(2), 1U);
+  EXPECT_EQ(map.erase(2), 0U);
+  EXPECT_EQ((--map.end())->first, 4);
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.begin() == map.end());
+}
+
+TEST(persistent_map_test, random_against_std) {
+  std::mt19937 gen(23);
+  s21::persistent_map<int, int> map;
+  std::map<int, int> std_map;
+  for (int i = 0; i < 20000; i++) {
+    int key = static_cast<int>(gen() % 2000);
+    switch (gen() % 3) {
+      case 0:
+        EXPECT_EQ(map.insert(key, i), std_map.insert({key, i}).second);
+        break;
+      case 1:
+        EXPECT_EQ(map.insert_or_assign(key, i),
+                  std_map.insert_or_assign(key, i).second);
+        break;
+      default:
+        EXPECT_EQ(map.erase(key), std_map.erase(key));
+    }
+  }
+  expect_same(map, std_map);
+  auto it = map.end();
+  for (auto std_it = std_map.rbegin(); std_it != std_map.rend(); ++std_it)
+    ASSERT_EQ((--it)->first, std_it->first);
+  EXPECT_TRUE(it == map.begin());
+  for (int key = -1; key <= 2000; key++) {
+    auto lower = map.lower_bound(key);
+    auto std_lower = std_map.lower_bound(key);
+    ASSERT_EQ(lower == map.end(), std_lower == std_map.end());
+    if (std_lower != std_map.end()) {
+      EXPECT_EQ(lower->first, std_lower->first);
+    }
+  }
+}
+
+TEST(persistent_map_test, snapshots_do_not_change) {
+  std::mt19937 gen(29);
+  s21::persistent_map<int, int> map;
+  std::map<int, int> std_map;
+  std::vector<s21::persistent_map<int, int>> snapshots;
+  std::vector<std::map<int, int>> expected;
+  for (int i = 0; i < 5000; i++) {
+    int key = static_cast<int>(gen() % 500);
+    if (gen() % 4 == 0) {
+      map.erase(key);
+      std_map.erase(key);
+    } else {
+      map.insert_or_assign(key, i);
+      std_map[key] = i;
+    }
+    if (i % 250 == 0) {
+      snapshots.push_back(map.snapshot());
+      expected.push_back(std_map);
+    }
+  }
+  map.clear();
+  for (std::size_t i = 0; i < snapshots.size(); i++)
+    expect_same(snapshots[i], expected[i]);
+  // an update of a snapshot leaves the others alone
+  snapshots[1].insert_or_assign(-1, -1);
+  snapshots[2] = snapshots[1];
+  snapshots[1].erase(-1);
+  expect_same(snapshots[1], expected[1]);
+  expected[1][-1] = -1;
+  expect_same(snapshots[2], expected[1]);
+}
+
+TEST(persistent_map_test, failed_update_leaves_map_as_it_was) {
+  {
+    s21::persistent_map<int, Fragile> map;
+    for (int i = 0; i < 200; i++) map.insert(i, Fragile(i));
+    s21::persistent_map<int, Fragile> snapshot = map.snapshot();
+    int alive = Fragile::alive;
+    // every update copies the shared nodes on its path, make one copy fail
+    for (int copies = 0; copies < 12; copies++) {
+      Fragile::copies_left = copies;
+      try {
+        map.erase(100 + copies);
+      } catch (const std::runtime_error&) {
+      }
+      Fragile::copies_left = copies;
+      try {
+        map.insert_or_assign(300 + copies, Fragile(300 + copies));
+      } catch (const std::runtime_error&) {
+      }
+      Fragile::copies_left = -1;
+    }
+    std::size_t size = map.size();
+    int key = 0;
+    for (const auto& item : map) {
+      EXPECT_EQ(item.first, item.second.value);
+      key++;
+    }
+    EXPECT_EQ(static_cast<std::size_t>(key), size);
+    key = 0;
+    for (const auto& item : snapshot) EXPECT_EQ(item.first, key++);
+    EXPECT_EQ(key, 200);
+    map = snapshot;
+    EXPECT_EQ(Fragile::alive, alive);
+  }
+  EXPECT_EQ(Fragile::alive, 0);
+}
+
+TEST(persistent_map_test, readers_iterate_snapshots_while_writer_updates) {
+  // the writer keeps key -> key * 2 for every key it has and publishes a
+  // snapshot after each update, readers check whole snapshots
+  s21::persistent_map<int, int> published;
+  std::mutex mutex;
+  std::atomic<bool> done(false);
+  std::atomic<int> failures(0);
+  auto read = [&]() {
+    while (!done.load()) {
+      s21::persistent_map<int, int> snapshot;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        snapshot = published;
+      }
+      std::size_t count = 0;
+      int last = -1;
+      for (const auto& item : snapshot) {
+        if (item.second != item.first * 2 || item.first <= last) failures++;
+        last = item.first;
+        count++;
+      }
+      if (count != snapshot.size()) failures++;
+    }
+  };
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 3; i++) readers.emplace_back(read);
+  std::mt19937 gen(31);
+  s21::persistent_map<int, int> map;
+  for (int i = 0; i < 20000; i++) {
+    int key = static_cast<int>(gen() % 1000);
+    if (gen() % 3 == 0)
+      map.erase(key);
+    else
+      map.insert(key, key * 2);
+    std::lock_guard<std::mutex> lock(mutex);
+    published = map;
+  }
+  done = true;
+  for (auto& reader : readers) reader.join();
+  EXPECT_EQ(failures.load(), 0);
+}
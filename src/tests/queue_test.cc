@@ -328,3 +328,13 @@ TEST(queue_test, emplace_back) {
   EXPECT_EQ(a.front(), 1);
   EXPECT_EQ(a.back(), 6);
 }
+
+TEST(queue_test, pmr_queue) {
+  std::pmr::monotonic_buffer_resource resource;
+  s21::pmr::queue<int> a({1, 2, 3}, &resource);
+  a.push(4);
+  EXPECT_EQ(a.front(), 1);
+  EXPECT_EQ(a.back(), 4);
+  a.pop();
+  EXPECT_EQ(a.front(), 2);
+}
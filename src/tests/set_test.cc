@@ -1,5 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <random>
+
 #include "../s21_containers.h"
 
 TEST(set_test, constructor_1) {
@@ -428,11 +435,11 @@ TEST(set_test, size) {
   EXPECT_EQ(s21_set.size(), std_set.size());
 }
 
-TEST(set_test, emplace) {
+TEST(set_test, insert_many) {
   s21::set<int> s21_set = {1, 2, 3};
   s21::set<int> s21_exm = {0, 1, 2, 3, 4};
 
-  s21_set.emplace(4, 0);
+  s21_set.insert_many(4, 0);
 
   EXPECT_EQ(s21_set.size(), s21_exm.size());
   auto exm_it = s21_exm.begin();
@@ -442,11 +449,11 @@ TEST(set_test, emplace) {
   }
 }
 
-TEST(set_test, emplace_2) {
+TEST(set_test, insert_many_2) {
   s21::set<char> s21_set = {'b', 'f', 'e'};
   s21::set<char> s21_exm = {'a', 'b', 'c', 'd', 'e', 'f', 'g'};
 
-  s21_set.emplace('c', 'g', 'd', 'a');
+  s21_set.insert_many('c', 'g', 'd', 'a');
 
   EXPECT_EQ(s21_set.size(), s21_exm.size());
   auto exm_it = s21_exm.begin();
@@ -456,11 +463,11 @@ TEST(set_test, emplace_2) {
   }
 }
 
-TEST(set_test, emplace_3) {
+TEST(set_test, insert_many_3) {
   s21::set<std::string> s21_set = {"Cats", "Are"};
   s21::set<std::string> s21_exm = {"Are", "Best", "Cats", "The", "!"};
 
-  s21_set.emplace("The", "Best", "!");
+  s21_set.insert_many("The", "Best", "!");
 
   EXPECT_EQ(s21_set.size(), s21_exm.size());
   auto exm_it = s21_exm.begin();
@@ -470,11 +477,11 @@ TEST(set_test, emplace_3) {
   }
 }
 
-TEST(set_test, emplace_4) {
+TEST(set_test, insert_many_4) {
   s21::set<double> s21_set = {2.13, 1.23};
   s21::set<double> s21_exm = {1.23, 2.13, 3.12, 4.12, 5.12};
 
-  s21_set.emplace(5.12, 3.12, 4.12);
+  s21_set.insert_many(5.12, 3.12, 4.12);
 
   EXPECT_EQ(s21_set.size(), s21_exm.size());
   auto exm_it = s21_exm.begin();
@@ -483,3 +490,824 @@ TEST(set_test, emplace_4) {
     EXPECT_EQ(*s21_it, *exm_it);
   }
 }
+
+TEST(set_test, pool_reuse_after_erase_and_clear) {
+  s21::set<int> s21_set;
+  std::set<int> std_set;
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 1000; i++) {
+      s21_set.insert((i * 37) % 1009);
+      std_set.insert((i * 37) % 1009);
+    }
+    for (int i = 0; i < 1009; i += 3) {
+      auto it = s21_set.find(i);
+      if (it != s21_set.end()) s21_set.erase(it);
+      std_set.erase(i);
+    }
+    EXPECT_EQ(s21_set.size(), std_set.size());
+    auto std_it = std_set.begin();
+    for (auto it = s21_set.begin(); it != s21_set.end(); ++it, ++std_it)
+      EXPECT_EQ(*it, *std_it);
+    s21_set.clear();
+    std_set.clear();
+    EXPECT_TRUE(s21_set.empty());
+    EXPECT_TRUE(s21_set.begin() == s21_set.end());
+  }
+}
+
+TEST(set_test, pool_strings_copy_move_merge) {
+  s21::set<std::string> s21_set;
+  for (int i = 0; i < 200; i++)
+    s21_set.insert(std::string(40, 'a' + i % 26) + std::to_string(i));
+  s21::set<std::string> copy = s21_set;
+  s21::set<std::string> moved = std::move(copy);
+  EXPECT_EQ(moved.size(), 200U);
+  s21::set<std::string> other = {"zzz", "yyy", *moved.begin()};
+  moved.merge(other);
+  EXPECT_EQ(moved.size(), 202U);
+  EXPECT_EQ(other.size(), 1U);
+  EXPECT_TRUE(moved.contains("zzz"));
+  EXPECT_TRUE(moved.contains("yyy"));
+  other.clear();
+  moved.clear();
+  EXPECT_TRUE(moved.empty());
+  moved.insert("again");
+  EXPECT_EQ(*moved.begin(), "again");
+}
+
+namespace {
+// allocator counting the memory it holds
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+  explicit CountingAllocator(long* bytes) : bytes_(bytes) {}
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>& other) : bytes_(other.bytes_) {}
+  T* allocate(std::size_t n) {
+    *bytes_ += n * sizeof(T);
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) {
+    *bytes_ -= n * sizeof(T);
+    std::allocator<T>().deallocate(p, n);
+  }
+  template <typename U>
+  bool operator==(const CountingAllocator<U>& other) const {
+    return bytes_ == other.bytes_;
+  }
+  template <typename U>
+  bool operator!=(const CountingAllocator<U>& other) const {
+    return bytes_ != other.bytes_;
+  }
+  long* bytes_;
+};
+}  // namespace
+
+TEST(set_test, custom_allocator) {
+  using counted_set = s21::set<int, std::less<int>, CountingAllocator<int>>;
+  long bytes = 0;
+  {
+    CountingAllocator<int> alloc(&bytes);
+    counted_set s21_set(alloc);
+    for (int i = 0; i < 1000; i++) s21_set.insert(i);
+    EXPECT_GT(bytes, 1000L * static_cast<long>(sizeof(int)));
+    counted_set copy = s21_set;
+    EXPECT_EQ(copy.size(), 1000U);
+    EXPECT_TRUE(copy.get_allocator() == alloc);
+    counted_set moved(std::move(copy));
+    EXPECT_EQ(moved.size(), 1000U);
+    EXPECT_EQ(*moved.begin(), 0);
+  }
+  EXPECT_EQ(bytes, 0L);
+}
+
+namespace {
+// returns the memory a copy of a set of 10000 elements takes per element.
+// the copy gets its nodes in one block, so it is the node size plus shares
+// of the block header and of the end node
+template <typename Set, typename Make>
+double bytes_per_element(Make make) {
+  long bytes = 0;
+  typename Set::allocator_type alloc(&bytes);
+  Set source(alloc);
+  for (int i = 0; i < 10000; i++) source.insert(make(i));
+  long before = bytes;
+  Set copy(source);
+  return static_cast<double>(bytes - before) / 10000;
+}
+}  // namespace
+
+TEST(set_test, memory_per_element) {
+  using int_set = s21::set<int, std::less<int>, CountingAllocator<int>>;
+  using long_set =
+      s21::set<long long, std::less<long long>, CountingAllocator<long long>>;
+  using string_set = s21::set<std::string, std::less<std::string>,
+                              CountingAllocator<std::string>>;
+  using threaded_int_set =
+      s21::threaded_set<int, std::less<int>, CountingAllocator<int>>;
+  using int_map = s21::map<int, int, std::less<int>,
+                           CountingAllocator<std::pair<const int, int>>>;
+  auto number = [](int i) { return i; };
+  // three links and a 32-bit weight with the color in the parent link
+  EXPECT_LE(bytes_per_element<int_set>(number), 33.0);
+  EXPECT_LE(bytes_per_element<long_set>(number), 41.0);
+  EXPECT_LE(bytes_per_element<string_set>(
+                [](int i) { return std::to_string(i); }),
+            65.0);
+  EXPECT_LE(bytes_per_element<threaded_int_set>(number), 49.0);
+  EXPECT_LE(bytes_per_element<int_map>([](int i) {
+              return std::pair<const int, int>(i, i);
+            }),
+            41.0);
+}
+
+TEST(set_test, pmr_set_move_between_resources) {
+  std::pmr::monotonic_buffer_resource first;
+  std::pmr::monotonic_buffer_resource second;
+  s21::pmr::set<std::pmr::string> a({"one", "two", "three"}, &first);
+  s21::pmr::set<std::pmr::string> b(&second);
+  b = std::move(a);
+  EXPECT_EQ(b.size(), 3U);
+  EXPECT_TRUE(b.contains("two"));
+  EXPECT_EQ(b.get_allocator().resource(), &second);
+  EXPECT_EQ((*b.begin()).get_allocator().resource(), &second);
+  a.insert("four");
+  EXPECT_EQ(a.size(), 1U);
+}
+
+TEST(set_test, copy_iterates_own_nodes) {
+  s21::set<int> copy;
+  {
+    s21::set<int> s21_set = {5, 1, 9, 3, 7};
+    copy = s21_set;
+    s21_set.clear();
+  }
+  std::set<int> std_set = {1, 3, 5, 7, 9};
+  auto std_it = std_set.begin();
+  for (auto it = copy.begin(); it != copy.end(); ++it, ++std_it)
+    EXPECT_EQ(*it, *std_it);
+  EXPECT_TRUE(std_it == std_set.end());
+  auto last = copy.end();
+  --last;
+  EXPECT_EQ(*last, 9);
+}
+
+namespace {
+// orders strings ignoring the case of letters
+struct CaseInsensitiveLess {
+  bool operator()(const std::string& lhs, const std::string& rhs) const {
+    return std::lexicographical_compare(
+        lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](char a, char b) {
+          return std::tolower(static_cast<unsigned char>(a)) <
+                 std::tolower(static_cast<unsigned char>(b));
+        });
+  }
+};
+
+// comparator with state: orders numbers by remainder of division by mod_
+struct ModuloLess {
+  explicit ModuloLess(int mod = 10) : mod_(mod) {}
+  bool operator()(int lhs, int rhs) const { return lhs % mod_ < rhs % mod_; }
+  int mod_;
+};
+}  // namespace
+
+TEST(set_test, case_insensitive_comparator) {
+  s21::set<std::string, CaseInsensitiveLess> s21_set = {"Banana", "apple",
+                                                        "cherry"};
+  EXPECT_FALSE(s21_set.insert("APPLE").second);
+  EXPECT_EQ(s21_set.size(), 3U);
+  EXPECT_TRUE(s21_set.contains("BANANA"));
+  EXPECT_EQ(*s21_set.find("CHERRY"), "cherry");
+  EXPECT_TRUE(s21_set.find("durian") == s21_set.end());
+  EXPECT_EQ(*s21_set.begin(), "apple");
+}
+
+TEST(set_test, reverse_order) {
+  s21::set<int, std::greater<int>> s21_set = {3, 1, 4, 1, 5, 9, 2, 6};
+  std::set<int, std::greater<int>> std_set = {3, 1, 4, 1, 5, 9, 2, 6};
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  auto std_it = std_set.begin();
+  for (auto it = s21_set.begin(); it != s21_set.end(); ++it, ++std_it)
+    EXPECT_EQ(*it, *std_it);
+  EXPECT_TRUE(s21_set.contains(9));
+  EXPECT_FALSE(s21_set.contains(7));
+}
+
+TEST(set_test, stateful_comparator) {
+  s21::set<int, ModuloLess> s21_set(ModuloLess(3));
+  s21_set.insert(4);
+  s21_set.insert(7);
+  s21_set.insert(5);
+  EXPECT_EQ(s21_set.size(), 2U);
+  EXPECT_EQ(s21_set.key_comp().mod_, 3);
+  s21::set<int, ModuloLess> copy = s21_set;
+  EXPECT_EQ(copy.key_comp().mod_, 3);
+  EXPECT_TRUE(copy.contains(10));
+  s21::set<int, ModuloLess> other;
+  other.swap(copy);
+  EXPECT_EQ(other.key_comp().mod_, 3);
+  EXPECT_EQ(copy.key_comp().mod_, 10);
+}
+
+TEST(set_test, lambda_comparator_copy_and_move) {
+  auto greater = [](int lhs, int rhs) { return lhs > rhs; };
+  s21::set<int, decltype(greater)> s21_set({1, 3, 2}, greater);
+  s21::set<int, decltype(greater)> copy(s21_set);
+  EXPECT_EQ(*copy.begin(), 3);
+  s21::set<int, decltype(greater)> moved(std::move(copy));
+  EXPECT_EQ(*moved.begin(), 3);
+  EXPECT_TRUE(copy.empty());
+  int mod = 3;
+  auto modulo = [mod](int lhs, int rhs) { return lhs % mod < rhs % mod; };
+  s21::set<int, decltype(modulo)> modulo_set({4, 5, 7}, modulo);
+  s21::set<int, decltype(modulo)> modulo_copy(modulo_set);
+  EXPECT_EQ(modulo_copy.size(), 2U);
+  s21::set<int, decltype(modulo)> modulo_moved(std::move(modulo_copy));
+  EXPECT_TRUE(modulo_moved.contains(10));
+  s21::map<int, int, decltype(modulo)> map({{4, 4}, {5, 5}}, modulo);
+  s21::map<int, int, decltype(modulo)> map_moved(std::move(map));
+  EXPECT_EQ(map_moved.at(7), 4);
+}
+
+TEST(set_test, empty_comparator_takes_no_space) {
+  EXPECT_EQ(sizeof(s21::set<int>), sizeof(s21::set<int, std::greater<int>>));
+  EXPECT_LT(sizeof(s21::set<int>), sizeof(s21::set<int, ModuloLess>));
+}
+
+TEST(set_test, transparent_lookup) {
+  s21::set<std::string, std::less<>> s21_set = {"apple", "kiwi", "pear"};
+  std::string_view view = "kiwi";
+  EXPECT_EQ(*s21_set.find(view), "kiwi");
+  EXPECT_TRUE(s21_set.contains("pear"));
+  EXPECT_FALSE(s21_set.contains(std::string_view("plum")));
+  EXPECT_EQ(s21_set.count("apple"), 1U);
+  EXPECT_EQ(s21_set.count("banana"), 0U);
+  EXPECT_EQ(*s21_set.lower_bound("b"), "kiwi");
+  EXPECT_EQ(*s21_set.upper_bound("kiwi"), "pear");
+  auto range = s21_set.equal_range(view);
+  EXPECT_EQ(*range.first, "kiwi");
+  EXPECT_EQ(*range.second, "pear");
+  const auto& const_set = s21_set;
+  EXPECT_TRUE(const_set.find("melon") == const_set.end());
+}
+
+struct Employee {
+  int id;
+  std::string name;
+};
+
+struct ById {
+  using is_transparent = void;
+  bool operator()(const Employee& a, const Employee& b) const {
+    return a.id < b.id;
+  }
+  bool operator()(const Employee& a, int b) const { return a.id < b; }
+  bool operator()(int a, const Employee& b) const { return a < b.id; }
+};
+
+TEST(set_test, transparent_lookup_by_member) {
+  s21::set<Employee, ById> s21_set = {{3, "Ann"}, {1, "Bob"}, {2, "Eve"}};
+  EXPECT_EQ((*s21_set.find(2)).name, "Eve");
+  EXPECT_TRUE(s21_set.find(4) == s21_set.end());
+  EXPECT_EQ((*s21_set.lower_bound(2)).name, "Eve");
+  EXPECT_EQ((*s21_set.upper_bound(2)).name, "Ann");
+  EXPECT_EQ(s21_set.count(1), 1U);
+}
+
+TEST(set_test, order_statistics) {
+  s21::set<int> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 500; i++) {
+    s21_set.insert(i * 37 % 1009);
+    std_set.insert(i * 37 % 1009);
+  }
+  for (int i = 0; i < 200; i++) {
+    s21_set.erase(s21_set.find(i * 37 % 1009));
+    std_set.erase(i * 37 % 1009);
+  }
+  s21::set<int> copy = s21_set;
+  size_t k = 0;
+  for (auto it = std_set.begin(); it != std_set.end(); ++it, ++k) {
+    EXPECT_EQ(*s21_set.nth(k), *it);
+    EXPECT_EQ(*copy.nth(k), *it);
+    EXPECT_EQ(s21_set.rank(*it), k);
+    EXPECT_EQ(s21_set.distance(s21_set.begin(), s21_set.find(*it)),
+              static_cast<std::ptrdiff_t>(k));
+  }
+  EXPECT_TRUE(s21_set.nth(std_set.size()) == s21_set.end());
+  EXPECT_EQ(s21_set.rank(2000), std_set.size());
+  EXPECT_EQ(s21_set.rank(-1), 0U);
+  EXPECT_EQ(s21_set.distance(s21_set.begin(), s21_set.end()),
+            static_cast<std::ptrdiff_t>(s21_set.size()));
+  EXPECT_EQ(s21_set.distance(s21_set.end(), s21_set.begin()),
+            -static_cast<std::ptrdiff_t>(s21_set.size()));
+}
+
+TEST(set_test, bulk_load_sorted) {
+  for (int n = 0; n < 70; n++) {
+    std::vector<int> sorted;
+    for (int i = 0; i < n; i++) sorted.push_back(i * 2);
+    s21::set<int> s21_set(s21::sorted_unique, sorted.begin(), sorted.end());
+    ASSERT_EQ(s21_set.size(), sorted.size());
+    size_t k = 0;
+    for (auto it = s21_set.begin(); it != s21_set.end(); ++it, ++k) {
+      EXPECT_EQ(*it, sorted[k]);
+      EXPECT_EQ(*s21_set.nth(k), sorted[k]);
+    }
+    // the tree has to stay valid for the usual modifications
+    s21_set.insert(-1);
+    s21_set.insert(n);
+    s21_set.erase(s21_set.find(0));
+    std::set<int> std_set(sorted.begin(), sorted.end());
+    std_set.insert(-1);
+    std_set.insert(n);
+    std_set.erase(0);
+    auto std_it = std_set.begin();
+    for (auto it = s21_set.begin(); it != s21_set.end(); ++it, ++std_it)
+      EXPECT_EQ(*it, *std_it);
+    EXPECT_EQ(s21_set.size(), std_set.size());
+  }
+}
+
+TEST(set_test, assign_drops_duplicates) {
+  std::vector<std::string> words = {"pear", "apple", "pear", "kiwi", "apple"};
+  s21::set<std::string> s21_set(words.begin(), words.end());
+  std::set<std::string> std_set(words.begin(), words.end());
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  auto std_it = std_set.begin();
+  for (auto it = s21_set.begin(); it != s21_set.end(); ++it, ++std_it)
+    EXPECT_EQ(*it, *std_it);
+  std::vector<std::string> sorted = {"a", "b", "b", "c"};
+  s21_set.assign_sorted(sorted.begin(), sorted.end());
+  EXPECT_EQ(s21_set.size(), 3U);
+  EXPECT_TRUE(s21_set.contains("b"));
+  EXPECT_FALSE(s21_set.contains("kiwi"));
+  s21_set.assign(words.begin(), words.begin());
+  EXPECT_TRUE(s21_set.empty());
+  EXPECT_TRUE(s21_set.begin() == s21_set.end());
+}
+
+TEST(set_test, insert_with_hint) {
+  s21::set<int> s21_set;
+  std::set<int> std_set;
+  // ascending keys with end() hint, descending keys with begin() hint
+  for (int i = 0; i < 100; i++) {
+    s21_set.insert(s21_set.end(), i);
+    s21_set.insert(s21_set.begin(), -i);
+    std_set.insert(i);
+    std_set.insert(-i);
+  }
+  // hints which are right, wrong and point at an equal key
+  for (int i = -150; i < 150; i += 7) {
+    auto it = s21_set.insert(s21_set.lower_bound(i), i);
+    EXPECT_EQ(*it, i);
+    it = s21_set.insert(s21_set.nth(50), i + 1);
+    EXPECT_EQ(*it, i + 1);
+    std_set.insert(i);
+    std_set.insert(i + 1);
+  }
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  auto std_it = std_set.begin();
+  for (size_t k = 0; k < std_set.size(); k++, ++std_it) {
+    EXPECT_EQ(*s21_set.nth(k), *std_it);
+    EXPECT_EQ(s21_set.rank(*std_it), k);
+  }
+  auto it = s21_set.emplace_hint(s21_set.find(5), 5);
+  EXPECT_TRUE(it == s21_set.find(5));
+  EXPECT_EQ(s21_set.size(), std_set.size());
+}
+
+namespace {
+// throws from the copy constructor once copies run out
+struct LimitedCopies {
+  static int copies_left;
+  int value;
+  LimitedCopies(int v = 0) : value(v){};
+  LimitedCopies(const LimitedCopies& other) : value(other.value) {
+    if (copies_left-- == 0) throw std::runtime_error("no copies left");
+  };
+  bool operator<(const LimitedCopies& other) const {
+    return value < other.value;
+  };
+};
+int LimitedCopies::copies_left = -1;
+
+// throws from the move constructor once moves run out
+struct LimitedMoves {
+  static int moves_left;
+  int value;
+  LimitedMoves(int v = 0) : value(v){};
+  LimitedMoves(const LimitedMoves& other) = default;
+  LimitedMoves(LimitedMoves&& other) : value(other.value) {
+    if (moves_left-- == 0) throw std::runtime_error("no moves left");
+  };
+  bool operator<(const LimitedMoves& other) const {
+    return value < other.value;
+  };
+};
+int LimitedMoves::moves_left = -1;
+}  // namespace
+
+TEST(set_test, copy_and_clear_large) {
+  s21::set<std::string> s21_set;
+  for (int i = 0; i < 20000; i++) s21_set.insert(std::to_string(i));
+  s21::set<std::string> copy(s21_set);
+  EXPECT_EQ(copy.size(), s21_set.size());
+  auto it = s21_set.begin();
+  for (size_t k = 0; k < copy.size(); k++, ++it) {
+    EXPECT_EQ(*copy.nth(k), *it);
+  }
+  copy.clear();
+  EXPECT_TRUE(copy.empty());
+  copy.insert("x");
+  EXPECT_EQ(*copy.begin(), "x");
+}
+
+TEST(set_test, copy_throwing_element) {
+  s21::set<LimitedCopies> s21_set;
+  for (int i = 0; i < 100; i++) s21_set.insert(LimitedCopies(i));
+  LimitedCopies::copies_left = 50;
+  EXPECT_THROW(s21::set<LimitedCopies> copy(s21_set), std::runtime_error);
+  LimitedCopies::copies_left = -1;
+  EXPECT_EQ(s21_set.size(), 100U);
+}
+
+TEST(set_test, merge_throwing_move) {
+  s21::set<LimitedMoves> s21_set, other;
+  for (int i = 0; i < 100; i += 2) s21_set.insert(LimitedMoves(i));
+  for (int i = 0; i < 100; i += 3) other.insert(LimitedMoves(i));
+  // the trees have their own pools, so every merged value is moved
+  LimitedMoves::moves_left = 10;
+  EXPECT_THROW(s21_set.merge(other), std::runtime_error);
+  LimitedMoves::moves_left = -1;
+  EXPECT_EQ(s21_set.size() + other.size(), 50U + 34U);
+  std::set<int> values;
+  for (const auto& item : s21_set) values.insert(item.value);
+  for (const auto& item : other) values.insert(item.value);
+  EXPECT_EQ(values.size(), 67U);
+  s21_set.merge(other);
+  EXPECT_EQ(s21_set.size(), 67U);
+  EXPECT_EQ(other.size(), 17U);
+  EXPECT_TRUE(std::is_sorted(s21_set.begin(), s21_set.end()));
+}
+
+TEST(set_test, node_handles) {
+  s21::set<std::string> first = {"a", "b", "c"};
+  s21::set<std::string> second = {"c", "d"};
+  auto node = first.extract("b");
+  ASSERT_FALSE(node.empty());
+  EXPECT_EQ(node.value(), "b");
+  EXPECT_EQ(first.size(), 2U);
+  EXPECT_FALSE(first.contains("b"));
+  auto res = second.insert(std::move(node));
+  EXPECT_TRUE(res.inserted);
+  EXPECT_TRUE(res.node.empty());
+  EXPECT_EQ(*res.position, "b");
+  EXPECT_EQ(second.size(), 3U);
+  // the key is taken already, the node comes back
+  res = second.insert(first.extract(first.find("c")));
+  EXPECT_FALSE(res.inserted);
+  ASSERT_TRUE(static_cast<bool>(res.node));
+  EXPECT_EQ(res.node.value(), "c");
+  EXPECT_TRUE(res.position == second.find("c"));
+  EXPECT_TRUE(first.extract("zzz").empty());
+  EXPECT_TRUE(first.extract(first.end()).empty());
+  // the handle keeps its node after the set is gone
+  s21::set<std::string>::node_type kept;
+  {
+    s21::set<std::string> temporary = {"x", "y"};
+    kept = temporary.extract(temporary.begin());
+  }
+  kept.value() = "z";
+  first.insert(first.end(), std::move(kept));
+  EXPECT_TRUE(first.contains("z"));
+  EXPECT_EQ(*first.begin(), "a");
+  // the only element goes and comes back
+  s21::set<int> single = {1};
+  auto one = single.extract(1);
+  EXPECT_TRUE(single.empty());
+  EXPECT_TRUE(single.begin() == single.end());
+  single.insert(std::move(one));
+  EXPECT_EQ(*single.begin(), 1);
+}
+
+TEST(set_test, node_handles_shared_pool) {
+  using counted_set = s21::set<int, std::less<int>, CountingAllocator<int>>;
+  long bytes = 0;
+  {
+    CountingAllocator<int> alloc(&bytes);
+    counted_set older(alloc), newer(alloc);
+    EXPECT_TRUE(newer.share_pool(older));
+    for (int i = 0; i < 1000; i++) older.insert(i);
+    long filled = bytes;
+    // moving nodes between the sets allocates nothing
+    for (int i = 0; i < 1000; i += 2) newer.insert(older.extract(i));
+    EXPECT_EQ(bytes, filled);
+    EXPECT_EQ(older.size(), 500U);
+    EXPECT_EQ(newer.size(), 500U);
+    EXPECT_EQ(*newer.nth(10), 20);
+    older.clear();
+    EXPECT_EQ(newer.rank(100), 50U);
+    EXPECT_FALSE(newer.share_pool(older));
+  }
+  EXPECT_EQ(bytes, 0L);
+}
+
+TEST(set_test, extract_every_minimum) {
+  s21::set<int> from = {5, 3, 8, 1, 4, 7, 9, 2, 6};
+  s21::set<int> to;
+  int expected = 1;
+  while (!from.empty()) {
+    EXPECT_EQ(*from.begin(), expected++);
+    to.insert(from.extract(from.begin()));
+    if (!from.empty()) {
+      auto last = from.end();
+      EXPECT_EQ(*--last, 9);
+    }
+  }
+  EXPECT_EQ(to.size(), 9U);
+  EXPECT_EQ(*to.nth(8), 9);
+}
+
+TEST(set_test, set_algebra) {
+  std::mt19937 gen(12);
+  for (int round = 0; round < 200; round++) {
+    std::set<int> a, b;
+    int size_a = gen() % 300, size_b = gen() % (round % 4 == 0 ? 5 : 300);
+    for (int i = 0; i < size_a; i++) a.insert(gen() % 500);
+    for (int i = 0; i < size_b; i++) b.insert(gen() % 500);
+    std::vector<std::vector<int>> expected(4);
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                   std::back_inserter(expected[0]));
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                          std::back_inserter(expected[1]));
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                        std::back_inserter(expected[2]));
+    std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(),
+                                  std::back_inserter(expected[3]));
+    // every operation with other kept and with other given away
+    for (int run = 0; run < 8; run++) {
+      int op = run % 4;
+      s21::set<int> first(a.begin(), a.end()), second(b.begin(), b.end());
+      if (run < 4) {
+        if (op == 0) first.set_union(second);
+        if (op == 1) first.set_intersection(second);
+        if (op == 2) first.set_difference(second);
+        if (op == 3) first.symmetric_difference(second);
+      } else {
+        if (op == 0) first.set_union(std::move(second));
+        if (op == 1) first.set_intersection(std::move(second));
+        if (op == 2) first.set_difference(std::move(second));
+        if (op == 3) first.symmetric_difference(std::move(second));
+      }
+      EXPECT_EQ(first.size(), expected[op].size());
+      EXPECT_TRUE(std::equal(first.begin(), first.end(),
+                             expected[op].begin(), expected[op].end()));
+      for (size_t i = 0; i < first.size(); i += 7)
+        EXPECT_EQ(first.rank(*first.nth(i)), i);
+      if (run < 4) {
+        EXPECT_TRUE(std::equal(second.begin(), second.end(), b.begin(),
+                               b.end()));
+      } else {
+        EXPECT_TRUE(second.empty());
+      }
+    }
+  }
+}
+
+TEST(set_test, set_algebra_edge_cases) {
+  s21::set<int> first = {1, 2, 3};
+  s21::set<int> empty;
+  first.set_union(empty);
+  EXPECT_EQ(first.size(), 3U);
+  first.set_intersection(first);
+  EXPECT_EQ(first.size(), 3U);
+  empty.set_union(std::move(first));
+  EXPECT_TRUE(first.empty());
+  EXPECT_EQ(*empty.begin(), 1);
+  auto last = empty.end();
+  EXPECT_EQ(*--last, 3);
+  empty.symmetric_difference(empty);
+  EXPECT_TRUE(empty.empty());
+  EXPECT_TRUE(empty.begin() == empty.end());
+  // sets sharing a pool give their nodes to each other
+  s21::set<std::string> words = {"a", "c"}, more;
+  more.share_pool(words);
+  more.insert("b");
+  more.insert("c");
+  words.set_union(std::move(more));
+  EXPECT_EQ(words.size(), 3U);
+  EXPECT_EQ(*words.nth(1), "b");
+}
+
+TEST(set_test, set_union_throwing_copy) {
+  s21::set<LimitedCopies> first, second;
+  for (int i = 0; i < 200; i += 2) first.insert(LimitedCopies(i));
+  for (int i = 0; i < 200; i += 3) second.insert(LimitedCopies(i));
+  // only the 33 elements of second missing in first are copied
+  LimitedCopies::copies_left = 33;
+  first.set_union(second);
+  EXPECT_EQ(first.size(), 133U);
+  EXPECT_EQ(LimitedCopies::copies_left, 0);
+  LimitedCopies::copies_left = -1;
+  s21::set<LimitedCopies> third;
+  for (int i = 1; i < 200; i += 2) third.insert(LimitedCopies(i));
+  LimitedCopies::copies_left = 10;
+  EXPECT_THROW(first.set_union(third), std::runtime_error);
+  LimitedCopies::copies_left = -1;
+  // the set keeps its elements and the ones copied before the throw
+  EXPECT_EQ(first.size(), 143U);
+  EXPECT_TRUE(std::is_sorted(first.begin(), first.end()));
+  for (size_t i = 0; i < first.size(); i += 5)
+    EXPECT_EQ(first.rank(*first.nth(i)), i);
+  first.set_union(third);
+  EXPECT_EQ(first.size(), 200U);
+}
+
+TEST(set_test, parallel_operations) {
+  std::mt19937 gen(13);
+  std::vector<int> first_keys(50000), second_keys(30000);
+  for (int& key : first_keys) key = gen() % 100000;
+  for (int& key : second_keys) key = gen() % 100000;
+  std::set<int> std_first(first_keys.begin(), first_keys.end());
+  std::set<int> std_second(second_keys.begin(), second_keys.end());
+  s21::set<int> first(s21::parallel(4), first_keys.begin(), first_keys.end());
+  s21::set<int> second;
+  second.assign(s21::parallel(3), second_keys.begin(), second_keys.end());
+  EXPECT_TRUE(std::equal(first.begin(), first.end(), std_first.begin(),
+                         std_first.end()));
+  EXPECT_EQ(second.size(), std_second.size());
+  std::vector<int> expected;
+  std::set_symmetric_difference(std_first.begin(), std_first.end(),
+                                std_second.begin(), std_second.end(),
+                                std::back_inserter(expected));
+  first.symmetric_difference(s21::parallel(4), std::move(second));
+  EXPECT_TRUE(second.empty());
+  EXPECT_TRUE(std::equal(first.begin(), first.end(), expected.begin(),
+                         expected.end()));
+  EXPECT_EQ(*first.nth(expected.size() / 2), expected[expected.size() / 2]);
+  std::atomic<long long> sum(0);
+  first.for_each(s21::parallel(4), [&sum](int key) { sum += key; });
+  long long expected_sum = 0;
+  first.for_each([&expected_sum](int key) { expected_sum += key; });
+  EXPECT_EQ(sum, std::accumulate(expected.begin(), expected.end(), 0LL));
+  EXPECT_EQ(sum, expected_sum);
+}
+
+TEST(set_test, threaded_iteration) {
+  std::mt19937 gen(17);
+  s21::threaded_set<int> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 20000; i++) {
+    int key = static_cast<int>(gen() % 5000);
+    if (gen() % 3 != 0) {
+      s21_set.insert(key);
+      std_set.insert(key);
+    } else if (s21_set.contains(key)) {
+      s21_set.erase(s21_set.find(key));
+      std_set.erase(key);
+    }
+  }
+  EXPECT_TRUE(std::equal(s21_set.begin(), s21_set.end(), std_set.begin(),
+                         std_set.end()));
+  auto it = s21_set.end();
+  for (auto std_it = std_set.rbegin(); std_it != std_set.rend(); ++std_it)
+    EXPECT_EQ(*--it, *std_it);
+  EXPECT_TRUE(it == s21_set.begin());
+  // copies, bulk loads and set algebra link their nodes too
+  s21::threaded_set<int> copy = s21_set;
+  s21::threaded_set<int> evens;
+  std::vector<int> items;
+  for (int i = 0; i < 6000; i += 2) items.push_back(i);
+  evens.assign_sorted(items.begin(), items.end());
+  copy.set_union(std::move(evens));
+  for (int i = 0; i < 6000; i += 2) std_set.insert(i);
+  EXPECT_TRUE(
+      std::equal(copy.begin(), copy.end(), std_set.begin(), std_set.end()));
+  EXPECT_EQ(*std::prev(copy.end()), *std_set.rbegin());
+}
+
+TEST(set_test, emplace_constructs_in_place) {
+  s21::set<std::string> s21_set;
+  auto res = s21_set.emplace(3, 'a');
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(*res.first, "aaa");
+  res = s21_set.emplace("aaa");
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(s21_set.size(), 1U);
+  s21::set<std::unique_ptr<int>> pointers;
+  auto ptr = pointers.emplace(new int(5));
+  EXPECT_TRUE(ptr.second);
+  EXPECT_EQ(**ptr.first, 5);
+}
+
+// checks s21_set against std_set in both directions and by rank
+template <typename Set>
+void expect_same(Set& s21_set, const std::set<int>& std_set) {
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  EXPECT_TRUE(std::equal(s21_set.begin(), s21_set.end(), std_set.begin(),
+                         std_set.end()));
+  auto it = s21_set.end();
+  for (auto std_it = std_set.rbegin(); std_it != std_set.rend(); ++std_it)
+    ASSERT_EQ(*--it, *std_it);
+  int rank = 0;
+  for (int key : std_set) ASSERT_EQ(*s21_set.nth(rank++), key);
+}
+
+template <typename Set>
+void erase_ranges_like_std() {
+  std::mt19937 gen(23);
+  std::vector<int> items(20000);
+  std::iota(items.begin(), items.end(), 0);
+  Set s21_set(items.begin(), items.end());
+  std::set<int> std_set(items.begin(), items.end());
+  // short ranges go node by node, long ones are split out
+  for (int length : {0, 1, 5, 15, 16, 100, 1000, 5000}) {
+    int from = static_cast<int>(gen() % (std_set.size() - length));
+    auto first = s21_set.nth(from), last = s21_set.nth(from + length);
+    int after = last == s21_set.end() ? -1 : *last;
+    auto res = s21_set.erase(first, last);
+    EXPECT_TRUE(res == last);
+    if (after != -1) {
+      EXPECT_EQ(*res, after);
+    }
+    std_set.erase(std::next(std_set.begin(), from),
+                  std::next(std_set.begin(), from + length));
+    expect_same(s21_set, std_set);
+  }
+  // the tree keeps working after the splits
+  for (int i = 0; i < 3000; i++) {
+    int key = static_cast<int>(gen() % 20000);
+    EXPECT_EQ(s21_set.insert(key).second, std_set.insert(key).second);
+  }
+  expect_same(s21_set, std_set);
+  // prefix and suffix
+  s21_set.erase(s21_set.begin(), s21_set.nth(200));
+  std_set.erase(std_set.begin(), std::next(std_set.begin(), 200));
+  s21_set.erase(s21_set.nth(s21_set.size() - 300), s21_set.end());
+  std_set.erase(std::prev(std_set.end(), 300), std_set.end());
+  expect_same(s21_set, std_set);
+  EXPECT_TRUE(s21_set.erase(s21_set.begin(), s21_set.end()) ==
+              s21_set.end());
+  EXPECT_TRUE(s21_set.empty());
+  EXPECT_TRUE(s21_set.begin() == s21_set.end());
+}
+
+TEST(set_test, erase_range) {
+  erase_ranges_like_std<s21::set<int>>();
+  erase_ranges_like_std<s21::threaded_set<int>>();
+}
+
+TEST(set_test, erase_key_and_erase_if) {
+  std::vector<int> items(10000);
+  std::iota(items.begin(), items.end(), 0);
+  s21::threaded_set<int> s21_set(items.begin(), items.end());
+  std::set<int> std_set(items.begin(), items.end());
+  EXPECT_EQ(s21_set.erase(77), 1U);
+  EXPECT_EQ(s21_set.erase(77), 0U);
+  std_set.erase(77);
+  // a few go one by one, many make the tree relinked
+  auto few = [](int key) { return key % 100 == 0; };
+  auto many = [](int key) { return key % 3 != 0; };
+  auto std_erase_if = [&std_set](auto pred) {
+    std::size_t before = std_set.size();
+    for (auto it = std_set.begin(); it != std_set.end();)
+      it = pred(*it) ? std_set.erase(it) : std::next(it);
+    return before - std_set.size();
+  };
+  EXPECT_EQ(s21::erase_if(s21_set, few), std_erase_if(few));
+  expect_same(s21_set, std_set);
+  EXPECT_EQ(s21_set.erase_if(many), std_erase_if(many));
+  expect_same(s21_set, std_set);
+  EXPECT_EQ(s21_set.erase_if([](int) { return false; }), 0U);
+  EXPECT_EQ(s21_set.erase_if([](int) { return true; }), std_set.size());
+  EXPECT_TRUE(s21_set.empty());
+  s21_set.insert(1);
+  EXPECT_EQ(*s21_set.begin(), 1);
+}
+
+TEST(set_test, find_batch) {
+  std::mt19937 gen(31);
+  s21::set<int> s21_set;
+  for (int i = 0; i < 50000; i++)
+    s21_set.insert(static_cast<int>(gen() % 100000));
+  // more keys than one chunk, with hits, misses and repeats
+  std::vector<int> keys(1000);
+  for (auto& key : keys) key = static_cast<int>(gen() % 100010) - 5;
+  keys[10] = keys[11];
+  std::vector<s21::set<int>::iterator> found;
+  s21_set.find_batch(keys.begin(), keys.end(), std::back_inserter(found));
+  ASSERT_EQ(found.size(), keys.size());
+  std::vector<bool> contained(keys.size());
+  const auto& const_set = s21_set;
+  EXPECT_TRUE(const_set.contains_batch(keys.begin(), keys.end(),
+                                       contained.begin()) == contained.end());
+  for (std::size_t i = 0; i < keys.size(); i++) {
+    EXPECT_TRUE(found[i] == s21_set.find(keys[i]));
+    EXPECT_EQ(contained[i], s21_set.contains(keys[i]));
+  }
+  s21::set<int> empty;
+  empty.find_batch(keys.begin(), keys.end(), found.begin());
+  EXPECT_TRUE(found.front() == empty.end());
+}
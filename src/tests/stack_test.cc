@@ -393,3 +393,13 @@ TEST(stack_test, swap) {
   }
   EXPECT_EQ(b.empty(), true);
 }
+
+TEST(stack_test, pmr_stack) {
+  std::pmr::monotonic_buffer_resource resource;
+  s21::pmr::stack<int> a(&resource);
+  for (int i = 0; i < 10; i++) a.push(i);
+  EXPECT_EQ(a.top(), 9);
+  a.pop();
+  EXPECT_EQ(a.top(), 8);
+  EXPECT_EQ(a.size(), 9U);
+}
@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+namespace {
+// hashes strings and string views alike
+struct StringHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view key) const {
+    return std::hash<std::string_view>()(key);
+  }
+};
+
+// puts every key on the same probe sequence
+struct ConstantHash {
+  std::size_t operator()(int) const { return 42; }
+};
+
+// throws from the copy constructor once copies_left reaches zero
+struct Fragile {
+  static int copies_left;
+  static int alive;
+
+  explicit Fragile(int v) : value(v) { alive++; }
+  Fragile(const Fragile& other) : value(other.value) {
+    if (copies_left == 0) throw std::runtime_error("copy");
+    if (copies_left > 0) copies_left--;
+    alive++;
+  }
+  ~Fragile() { alive--; }
+
+  int value;
+};
+
+int Fragile::copies_left = -1;
+int Fragile::alive = 0;
+
+// counts the bytes it has handed out and not got back
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  std::size_t in_use = 0;
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    in_use += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+    // a free through the wrong resource would wrap the count around
+    EXPECT_GE(in_use, bytes);
+    in_use -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+// move-only mapped type
+struct MoveOnly {
+  explicit MoveOnly(int v) : value(v) {}
+  MoveOnly(MoveOnly&&) = default;
+  MoveOnly& operator=(MoveOnly&&) = default;
+  int value;
+};
+
+template <typename Map, typename StdMap>
+void expect_same(const Map& map, const StdMap& std_map) {
+  ASSERT_EQ(map.size(), std_map.size());
+  std::size_t count = 0;
+  for (const auto& item : map) {
+    auto it = std_map.find(item.first);
+    ASSERT_TRUE(it != std_map.end());
+    EXPECT_EQ(it->second, item.second);
+    count++;
+  }
+  EXPECT_EQ(count, std_map.size());
+}
+}  // namespace
+
+TEST(unordered_map_test, element_access) {
+  s21::unordered_map<int, std::string> map = {{1, "one"}, {2, "two"}};
+  EXPECT_FALSE(map.insert({1, "x"}).second);
+  EXPECT_TRUE(map.insert(3, "three").second);
+  EXPECT_FALSE(map.try_emplace(3, "x").second);
+  EXPECT_TRUE(map.emplace(4, "four").second);
+  EXPECT_FALSE(map.insert_or_assign(2, "second").second);
+  EXPECT_EQ(map.at(2), "second");
+  EXPECT_THROW(map.at(5), std::out_of_range);
+  EXPECT_EQ(map[5], "");
+  map[5] = "five";
+  EXPECT_EQ(map.find(5)->second, "five");
+  EXPECT_EQ(map.size(), 5U);
+  EXPECT_EQ(map.count(6), 0U);
+  EXPECT_TRUE(map.find(6) == map.end());
+  auto results = map.insert_many(std::pair<const int, std::string>{6, "6"},
+                                 std::pair<const int, std::string>{1, "1"});
+  ASSERT_EQ(results.size(), 2U);
+  EXPECT_TRUE(results[0].second);
+  EXPECT_EQ(results[0].first->second, "6");
+  EXPECT_FALSE(results[1].second);
+  EXPECT_EQ(results[1].first->second, "one");
+  EXPECT_EQ(map.erase(1), 1U);
+  EXPECT_EQ(map.erase(1), 0U);
+  map.erase(map.find(2));
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_EQ(map.size(), 4U);
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.begin() == map.end());
+}
+
+TEST(unordered_map_test, random_against_std) {
+  std::mt19937 gen(43);
+  s21::unordered_map<int, int> map;
+  std::unordered_map<int, int> std_map;
+  for (int round = 0; round < 4; round++) {
+    // the key range shrinks and grows, so the table fills with deleted
+    // slots and is rebuilt in place as well as grown
+    int range = round % 2 ? 500 : 20000;
+    for (int i = 0; i < 40000; i++) {
+      int key = static_cast<int>(gen() % range);
+      switch (gen() % 4) {
+        case 0:
+          EXPECT_EQ(map.insert(key, i).second,
+                    std_map.insert({key, i}).second);
+          break;
+        case 1:
+          map[key] = i;
+          std_map[key] = i;
+          break;
+        case 2:
+          EXPECT_EQ(map.erase(key), std_map.erase(key));
+          break;
+        default:
+          EXPECT_EQ(map.contains(key), std_map.count(key) == 1);
+      }
+    }
+    expect_same(map, std_map);
+    EXPECT_LE(map.load_factor(), map.max_load_factor());
+  }
+  s21::unordered_map<int, int> copy(map);
+  expect_same(copy, std_map);
+  s21::unordered_map<int, int> moved(std::move(copy));
+  expect_same(moved, std_map);
+  EXPECT_TRUE(copy.empty());
+  copy = moved;
+  expect_same(copy, std_map);
+}
+
+TEST(unordered_map_test, hash_policy) {
+  s21::unordered_map<int, int> map;
+  EXPECT_EQ(map.bucket_count(), 0U);
+  map.reserve(1000);
+  std::size_t buckets = map.bucket_count();
+  EXPECT_GE(buckets * map.max_load_factor(), 1000.0f);
+  map[0] = 0;
+  auto first = map.find(0);
+  for (int key = 1; key < 1000; key++) map[key] = key;
+  // no rehash, so the iterator is still valid
+  EXPECT_EQ(map.bucket_count(), buckets);
+  EXPECT_EQ(first->first, 0);
+  map.max_load_factor(2.0f);
+  EXPECT_FLOAT_EQ(map.max_load_factor(), 0.875f);
+  map.max_load_factor(0.25f);
+  EXPECT_LE(map.load_factor(), 0.25f);
+  EXPECT_GT(map.bucket_count(), buckets);
+  map.rehash(1 << 14);
+  EXPECT_GE(map.bucket_count(), 1U << 14);
+  map.clear();
+  EXPECT_GE(map.bucket_count(), 1U << 14);
+  map.rehash(0);
+  EXPECT_EQ(map.bucket_count(), 0U);
+}
+
+TEST(unordered_map_test, colliding_hashes) {
+  s21::unordered_map<int, int, ConstantHash> map;
+  for (int key = 0; key < 300; key++) map[key] = key * 2;
+  for (int key = 0; key < 300; key += 2) map.erase(key);
+  EXPECT_EQ(map.size(), 150U);
+  for (int key = 0; key < 300; key++) {
+    EXPECT_EQ(map.contains(key), key % 2 == 1);
+  }
+  EXPECT_EQ(map.at(299), 598);
+}
+
+TEST(unordered_map_test, heterogeneous_lookup) {
+  s21::unordered_map<std::string, int, StringHash, std::equal_to<>> map;
+  map["apple"] = 1;
+  map["pear"] = 2;
+  std::string_view key = "pear";
+  EXPECT_EQ(map.find(key)->second, 2);
+  EXPECT_TRUE(map.contains("apple"));
+  EXPECT_EQ(map.count(std::string_view("plum")), 0U);
+}
+
+TEST(unordered_map_test, erase_if_merge_and_swap) {
+  s21::unordered_map<int, int> map, other;
+  for (int key = 0; key < 100; key++) map[key] = key;
+  for (int key = 50; key < 150; key++) other[key] = -key;
+  auto not_third = [](const auto& item) { return item.first % 3 != 0; };
+  EXPECT_EQ(s21::erase_if(map, not_third), 66U);
+  map.merge(other);
+  // the multiples of 3 from 51 to 99 were here already and stay in other
+  EXPECT_EQ(map.size(), 34U + 83U);
+  EXPECT_EQ(other.size(), 17U);
+  EXPECT_EQ(map.at(53), -53);
+  EXPECT_EQ(map.at(54), 54);
+  EXPECT_EQ(other.at(54), -54);
+  map.swap(other);
+  EXPECT_EQ(map.size(), 17U);
+}
+
+TEST(unordered_map_test, failed_copy_leaves_map_as_it_was) {
+  {
+    // 112 elements fill 7/8 of 128 slots, the next insert grows the table
+    s21::unordered_map<int, Fragile> map;
+    for (int key = 0; key < 112; key++) map.try_emplace(key, key);
+    std::size_t buckets = map.bucket_count();
+    auto copy_map = [&map]() { s21::unordered_map<int, Fragile> copy(map); };
+    Fragile::copies_left = 50;
+    EXPECT_THROW(copy_map(), std::runtime_error);
+    Fragile::copies_left = 50;
+    EXPECT_THROW(map.try_emplace(1000, 1000), std::runtime_error);
+    Fragile::copies_left = -1;
+    EXPECT_EQ(map.bucket_count(), buckets);
+    EXPECT_EQ(map.size(), 112U);
+    for (const auto& item : map) EXPECT_EQ(item.first, item.second.value);
+    EXPECT_EQ(Fragile::alive, 112);
+    EXPECT_TRUE(map.try_emplace(1000, 1000).second);
+    EXPECT_GT(map.bucket_count(), buckets);
+  }
+  EXPECT_EQ(Fragile::alive, 0);
+}
+
+TEST(unordered_map_test, pmr_map_uses_resource) {
+  std::pmr::monotonic_buffer_resource resource;
+  s21::pmr::unordered_map<int, int> map(0, std::hash<int>(),
+                                        std::equal_to<int>(), &resource);
+  for (int key = 0; key < 100; key++) map[key] = key;
+  EXPECT_EQ(map.get_allocator().resource(), &resource);
+  EXPECT_EQ(map.at(42), 42);
+}
+
+TEST(unordered_map_test, pmr_assignment_across_resources) {
+  CountingResource first, second;
+  {
+    using Map = s21::pmr::unordered_map<int, std::string>;
+    Map map(0, std::hash<int>(), std::equal_to<int>(), &first);
+    Map other(0, std::hash<int>(), std::equal_to<int>(), &second);
+    for (int key = 0; key < 100; key++) map[key] = std::to_string(key);
+    for (int key = 0; key < 10; key++) other[key] = "other";
+    std::size_t first_in_use = first.in_use;
+    // the copy is made in the memory of other, which keeps its resource
+    other = map;
+    EXPECT_EQ(other.get_allocator().resource(), &second);
+    EXPECT_EQ(first.in_use, first_in_use);
+    EXPECT_EQ(other.size(), 100U);
+    EXPECT_EQ(other.at(42), "42");
+    // the elements are moved into the memory of map, other gets empty
+    other[100] = "100";
+    map = std::move(other);
+    EXPECT_EQ(map.get_allocator().resource(), &first);
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(map.size(), 101U);
+    EXPECT_EQ(map.at(100), "100");
+    map = std::move(other);
+    EXPECT_TRUE(map.empty());
+  }
+  EXPECT_EQ(first.in_use, 0U);
+  EXPECT_EQ(second.in_use, 0U);
+}
+
+TEST(unordered_map_test, pmr_move_assignment_of_move_only_values) {
+  std::pmr::unsynchronized_pool_resource first, second;
+  using Map = s21::pmr::unordered_map<int, MoveOnly>;
+  Map map(0, std::hash<int>(), std::equal_to<int>(), &first);
+  Map other(0, std::hash<int>(), std::equal_to<int>(), &second);
+  for (int key = 0; key < 50; key++) map.try_emplace(key, key);
+  other.try_emplace(1000, 1000);
+  other = std::move(map);
+  EXPECT_EQ(other.get_allocator().resource(), &second);
+  EXPECT_EQ(other.size(), 50U);
+  EXPECT_EQ(other.at(7).value, 7);
+  EXPECT_FALSE(other.contains(1000));
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include "../s21_containersplus.h"
+
+namespace {
+// hashes strings and string views alike
+struct StringHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view key) const {
+    return std::hash<std::string_view>()(key);
+  }
+};
+}  // namespace
+
+TEST(unordered_set_test, modifiers) {
+  s21::unordered_set<std::string> set = {"a", "b", "a"};
+  EXPECT_EQ(set.size(), 2U);
+  EXPECT_FALSE(set.insert("b").second);
+  std::string c = "c";
+  EXPECT_TRUE(set.insert(std::move(c)).second);
+  EXPECT_EQ(*set.emplace(3, 'd').first, "ddd");
+  auto results = set.insert_many("e", "a");
+  EXPECT_TRUE(results[0].second);
+  EXPECT_EQ(*results[0].first, "e");
+  EXPECT_FALSE(results[1].second);
+  EXPECT_EQ(set.size(), 5U);
+  EXPECT_EQ(set.erase("a"), 1U);
+  set.erase(set.find("b"));
+  EXPECT_EQ(set.count("b"), 0U);
+  EXPECT_EQ(set.size(), 3U);
+  set.clear();
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(unordered_set_test, random_against_std) {
+  std::mt19937 gen(47);
+  s21::unordered_set<long long> set;
+  std::unordered_set<long long> std_set;
+  for (int i = 0; i < 100000; i++) {
+    long long key = static_cast<long long>(gen() % 5000) << 20;
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(set.erase(key), std_set.erase(key));
+    } else {
+      EXPECT_EQ(set.insert(key).second, std_set.insert(key).second);
+    }
+  }
+  ASSERT_EQ(set.size(), std_set.size());
+  std::size_t count = 0;
+  for (long long key : set) {
+    EXPECT_EQ(std_set.count(key), 1U);
+    count++;
+  }
+  EXPECT_EQ(count, std_set.size());
+}
+
+TEST(unordered_set_test, heterogeneous_lookup_and_merge) {
+  s21::unordered_set<std::string, StringHash, std::equal_to<>> set = {"x",
+                                                                      "y"};
+  EXPECT_TRUE(set.contains(std::string_view("x")));
+  EXPECT_TRUE(set.find("z") == set.end());
+  s21::unordered_set<std::string, StringHash, std::equal_to<>> other = {"y",
+                                                                        "z"};
+  set.merge(other);
+  EXPECT_EQ(set.size(), 3U);
+  EXPECT_EQ(other.size(), 1U);
+  EXPECT_TRUE(other.contains("y"));
+  EXPECT_EQ(s21::erase_if(set, [](const std::string& s) { return s < "y"; }),
+            1U);
+  EXPECT_FALSE(set.contains("x"));
+}
+
+TEST(unordered_set_test, pmr_copy_assignment_across_resources) {
+  std::pmr::monotonic_buffer_resource first;
+  std::pmr::unsynchronized_pool_resource second;
+  s21::pmr::unordered_set<int> set(0, std::hash<int>(), std::equal_to<int>(),
+                                   &first);
+  s21::pmr::unordered_set<int> other(0, std::hash<int>(),
+                                     std::equal_to<int>(), &second);
+  for (int key = 0; key < 200; key++) set.insert(key);
+  other.insert(-1);
+  other = set;
+  EXPECT_EQ(other.get_allocator().resource(), &second);
+  EXPECT_EQ(other.size(), 200U);
+  EXPECT_FALSE(other.contains(-1));
+  set = other;
+  EXPECT_EQ(set.get_allocator().resource(), &first);
+  EXPECT_EQ(set.size(), 200U);
+}
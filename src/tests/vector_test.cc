@@ -657,3 +657,34 @@ TEST(vector_test, emplace_back_1) {
     i++;
   }
 }
+
+TEST(vector_test, pmr_vector_uses_resource) {
+  std::pmr::monotonic_buffer_resource resource;
+  s21::pmr::vector<std::pmr::string> s21_vector(&resource);
+  for (int i = 0; i < 100; i++)
+    s21_vector.push_back(std::pmr::string(30, 'a' + i % 26));
+  EXPECT_EQ(s21_vector.size(), 100U);
+  EXPECT_EQ(s21_vector.get_allocator().resource(), &resource);
+  EXPECT_EQ(s21_vector[50].get_allocator().resource(), &resource);
+  s21_vector.erase(s21_vector.begin());
+  s21_vector.insert(s21_vector.begin() + 3, s21_vector[10]);
+  EXPECT_EQ(s21_vector[3], s21_vector[11]);
+  s21::pmr::vector<std::pmr::string> copy = s21_vector;
+  EXPECT_EQ(copy.size(), s21_vector.size());
+  s21::pmr::vector<std::pmr::string> moved(&resource);
+  moved = std::move(copy);
+  EXPECT_EQ(moved.size(), s21_vector.size());
+  EXPECT_EQ(moved.back(), s21_vector.back());
+}
+
+TEST(vector_test, copy_assignment) {
+  s21::vector<std::string> s21_vector = {"a", "b", "c"};
+  s21::vector<std::string> other = {"d"};
+  other = s21_vector;
+  EXPECT_EQ(other.size(), 3U);
+  EXPECT_EQ(other.at(2), "c");
+  s21_vector.pop_back();
+  s21_vector.push_back("e");
+  EXPECT_EQ(other.back(), "c");
+  EXPECT_EQ(s21_vector.back(), "e");
+}